@@ -0,0 +1,87 @@
+#include "benchmark.h"
+#include "../src/vector.h"
+
+/**
+ * @brief 流式求和，整数加法可以重排，编译器会向量化
+ */
+template <std::size_t Alignment>
+std::int64_t stream_sum(const std::int32_t * data, std::size_t n)
+{
+    const std::int32_t * ptr = stl::assume_aligned<Alignment>(data);
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += ptr[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief y = a * x + y，读两个流写一个流
+ */
+template <std::size_t Alignment>
+void stream_axpy(float a, const float * x, float * y, std::size_t n)
+{
+    const float * px = stl::assume_aligned<Alignment>(x);
+    float * py = stl::assume_aligned<Alignment>(y);
+    for (std::size_t i = 0; i < n; ++i) {
+        py[i] = a * px[i] + py[i];
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    // 默认数据量放得进L2，差别主要来自对齐而不是内存带宽
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 65536;
+    std::size_t rounds = argc > 2 ? std::stoull(argv[2]) : 2000;
+
+    stl::vector<std::int32_t, stl::aligned_allocator<std::int32_t, 64>> aligned_ints;
+    stl::vector<std::int32_t> plain_ints;
+    stl::vector<float, stl::aligned_allocator<float, 64>> aligned_x, aligned_y;
+    stl::vector<float> plain_x, plain_y;
+    // 多分配一个元素，从第二个元素开始就是故意错开的地址
+    for (std::size_t i = 0; i < n + 1; ++i) {
+        aligned_ints.push_back(static_cast<std::int32_t>(i));
+        plain_ints.push_back(static_cast<std::int32_t>(i));
+        aligned_x.push_back(static_cast<float>(i % 100));
+        aligned_y.push_back(1.0f);
+        plain_x.push_back(static_cast<float>(i % 100));
+        plain_y.push_back(1.0f);
+    }
+    std::cout << "default allocator data % 64: " << reinterpret_cast<std::uintptr_t>(plain_ints.data()) % 64 << std::endl;
+
+    measure("sum aligned_allocator + aligned_data", n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            do_not_optimize(stream_sum<64>(aligned_ints.aligned_data(), n));
+        }
+    });
+    measure("sum stl::allocator", n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            do_not_optimize(stream_sum<alignof(std::int32_t)>(plain_ints.data(), n));
+        }
+    });
+    measure("sum misaligned by 4 bytes", n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            do_not_optimize(stream_sum<alignof(std::int32_t)>(aligned_ints.data() + 1, n));
+        }
+    });
+
+    measure("axpy aligned_allocator + aligned_data", n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            stream_axpy<64>(0.5f, aligned_x.aligned_data(), aligned_y.aligned_data(), n);
+        }
+        do_not_optimize(aligned_y[n / 2]);
+    });
+    measure("axpy stl::allocator", n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            stream_axpy<alignof(float)>(0.5f, plain_x.data(), plain_y.data(), n);
+        }
+        do_not_optimize(plain_y[n / 2]);
+    });
+    measure("axpy misaligned by 4 bytes", n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            stream_axpy<alignof(float)>(0.5f, aligned_x.data() + 1, aligned_y.data() + 1, n);
+        }
+        do_not_optimize(aligned_y[n / 2]);
+    });
+    return 0;
+}
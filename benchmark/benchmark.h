@@ -21,5 +21,48 @@
 
 #include <iostream>
 #include <chrono>
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief 测量func的执行时间并打印
+ * @return 执行时间，单位为纳秒
+ */
+template <typename Func>
+long long measure(const std::string & label, Func && func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << label << ": " << ns / 1000000.0 << " ms" << std::endl;
+    return ns;
+}
+
+/**
+ * @brief 测量func的执行时间并打印平均每次操作的耗时
+ * @param ops func中执行的操作次数
+ * @return 执行时间，单位为纳秒
+ */
+template <typename Func>
+long long measure(const std::string & label, std::size_t ops, Func && func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << label << ": " << ns / 1000000.0 << " ms, "
+              << (ops == 0 ? 0.0 : static_cast<double>(ns) / ops) << " ns/op" << std::endl;
+    return ns;
+}
+
+/**
+ * @brief 防止编译器优化掉没有使用的结果
+ */
+template <typename T>
+void do_not_optimize(const T & value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
 
 #endif
\ No newline at end of file
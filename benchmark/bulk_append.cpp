@@ -0,0 +1,91 @@
+#include <deque>
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/deque.h"
+
+/**
+ * @brief 模拟一条待写入的记录
+ */
+class record
+{
+public:
+    std::uint64_t id;
+    std::uint64_t timestamp;
+    double value;
+};
+
+/**
+ * @brief 用四种方式把n条记录追加到Container
+ * @details 逐个push_back、append_range、append(n, generator)和预留后不检查容量的插入迭代器
+ */
+template <class Container>
+void run(const std::string & name, const std::vector<record> & records)
+{
+    std::size_t n = records.size();
+
+    measure(name + " push_back", n, [&]() {
+        Container c;
+        for (const record & r : records) {
+            c.push_back(r);
+        }
+        do_not_optimize(c.back().id);
+    });
+
+    measure(name + " append_range", n, [&]() {
+        Container c;
+        c.append_range(records.begin(), records.end());
+        do_not_optimize(c.back().id);
+    });
+
+    measure(name + " append(n, generator)", n, [&]() {
+        Container c;
+        std::uint64_t i = 0;
+        c.append(n, [&]() { record r{i, i * 3, i * 0.5}; ++i; return r; });
+        do_not_optimize(c.back().id);
+    });
+
+    measure(name + " unchecked_back_inserter", n, [&]() {
+        Container c;
+        std::copy(records.begin(), records.end(), stl::unchecked_back_inserter(c, n));
+        do_not_optimize(c.back().id);
+    });
+}
+
+/**
+ * @brief 标准库容器的逐个push_back和range insert作为对照
+ */
+template <class Container>
+void run_std(const std::string & name, const std::vector<record> & records)
+{
+    std::size_t n = records.size();
+
+    measure(name + " push_back", n, [&]() {
+        Container c;
+        for (const record & r : records) {
+            c.push_back(r);
+        }
+        do_not_optimize(c.back().id);
+    });
+
+    measure(name + " insert(end, first, last)", n, [&]() {
+        Container c;
+        c.insert(c.end(), records.begin(), records.end());
+        do_not_optimize(c.back().id);
+    });
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 5000000;
+    std::vector<record> records(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        records[i] = record{i, i * 3, i * 0.5};
+    }
+
+    run<stl::vector<record>>("stl::vector", records);
+    run_std<std::vector<record>>("std::vector", records);
+    run<stl::deque<record>>("stl::deque", records);
+    run_std<std::deque<record>>("std::deque", records);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <mutex>
+#include <thread>
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/concurrent_vector.h"
+
+/**
+ * @brief 启动threads个线程，每个线程调用func(t)，返回总耗时
+ */
+template <class Func>
+void run_threads(std::size_t threads, Func func)
+{
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(func, t);
+    }
+    for (auto & worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief 1到64个线程共同追加total个元素，比较互斥锁保护的vector和concurrent_vector
+ */
+int main(int argc, char * argv[])
+{
+    std::size_t total = argc > 1 ? std::stoull(argv[1]) : 8000000;
+    std::size_t max_threads = argc > 2 ? std::stoull(argv[2]) : 64;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::size_t per_thread = total / threads;
+        std::string suffix = ", " + std::to_string(threads) + " threads";
+
+        {
+            stl::vector<std::uint64_t> vec;
+            std::mutex mutex;
+            measure("mutex + stl::vector push_back" + suffix, per_thread * threads, [&]() {
+                run_threads(threads, [&](std::size_t t) {
+                    for (std::size_t i = 0; i < per_thread; ++i) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        vec.push_back(t * per_thread + i);
+                    }
+                });
+            });
+            do_not_optimize(vec.size());
+        }
+
+        {
+            stl::concurrent_vector<std::uint64_t> vec;
+            measure("stl::concurrent_vector push_back" + suffix, per_thread * threads, [&]() {
+                run_threads(threads, [&](std::size_t t) {
+                    for (std::size_t i = 0; i < per_thread; ++i) {
+                        vec.push_back(t * per_thread + i);
+                    }
+                });
+            });
+            do_not_optimize(vec.size());
+        }
+
+        {
+            // 每次预留一批，减少对尺寸计数器的争用
+            stl::concurrent_vector<std::uint64_t> vec;
+            measure("stl::concurrent_vector grow_by(64)" + suffix, per_thread * threads, [&]() {
+                run_threads(threads, [&](std::size_t t) {
+                    for (std::size_t i = 0; i + 64 <= per_thread; i += 64) {
+                        auto it = vec.grow_by(64);
+                        for (std::size_t j = 0; j < 64; ++j, ++it) {
+                            *it = t * per_thread + i + j;
+                        }
+                    }
+                });
+            });
+            do_not_optimize(vec.size());
+        }
+
+        {
+            stl::concurrent_vector<std::uint64_t> vec;
+            vec.grow_by(total);
+            measure("stl::concurrent_vector operator[]" + suffix, per_thread * threads, [&]() {
+                run_threads(threads, [&](std::size_t t) {
+                    std::uint64_t sum = 0;
+                    for (std::size_t i = 0; i < per_thread; ++i) {
+                        sum += vec[(i * 7919 + t) % total];
+                    }
+                    do_not_optimize(sum);
+                });
+            });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <deque>
+#include "benchmark.h"
+#include "../src/deque.h"
+
+/**
+ * @brief 64字节的元素
+ */
+class wide
+{
+public:
+    std::uint64_t key;
+    std::uint64_t payload[7];
+
+    wide(std::uint64_t k = 0) : key(k), payload() {}
+    operator std::uint64_t() const { return key; }
+};
+
+/**
+ * @brief 两端插入删除、随机下标访问和顺序遍历
+ */
+template <class Container>
+void run(const std::string & name, std::size_t n, const std::vector<std::size_t> & indices)
+{
+    {
+        Container c;
+        measure(name + " push_back", n, [&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                c.push_back(i);
+            }
+        });
+        measure(name + " pop_back", n, [&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                c.pop_back();
+            }
+        });
+        do_not_optimize(c.size());
+    }
+
+    {
+        Container c;
+        measure(name + " push_front", n, [&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                c.push_front(i);
+            }
+        });
+        measure(name + " pop_front", n, [&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                c.pop_front();
+            }
+        });
+        do_not_optimize(c.size());
+    }
+
+    Container c;
+    for (std::size_t i = 0; i < n / 2; ++i) {
+        c.push_back(i);
+        c.push_front(i);
+    }
+    measure(name + " random operator[]", indices.size(), [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t index : indices) {
+            sum += static_cast<std::uint64_t>(c[index]);
+        }
+        do_not_optimize(sum);
+    });
+    measure(name + " iterator += stride", indices.size(), [&]() {
+        std::uint64_t sum = 0;
+        auto it = c.begin();
+        std::ptrdiff_t size = static_cast<std::ptrdiff_t>(c.size());
+        std::ptrdiff_t pos = 0;
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            // 前后跳跃，覆盖跨缓冲区的正负偏移
+            std::ptrdiff_t step = static_cast<std::ptrdiff_t>(indices[i]) - pos;
+            it += step;
+            pos += step;
+            sum += static_cast<std::uint64_t>(*it);
+        }
+        do_not_optimize(sum);
+        do_not_optimize(size);
+    });
+    measure(name + " iterate", c.size(), [&]() {
+        std::uint64_t sum = 0;
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            sum += static_cast<std::uint64_t>(*it);
+        }
+        do_not_optimize(sum);
+    });
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 4000000;
+    std::vector<std::size_t> indices(n);
+    std::mt19937_64 rng(11);
+    for (auto & index : indices) {
+        index = rng() % n;
+    }
+
+    run<stl::deque<std::uint64_t>>("stl::deque<uint64_t> 512B", n, indices);
+    run<stl::deque<std::uint64_t, stl::allocator<std::uint64_t>, stl::page_deque_buffer_policy>>("stl::deque<uint64_t> 4KB", n, indices);
+    run<std::deque<std::uint64_t>>("std::deque<uint64_t>", n, indices);
+
+    std::size_t wide_n = n / 4;
+    std::vector<std::size_t> wide_indices(indices.begin(), indices.begin() + wide_n);
+    for (auto & index : wide_indices) {
+        index %= wide_n;
+    }
+    run<stl::deque<wide>>("stl::deque<wide> 512B", wide_n, wide_indices);
+    run<stl::deque<wide, stl::allocator<wide>, stl::page_deque_buffer_policy>>("stl::deque<wide> 4KB", wide_n, wide_indices);
+    run<std::deque<wide>>("std::deque<wide>", wide_n, wide_indices);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <bitset>
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/dynamic_bitset.h"
+
+constexpr std::size_t bits = std::size_t(1) << 26;
+
+/**
+ * @brief 位集合上的常见操作：随机置位、计数、遍历为1的位、按位与、区间赋值
+ */
+int main(int argc, char * argv[])
+{
+    std::size_t rounds = argc > 1 ? std::stoull(argv[1]) : 20;
+    std::vector<std::size_t> positions(bits / 8);
+    std::mt19937_64 rng(5);
+    for (auto & pos : positions) {
+        pos = rng() % bits;
+    }
+
+    stl::dynamic_bitset<> dyn(bits), dyn_mask(bits);
+    stl::vector<bool> stl_vec(bits);
+    std::vector<bool> std_vec(bits);
+    auto std_set = std::make_unique<std::bitset<bits>>();
+    auto std_mask = std::make_unique<std::bitset<bits>>();
+    std::cout << "stl::vector<bool> capacity: " << stl_vec.capacity() / 8 / 1024 << " KB for " << bits << " flags" << std::endl;
+
+    measure("stl::dynamic_bitset set", positions.size(), [&]() {
+        for (std::size_t pos : positions) dyn.set(pos);
+    });
+    measure("stl::vector<bool> set", positions.size(), [&]() {
+        for (std::size_t pos : positions) stl_vec[pos] = true;
+    });
+    measure("std::vector<bool> set", positions.size(), [&]() {
+        for (std::size_t pos : positions) std_vec[pos] = true;
+    });
+    measure("std::bitset set", positions.size(), [&]() {
+        for (std::size_t pos : positions) std_set->set(pos);
+    });
+    for (std::size_t i = 0; i < bits; i += 3) {
+        dyn_mask.set(i);
+        std_mask->set(i);
+    }
+
+    const char * kernels[] = {"portable", "popcnt", "avx2"};
+    for (auto kernel : {stl::popcount_kernel::portable, stl::popcount_kernel::popcnt, stl::popcount_kernel::avx2}) {
+        if (!stl::set_bit_popcount_kernel(kernel)) {
+            continue;
+        }
+        measure(std::string("stl::dynamic_bitset count, ") + kernels[static_cast<int>(kernel)], bits * rounds, [&]() {
+            std::size_t sum = 0;
+            for (std::size_t r = 0; r < rounds; ++r) sum += dyn.count();
+            do_not_optimize(sum);
+        });
+    }
+    measure("stl::vector<bool> count", bits * rounds, [&]() {
+        std::size_t sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) sum += stl_vec.count();
+        do_not_optimize(sum);
+    });
+    measure("std::vector<bool> std::count", bits, [&]() {
+        do_not_optimize(std::count(std_vec.begin(), std_vec.end(), true));
+    });
+    measure("std::bitset count", bits * rounds, [&]() {
+        std::size_t sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) sum += std_set->count();
+        do_not_optimize(sum);
+    });
+
+    measure("stl::dynamic_bitset find_first/find_next", bits, [&]() {
+        std::size_t sum = 0;
+        for (std::size_t pos = dyn.find_first(); pos != dyn.npos; pos = dyn.find_next(pos)) sum += pos;
+        do_not_optimize(sum);
+    });
+    measure("std::vector<bool> scan", bits, [&]() {
+        std::size_t sum = 0;
+        for (std::size_t pos = 0; pos < bits; ++pos) {
+            if (std_vec[pos]) sum += pos;
+        }
+        do_not_optimize(sum);
+    });
+    measure("std::bitset _Find_first/_Find_next", bits, [&]() {
+        std::size_t sum = 0;
+        for (std::size_t pos = std_set->_Find_first(); pos < bits; pos = std_set->_Find_next(pos)) sum += pos;
+        do_not_optimize(sum);
+    });
+
+    measure("stl::dynamic_bitset &=", bits * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) dyn &= dyn_mask;
+        do_not_optimize(dyn.data()[0]);
+    });
+    measure("std::bitset &=", bits * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) *std_set &= *std_mask;
+        do_not_optimize(std_set->test(0));
+    });
+
+    measure("stl::dynamic_bitset set_range", bits * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) dyn.set_range(r + 1, bits - r, r % 2 == 0);
+        do_not_optimize(dyn.data()[0]);
+    });
+    measure("std::vector<bool> std::fill", bits * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r) std::fill(std_vec.begin() + r + 1, std_vec.end() - r, r % 2 == 0);
+        do_not_optimize(std_vec[0]);
+    });
+
+    return 0;
+}
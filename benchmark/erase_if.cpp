@@ -0,0 +1,98 @@
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/deque.h"
+
+/**
+ * @brief 模拟一次淘汰：删除约30%的元素
+ */
+bool evicted(std::uint64_t x)
+{
+    return x % 10 < 3;
+}
+
+template <class Container>
+void fill(Container & c, const std::vector<std::uint64_t> & values)
+{
+    for (std::uint64_t x : values) {
+        c.push_back(x);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+    std::size_t small = argc > 2 ? std::stoull(argv[2]) : 100000;
+    std::vector<std::uint64_t> values(n);
+    std::mt19937_64 rng(3);
+    for (auto & x : values) {
+        x = rng();
+    }
+
+    // 逐个erase每次都移动整个尾部，是O(n^2)的，只能用较小的规模
+    {
+        stl::vector<std::uint64_t> vec;
+        fill(vec, std::vector<std::uint64_t>(values.begin(), values.begin() + small));
+        measure("stl::vector erase(pos) loop, " + std::to_string(small) + " elements", small, [&]() {
+            for (auto it = vec.begin(); it != vec.end();) {
+                it = evicted(*it) ? vec.erase(it) : it + 1;
+            }
+            do_not_optimize(vec.size());
+        });
+    }
+
+    {
+        stl::vector<std::uint64_t> vec;
+        fill(vec, values);
+        measure("stl::vector erase_if", n, [&]() {
+            do_not_optimize(stl::erase_if(vec, evicted));
+        });
+    }
+
+    {
+        stl::vector<std::uint64_t> vec;
+        fill(vec, values);
+        measure("stl::vector unordered_erase loop", n, [&]() {
+            for (auto it = vec.begin(); it != vec.end();) {
+                if (evicted(*it)) {
+                    it = vec.unordered_erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            do_not_optimize(vec.size());
+        });
+    }
+
+    {
+        std::vector<std::uint64_t> vec(values);
+        measure("std::vector remove_if + erase", n, [&]() {
+            vec.erase(std::remove_if(vec.begin(), vec.end(), evicted), vec.end());
+            do_not_optimize(vec.size());
+        });
+    }
+
+    {
+        stl::deque<std::uint64_t> deq;
+        fill(deq, values);
+        measure("stl::deque erase_if", n, [&]() {
+            do_not_optimize(stl::erase_if(deq, evicted));
+        });
+    }
+
+    {
+        stl::deque<std::uint64_t> deq;
+        fill(deq, values);
+        measure("stl::deque unordered_erase loop", n, [&]() {
+            for (auto it = deq.begin(); it != deq.end();) {
+                if (evicted(*it)) {
+                    it = deq.unordered_erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            do_not_optimize(deq.size());
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <string_view>
+#include "benchmark.h"
+#include "../src/hash.h"
+
+/**
+ * @brief 以GB/s为单位测量对固定长度key的哈希吞吐
+ * @details 每次哈希都从不同的偏移开始，避免编译器把结果提到循环外
+ */
+template <class Func>
+void run(const std::string & name, const std::vector<unsigned char> & buffer, std::size_t len, Func && func)
+{
+    const std::size_t total = std::size_t(1) << 28;     // 每个长度处理256MB
+    std::size_t iterations = total / len;
+    std::size_t range = buffer.size() - len;
+    long long ns = measure(name + " " + std::to_string(len) + "B", iterations, [&]() {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            sum += func(buffer.data() + (i * 64) % range, len);
+        }
+        do_not_optimize(sum);
+    });
+    std::cout << "    " << static_cast<double>(iterations * len) / ns << " GB/s" << std::endl;
+}
+
+int main()
+{
+    const std::size_t lengths[] = {8, 16, 32, 64, 128, 256, 512, 1024, 4096};
+    std::vector<unsigned char> buffer(1 << 16);
+    std::mt19937_64 rng(7);
+    for (auto & byte : buffer) {
+        byte = static_cast<unsigned char>(rng());
+    }
+
+    for (std::size_t len : lengths) {
+        run("stl::hash_bytes", buffer, len, [](const unsigned char * p, std::size_t n) {
+            return stl::hash_bytes(p, n);
+        });
+        if (len > stl::__hash_short_max) {
+            run("stl::hash_bytes portable", buffer, len, [](const unsigned char * p, std::size_t n) {
+                return static_cast<std::size_t>(stl::__hash_bytes_long(p, n, 0, false));
+            });
+        }
+        run("std::hash<string_view>", buffer, len, [](const unsigned char * p, std::size_t n) {
+            return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char *>(p), n));
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "benchmark.h"
+#include "../src/unordered_map.h"
+#include "../src/flat_hash_map.h"
+
+/**
+ * @brief 对一种map执行插入、命中查找、未命中查找和删除
+ * @param keys 要插入的key
+ * @param misses 不在map中的key
+ */
+template <typename Map>
+void run(const std::string & name, const std::vector<std::uint64_t> & keys, const std::vector<std::uint64_t> & misses)
+{
+    std::size_t n = keys.size();
+    // 小规模时重复查找，保证每组查找的总次数足够多
+    std::size_t rounds = std::max<std::size_t>(1, 1000000 / n);
+    Map map;
+
+    measure(name + " insert", n, [&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            map[keys[i]] = i;
+        }
+    });
+
+    measure(name + " hit lookup", n * rounds, [&]() {
+        std::size_t found = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < n; ++i) {
+                found += map.find(keys[n - 1 - i]) != map.end();
+            }
+        }
+        do_not_optimize(found);
+    });
+
+    measure(name + " miss lookup", n * rounds, [&]() {
+        std::size_t found = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < n; ++i) {
+                found += map.find(misses[i]) != map.end();
+            }
+        }
+        do_not_optimize(found);
+    });
+
+    measure(name + " erase", n, [&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            map.erase(keys[i]);
+        }
+    });
+}
+
+int main(int argc, char * argv[])
+{
+    // 可以通过参数限制最大规模，默认测到10M
+    std::size_t max_n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+    std::mt19937_64 rng(42);
+    for (std::size_t n = 1000; n <= max_n; n *= 10) {
+        std::vector<std::uint64_t> keys(n), misses(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = rng();
+            misses[i] = rng();
+        }
+
+        std::cout << "keys: " << n << std::endl;
+        run<stl::flat_hash_map<std::uint64_t, std::uint64_t>>("stl flat_hash_map", keys, misses);
+        run<stl::unordered_map<std::uint64_t, std::uint64_t>>("stl unordered_map", keys, misses);
+        run<std::unordered_map<std::uint64_t, std::uint64_t>>("std unordered_map", keys, misses);
+    }
+
+    return 0;
+}
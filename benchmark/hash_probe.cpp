@@ -0,0 +1,74 @@
+#include "benchmark.h"
+#include "../src/flat_hash_set.h"
+
+/**
+ * @brief 在固定槽数下测量不同负载因子的探测长度和未命中查找耗时
+ */
+void run(const std::string & name, std::size_t capacity)
+{
+    const float load_factors[] = {0.25f, 0.5f, 0.75f, 0.875f, 0.95f};
+    std::size_t lookups = 1000000;
+
+    std::mt19937_64 rng(7);
+    std::vector<std::uint64_t> misses(lookups);
+    for (auto & key : misses) {
+        key = rng();
+    }
+
+    for (float lf : load_factors) {
+        stl::flat_hash_set<std::uint64_t> set;
+        set.max_load_factor(0.96f);
+        set.rehash(capacity);
+        std::size_t n = static_cast<std::size_t>(capacity * lf);
+        std::vector<std::uint64_t> keys(n);
+        for (auto & key : keys) {
+            key = rng();
+            set.insert(key);
+        }
+
+        // 平均探测的组数
+        std::size_t hit_probes = 0, miss_probes = 0;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            hit_probes += set.probe_length(keys[i % n]);
+            miss_probes += set.probe_length(misses[i]);
+        }
+        std::cout << name << " load factor " << set.load_factor()
+                  << ": hit probe " << static_cast<double>(hit_probes) / lookups
+                  << ", miss probe " << static_cast<double>(miss_probes) / lookups << std::endl;
+
+        measure(name + " miss lookup", lookups, [&]() {
+            std::size_t found = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                found += set.count(misses[i]);
+            }
+            do_not_optimize(found);
+        });
+        measure(name + " hit lookup", lookups, [&]() {
+            std::size_t found = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                found += set.count(keys[i % n]);
+            }
+            do_not_optimize(found);
+        });
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t capacity = argc > 1 ? std::stoull(argv[1]) : (1 << 20);
+
+    const std::pair<stl::flat_group_kernel, const char *> kernels[] = {
+        {stl::flat_group_kernel::portable, "portable"},
+        {stl::flat_group_kernel::sse2, "sse2"},
+        {stl::flat_group_kernel::avx2, "avx2"},
+    };
+    for (const auto & kernel : kernels) {
+        if (!stl::set_flat_hash_group_kernel(kernel.first)) {
+            std::cout << kernel.second << ": not supported" << std::endl;
+            continue;
+        }
+        run(kernel.second, capacity);
+    }
+
+    return 0;
+}
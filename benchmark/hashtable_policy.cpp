@@ -0,0 +1,78 @@
+#include "benchmark.h"
+#include "../src/hashtable.h"
+#include "../src/functional.h"
+
+template <class RangePolicy>
+using policy_table = stl::hashtable<std::uint64_t, std::uint64_t, stl::hash<std::uint64_t>, stl::equal_to<std::uint64_t>,
+                                    stl::keyExtractor<stl::pair<const std::uint64_t, std::uint64_t>>,
+                                    stl::allocator<std::uint64_t>, RangePolicy>;
+
+/**
+ * @brief 用同一组key测量一种桶索引策略的命中查找
+ */
+template <class RangePolicy>
+void run(const std::string & name, const std::vector<std::uint64_t> & keys, const std::vector<std::uint64_t> & order)
+{
+    policy_table<RangePolicy> table(50, stl::hash<std::uint64_t>(), stl::equal_to<std::uint64_t>());
+    for (std::uint64_t key : keys) {
+        table.insert_unique(stl::pair<const std::uint64_t, std::uint64_t>(key, key));
+    }
+
+    // 最长的桶可以反映出策略对该组key的分布质量
+    std::size_t longest = 0;
+    for (std::size_t i = 0; i < table.bucket_count(); ++i) {
+        std::size_t length = 0;
+        for (auto it = table.begin(i); it != table.end(i); ++it) {
+            ++length;
+        }
+        longest = std::max(longest, length);
+    }
+
+    measure(name, order.size(), [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t i : order) {
+            sum += table.find(keys[i])->second;
+        }
+        do_not_optimize(sum);
+    });
+    std::cout << "    buckets: " << table.bucket_count() << ", longest chain: " << longest << std::endl;
+}
+
+void run_all(const std::string & pattern, const std::vector<std::uint64_t> & keys)
+{
+    // 以随机顺序查找，避免顺序key在取模策略下的链表顺序访问掩盖除法开销
+    std::vector<std::uint64_t> order(keys.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+
+    run<stl::mod_range_policy>(pattern + " mod", keys, order);
+    run<stl::pow2_range_policy>(pattern + " pow2", keys, order);
+    run<stl::fastrange_policy>(pattern + " fastrange", keys, order);
+    run<stl::prime_range_policy>(pattern + " prime", keys, order);
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    std::vector<std::uint64_t> keys(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = i;
+    }
+    run_all("sequential", keys);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = i * 64;
+    }
+    run_all("stride 64", keys);
+
+    std::mt19937_64 rng(7);
+    for (auto & key : keys) {
+        key = rng();
+    }
+    run_all("random", keys);
+
+    return 0;
+}
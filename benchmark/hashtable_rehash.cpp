@@ -0,0 +1,53 @@
+#include <chrono>
+#include "benchmark.h"
+#include "../src/hashtable.h"
+#include "../src/functional.h"
+
+using table_type = stl::hashtable<std::uint64_t, std::uint64_t, stl::hash<std::uint64_t>, stl::equal_to<std::uint64_t>,
+                                  stl::keyExtractor<stl::pair<const std::uint64_t, std::uint64_t>>,
+                                  stl::allocator<std::uint64_t>>;
+
+/**
+ * @brief 逐个计时插入，输出插入延迟的分位数和最大值
+ */
+void run(const std::string & name, const std::vector<std::uint64_t> & keys, bool incremental, std::size_t buckets_per_step)
+{
+    table_type table(50, stl::hash<std::uint64_t>(), stl::equal_to<std::uint64_t>());
+    table.incremental_rehash(incremental, buckets_per_step);
+
+    std::vector<long long> latencies(keys.size());
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        table.insert_unique(stl::pair<const std::uint64_t, std::uint64_t>(keys[i], i));
+        auto end = std::chrono::steady_clock::now();
+        latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    }
+    auto total = std::chrono::steady_clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))];
+    };
+    std::cout << name << ": total " << std::chrono::duration_cast<std::chrono::milliseconds>(total).count() << " ms"
+              << ", p50 " << percentile(0.5) << " ns"
+              << ", p99 " << percentile(0.99) << " ns"
+              << ", p99.9 " << percentile(0.999) << " ns"
+              << ", max " << latencies.back() / 1000 << " us" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 5000000;
+    std::vector<std::uint64_t> keys(n);
+    std::mt19937_64 rng(7);
+    for (auto & key : keys) {
+        key = rng();
+    }
+
+    run("stop-the-world rehash", keys, false, 1);
+    run("incremental rehash, 1 bucket/insert", keys, true, 1);
+    run("incremental rehash, 4 buckets/insert", keys, true, 4);
+
+    return 0;
+}
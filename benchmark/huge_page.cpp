@@ -0,0 +1,124 @@
+#include <cstring>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "benchmark.h"
+#include "../src/vector.h"
+
+/**
+ * @brief 用perf_event_open统计数据TLB的加载缺失
+ * @details 没有权限或不支持时read返回-1
+ */
+class tlb_counter
+{
+protected:
+    int _fd;
+
+public:
+    tlb_counter()
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~tlb_counter()
+    {
+        if (_fd >= 0) close(_fd);
+    }
+
+    void start()
+    {
+        if (_fd < 0) return;
+        ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    long long stop()
+    {
+        if (_fd < 0) return -1;
+        ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (::read(_fd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+    }
+};
+
+/**
+ * @brief 当前进程使用的透明大页，单位为kB
+ */
+long long anon_huge_pages()
+{
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    long long value;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:" && smaps >> value) {
+            return value;
+        }
+    }
+    return -1;
+}
+
+template <class Func>
+void run(const std::string & name, std::size_t ops, Func && func)
+{
+    tlb_counter counter;
+    counter.start();
+    measure(name, ops, func);
+    long long misses = counter.stop();
+    if (misses < 0) {
+        std::cout << "    dTLB load misses: n/a" << std::endl;
+    } else {
+        std::cout << "    dTLB load misses: " << misses << ", per op: " << static_cast<double>(misses) / ops << std::endl;
+    }
+}
+
+template <class Alloc>
+void run_all(const std::string & name, std::size_t n, const std::vector<std::uint32_t> & order)
+{
+    stl::vector<std::uint64_t, Alloc> data;
+    data.resize_default_init(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        data[i] = i;
+    }
+    std::cout << name << ": AnonHugePages " << anon_huge_pages() << " kB" << std::endl;
+
+    run(name + " sequential scan", n, [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += data[i];
+        }
+        do_not_optimize(sum);
+    });
+    run(name + " random access", order.size(), [&]() {
+        std::uint64_t sum = 0;
+        for (std::uint32_t i : order) {
+            sum += data[i];
+        }
+        do_not_optimize(sum);
+    });
+}
+
+int main(int argc, char * argv[])
+{
+    // 默认1GB的uint64_t，远超4KB页面下TLB的覆盖范围
+    std::size_t n = (argc > 1 ? std::stoull(argv[1]) : 1024) << 17;
+    std::vector<std::uint32_t> order(std::size_t(1) << 24);
+    std::mt19937_64 rng(7);
+    for (auto & i : order) {
+        i = static_cast<std::uint32_t>(rng() % n);
+    }
+
+    run_all<stl::allocator<std::uint64_t>>("allocator", n, order);
+    run_all<stl::huge_page_allocator<std::uint64_t>>("huge_page_allocator", n, order);
+    return 0;
+}
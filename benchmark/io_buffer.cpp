@@ -0,0 +1,109 @@
+#include <cstdio>
+#include <cstring>
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/deque.h"
+
+/**
+ * @brief 读取整个文件到缓冲区，每次新建缓冲区，包含缺页的开销
+ */
+template <class Fill>
+void run(const std::string & name, const std::string & path, std::size_t bytes, Fill && fill)
+{
+    long long ns = measure(name, [&]() {
+        std::FILE * file = std::fopen(path.c_str(), "rb");
+        std::size_t got = fill(file);
+        std::fclose(file);
+        if (got != bytes) {
+            std::cout << "    short read: " << got << std::endl;
+        }
+    });
+    std::cout << "    " << static_cast<double>(bytes) / ns << " GB/s" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t bytes = (argc > 1 ? std::stoull(argv[1]) : 256) << 20;
+    const std::size_t chunk = 1 << 20;
+    std::string path = "io_buffer.bin";
+
+    // 准备输入文件，之后的读取都来自页缓存
+    {
+        std::vector<unsigned char> block(chunk);
+        std::mt19937_64 rng(7);
+        for (auto & byte : block) {
+            byte = static_cast<unsigned char>(rng());
+        }
+        std::FILE * file = std::fopen(path.c_str(), "wb");
+        for (std::size_t written = 0; written < bytes; written += chunk) {
+            std::fwrite(block.data(), 1, chunk, file);
+        }
+        std::fclose(file);
+    }
+
+    for (int round = 0; round < 2; ++round) {
+        run("vector resize + fread", path, bytes, [&](std::FILE * file) {
+            stl::vector<unsigned char> buffer;
+            buffer.resize(bytes);
+            std::size_t got = std::fread(buffer.data(), 1, bytes, file);
+            do_not_optimize(buffer[bytes - 1]);
+            return got;
+        });
+        run("vector resize_default_init + fread", path, bytes, [&](std::FILE * file) {
+            stl::vector<unsigned char> buffer;
+            buffer.resize_default_init(bytes);
+            std::size_t got = std::fread(buffer.data(), 1, bytes, file);
+            do_not_optimize(buffer[bytes - 1]);
+            return got;
+        });
+        run("vector append_uninitialized + fread per 1MB", path, bytes, [&](std::FILE * file) {
+            stl::vector<unsigned char> buffer;
+            buffer.reserve(bytes + chunk);      // 读到文件末尾的最后一次也需要空间
+            std::size_t got = 0;
+            while (true) {
+                unsigned char * dest = buffer.append_uninitialized(chunk);
+                std::size_t n = std::fread(dest, 1, chunk, file);
+                buffer.commit_append(n);
+                got += n;
+                if (n < chunk) break;
+            }
+            do_not_optimize(buffer[bytes - 1]);
+            return got;
+        });
+        run("deque push_back from 1MB block", path, bytes, [&](std::FILE * file) {
+            stl::deque<unsigned char> buffer;
+            std::vector<unsigned char> block(chunk);
+            std::size_t got = 0;
+            std::size_t n;
+            while ((n = std::fread(block.data(), 1, chunk, file)) > 0) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    buffer.push_back(block[i]);
+                }
+                got += n;
+            }
+            do_not_optimize(buffer.back());
+            return got;
+        });
+        run("deque append_uninitialized + memcpy from 1MB block", path, bytes, [&](std::FILE * file) {
+            // 双端队列的缓冲区很小，逐段调用fread的开销太大，先读入块再按段拷贝
+            stl::deque<unsigned char> buffer;
+            std::vector<unsigned char> block(chunk);
+            std::size_t got = 0;
+            std::size_t n;
+            while ((n = std::fread(block.data(), 1, chunk, file)) > 0) {
+                for (std::size_t copied = 0; copied < n; ) {
+                    auto space = buffer.append_uninitialized(n - copied);
+                    std::memcpy(space.first, block.data() + copied, space.second);
+                    buffer.commit_append(space.second);
+                    copied += space.second;
+                }
+                got += n;
+            }
+            do_not_optimize(buffer.back());
+            return got;
+        });
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
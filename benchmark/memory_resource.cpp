@@ -0,0 +1,73 @@
+#include "benchmark.h"
+#include "../src/unordered_map.h"
+
+using value_type = stl::pair<const std::uint64_t, std::uint64_t>;
+
+template <class Alloc>
+using map_type = stl::unordered_map<std::uint64_t, std::uint64_t, stl::hash<std::uint64_t>, stl::equal_to<std::uint64_t>, Alloc>;
+
+/**
+ * @brief 模拟一次请求：建立一个有elements个元素的哈希表，查找一遍后丢弃
+ */
+template <class Alloc>
+std::uint64_t handle_request(const Alloc & alloc, std::size_t elements)
+{
+    map_type<Alloc> map(alloc);
+    for (std::uint64_t i = 0; i < elements; ++i) {
+        map.insert(value_type(i * 0x9E3779B97F4A7C15ull, i));
+    }
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < elements; i += 16) {
+        sum += map.find(i * 0x9E3779B97F4A7C15ull)->second;
+    }
+    return sum;
+}
+
+/**
+ * @brief 测量每次请求建立并丢弃哈希表的耗时
+ * @param after_request 每次请求结束后调用，单调缓冲区在这里一次性释放内存
+ */
+template <class Alloc, class AfterRequest>
+void run(const std::string & name, const Alloc & alloc, std::size_t elements, std::size_t requests, AfterRequest && after_request)
+{
+    measure(name, requests, [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            sum += handle_request(alloc, elements);
+            after_request();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t elements = argc > 1 ? std::stoull(argv[1]) : 100000;
+    std::size_t requests = argc > 2 ? std::stoull(argv[2]) : 50;
+    auto nothing = []() {};
+
+    run("allocator", stl::allocator<value_type>(), elements, requests, nothing);
+    run("polymorphic_allocator, new_delete_resource",
+        stl::polymorphic_allocator<value_type>(stl::new_delete_resource()), elements, requests, nothing);
+
+    // 单调缓冲区析构时不逐个释放节点，每次请求结束后整体归还
+    stl::monotonic_buffer_resource arena;
+    run("polymorphic_allocator, monotonic_buffer_resource",
+        stl::polymorphic_allocator<value_type>(&arena), elements, requests, [&]() { arena.release(); });
+
+    // 初始缓冲区足够大时，整个请求都不需要向上游申请内存
+    std::vector<char> buffer(std::size_t(16) << 20);
+    stl::monotonic_buffer_resource sized_arena(buffer.data(), buffer.size());
+    run("polymorphic_allocator, monotonic_buffer_resource 16MB buffer",
+        stl::polymorphic_allocator<value_type>(&sized_arena), elements, requests, [&]() { sized_arena.release(); });
+
+    stl::unsynchronized_pool_resource pool;
+    run("polymorphic_allocator, unsynchronized_pool_resource",
+        stl::polymorphic_allocator<value_type>(&pool), elements, requests, nothing);
+
+    stl::synchronized_pool_resource shared_pool;
+    run("polymorphic_allocator, synchronized_pool_resource",
+        stl::polymorphic_allocator<value_type>(&shared_pool), elements, requests, nothing);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <cstdio>
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/mmap_vector.h"
+
+class record
+{
+public:
+    std::uint64_t id;
+    std::uint64_t key;
+    double value;
+    double weight;
+};
+
+/**
+ * @brief 模拟进程启动：打开数据集后访问一部分记录
+ * @param touch 打开后访问的记录下标
+ */
+template <class Container, class Open>
+void run(const std::string & name, const std::vector<std::size_t> & touch, Open && open)
+{
+    long long open_ns = 0;
+    long long total = measure(name, [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        Container data;
+        open(data);
+        open_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        std::uint64_t sum = 0;
+        for (std::size_t i : touch) {
+            sum += data[i].key;
+        }
+        do_not_optimize(sum);
+    });
+    std::cout << "    open: " << open_ns / 1000000.0 << " ms, access: " << (total - open_ns) / 1000000.0 << " ms" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = (argc > 1 ? std::stoull(argv[1]) : 1024) << 15;     // 默认1GB
+    std::string path = "mmap_vector.bin";
+    std::string raw_path = "mmap_vector.raw";
+
+    // 同一份数据分别保存为mmap_vector文件和裸记录文件
+    std::remove(path.c_str());
+    {
+        stl::mmap_vector<record> data(path);
+        data.reserve(n);
+        std::FILE * raw = std::fopen(raw_path.c_str(), "wb");
+        for (std::size_t i = 0; i < n; ++i) {
+            record r{i, i * 0x9E3779B97F4A7C15ull, i * 0.5, 1.0};
+            data.push_back(r);
+            std::fwrite(&r, sizeof(r), 1, raw);
+        }
+        std::fclose(raw);
+    }
+
+    std::mt19937_64 rng(7);
+    std::vector<std::size_t> all(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        all[i] = i;
+    }
+    std::vector<std::size_t> sample(10000);
+    for (auto & i : sample) {
+        i = rng() % n;
+    }
+
+    auto read_vector = [&](stl::vector<record> & data) {
+        data.resize_default_init(n);
+        std::FILE * raw = std::fopen(raw_path.c_str(), "rb");
+        std::size_t got = std::fread(data.data(), sizeof(record), n, raw);
+        std::fclose(raw);
+        do_not_optimize(got);
+    };
+    auto open_mmap = [&](stl::mmap_vector<record> & data) {
+        data.open(path, stl::mmap_mode::private_copy);
+    };
+
+    // 文件都在页缓存中，这里比较的是反序列化拷贝与按需缺页的开销
+    std::cout << "records: " << n << ", " << (n * sizeof(record) >> 20) << " MB" << std::endl;
+    run<stl::vector<record>>("stl::vector read, 10000 random records", sample, read_vector);
+    run<stl::mmap_vector<record>>("mmap_vector open, 10000 random records", sample, open_mmap);
+    run<stl::vector<record>>("stl::vector read, full scan", all, read_vector);
+    run<stl::mmap_vector<record>>("mmap_vector open, full scan", all, open_mmap);
+
+    std::remove(path.c_str());
+    std::remove(raw_path.c_str());
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "benchmark.h"
+#include "../src/list.h"
+#include "../src/unordered_map.h"
+
+/**
+ * @brief 链表保持live个元素，反复在尾部插入、头部删除
+ */
+template <class Alloc>
+void list_churn(const std::string & name, std::size_t live, std::size_t ops)
+{
+    stl::list<std::uint64_t, Alloc> list;
+    for (std::size_t i = 0; i < live; ++i) {
+        list.push_back(i);
+    }
+    measure(name, ops, [&]() {
+        for (std::size_t i = 0; i < ops; ++i) {
+            list.push_back(i);
+            list.pop_front();
+        }
+    });
+    do_not_optimize(list.front());
+}
+
+/**
+ * @brief 哈希表保持live个元素，每次插入一个新key并删除最旧的key
+ */
+template <class Alloc>
+void map_churn(const std::string & name, std::size_t live, std::size_t ops)
+{
+    stl::unordered_map<std::uint64_t, std::uint64_t, stl::hash<std::uint64_t>, stl::equal_to<std::uint64_t>, Alloc> map;
+    for (std::size_t i = 0; i < live; ++i) {
+        map.insert(stl::pair<const std::uint64_t, std::uint64_t>(i, i));
+    }
+    measure(name, ops, [&]() {
+        for (std::size_t i = live; i < live + ops; ++i) {
+            map.insert(stl::pair<const std::uint64_t, std::uint64_t>(i, i));
+            map.erase(i - live);
+        }
+    });
+    do_not_optimize(map.size());
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t ops = argc > 1 ? std::stoull(argv[1]) : 5000000;
+    using value_type = stl::pair<const std::uint64_t, std::uint64_t>;
+
+    for (std::size_t live : {1000, 1000000}) {
+        std::cout << "live elements: " << live << std::endl;
+        list_churn<stl::allocator<std::uint64_t>>("list churn, allocator", live, ops);
+        list_churn<stl::pool_allocator<std::uint64_t>>("list churn, pool_allocator", live, ops);
+        list_churn<stl::pool_allocator<std::uint64_t, true>>("list churn, pool_allocator thread cache", live, ops);
+        map_churn<stl::allocator<value_type>>("unordered_map churn, allocator", live, ops);
+        map_churn<stl::pool_allocator<value_type>>("unordered_map churn, pool_allocator", live, ops);
+        map_churn<stl::pool_allocator<value_type, true>>("unordered_map churn, pool_allocator thread cache", live, ops);
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <queue>
+#include "benchmark.h"
+#include "../src/queue.h"
+
+/**
+ * @brief 64字节的消息
+ */
+class message
+{
+public:
+    std::uint64_t id;
+    std::uint64_t payload[7];
+
+    message(std::uint64_t i = 0) : id(i), payload() {}
+};
+
+/**
+ * @brief 保持队列中有depth个元素，持续入队出队ops次
+ */
+template <class Queue>
+void run(const std::string & name, std::size_t depth, std::size_t ops)
+{
+    Queue q;
+    for (std::size_t i = 0; i < depth; ++i) {
+        q.push(typename Queue::value_type(i));
+    }
+    measure(name + ", depth " + std::to_string(depth), ops, [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < ops; ++i) {
+            q.push(typename Queue::value_type(i));
+            sum += reinterpret_cast<const std::uint64_t &>(q.front());
+            q.pop();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+template <class T>
+using no_spare_queue = stl::queue<T, stl::deque<T, stl::allocator<T>, stl::deque_buffer_policy<512, 0>>>;
+
+int main(int argc, char * argv[])
+{
+    std::size_t ops = argc > 1 ? std::stoull(argv[1]) : 20000000;
+
+    for (std::size_t depth : {16, 1024, 65536}) {
+        run<stl::queue<std::uint64_t>>("stl::queue<uint64_t>", depth, ops);
+        run<no_spare_queue<std::uint64_t>>("stl::queue<uint64_t> without spare buffers", depth, ops);
+        run<std::queue<std::uint64_t>>("std::queue<uint64_t>", depth, ops);
+    }
+    for (std::size_t depth : {16, 1024, 65536}) {
+        run<stl::queue<message>>("stl::queue<message>", depth, ops / 4);
+        run<no_spare_queue<message>>("stl::queue<message> without spare buffers", depth, ops / 4);
+        run<std::queue<message>>("std::queue<message>", depth, ops / 4);
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/deque.h"
+#include "../src/segmented_vector.h"
+
+/**
+ * @brief 测量追加n个元素、顺序遍历和随机下标访问的耗时
+ */
+template <class Container>
+void run(const std::string & name, std::size_t n, const std::vector<std::size_t> & indices)
+{
+    Container c;
+    measure(name + " push_back", n, [&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            c.push_back(i);
+        }
+        do_not_optimize(c.back());
+    });
+
+    measure(name + " iterate", n, [&]() {
+        std::uint64_t sum = 0;
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            sum += *it;
+        }
+        do_not_optimize(sum);
+    });
+
+    measure(name + " random operator[]", indices.size(), [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t index : indices) {
+            sum += c[index];
+        }
+        do_not_optimize(sum);
+    });
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+    std::vector<std::size_t> indices(n);
+    std::mt19937_64 rng(42);
+    for (auto & index : indices) {
+        index = rng() % n;
+    }
+
+    run<stl::vector<std::uint64_t>>("stl::vector", n, indices);
+    run<stl::deque<std::uint64_t>>("stl::deque", n, indices);
+    run<stl::segmented_vector<std::uint64_t>>("stl::segmented_vector", n, indices);
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "benchmark.h"
+#include "../src/small_vector.h"
+
+static std::size_t allocations = 0;
+
+/**
+ * @brief 统计堆分配次数的分配器
+ */
+template <class T>
+class counting_allocator : public stl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = counting_allocator<U>;
+    };
+
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) noexcept
+    {}
+
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        ++allocations;
+        return stl::allocator<T>::allocate(n, hint);
+    }
+};
+
+/**
+ * @brief 反复创建只有size个元素的短生命周期vector，统计耗时和每个vector的分配次数
+ */
+template <class Vector>
+void run(const std::string & name, std::size_t size, std::size_t rounds)
+{
+    std::size_t before = allocations;
+    measure(name + " " + std::to_string(size), rounds, [&]() {
+        std::uint64_t sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            Vector vec;
+            for (std::size_t i = 0; i < size; ++i) {
+                vec.push_back(r + i);
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                sum += vec[i];
+            }
+        }
+        do_not_optimize(sum);
+    });
+    std::cout << "    allocations per vector: " << static_cast<double>(allocations - before) / rounds << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t rounds = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    for (std::size_t size : {0, 1, 4, 8, 16, 32}) {
+        run<std::vector<std::uint64_t, counting_allocator<std::uint64_t>>>("std::vector", size, rounds);
+        run<stl::vector<std::uint64_t, counting_allocator<std::uint64_t>>>("stl::vector", size, rounds);
+        run<stl::small_vector<std::uint64_t, 8, counting_allocator<std::uint64_t>>>("stl::small_vector<8>", size, rounds);
+        run<stl::small_vector<std::uint64_t, 16, counting_allocator<std::uint64_t>>>("stl::small_vector<16>", size, rounds);
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "benchmark.h"
+#include "../src/vector.h"
+#include "../src/soa_vector.h"
+
+/**
+ * @brief 宽记录，热循环只读取其中一两个字段
+ */
+class record
+{
+public:
+    std::uint64_t id;
+    double price;
+    double quantity;
+    std::uint32_t flags;
+    char payload[44];
+};
+
+int main(int argc, char * argv[])
+{
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 2000000;
+    std::size_t rounds = argc > 2 ? std::stoull(argv[2]) : 20;
+
+    stl::vector<record> aos;
+    stl::soa_vector<std::uint64_t, double, double, std::uint32_t, std::array<char, 44>> soa;
+    measure("aos push_back", n, [&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            aos.push_back(record{i, i * 0.25, static_cast<double>(i % 100), static_cast<std::uint32_t>(i), {}});
+        }
+    });
+    measure("soa emplace_back", n, [&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            soa.emplace_back(i, i * 0.25, static_cast<double>(i % 100), static_cast<std::uint32_t>(i), std::array<char, 44>());
+        }
+    });
+
+    // 单字段扫描：AoS每条缓存行只有8字节有用
+    measure("aos sum(price)", n * rounds, [&]() {
+        double sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += aos[i].price;
+            }
+        }
+        do_not_optimize(sum);
+    });
+    measure("soa sum(price)", n * rounds, [&]() {
+        double sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            const double * price = soa.data<1>();
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += price[i];
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    // 两个字段：价格乘数量
+    measure("aos sum(price * quantity)", n * rounds, [&]() {
+        double sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += aos[i].price * aos[i].quantity;
+            }
+        }
+        do_not_optimize(sum);
+    });
+    measure("soa sum(price * quantity)", n * rounds, [&]() {
+        double sum = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            const double * price = soa.data<1>();
+            const double * quantity = soa.data<2>();
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += price[i] * quantity[i];
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    // 通过代理迭代器访问
+    measure("soa iterator count(flags odd)", n * rounds, [&]() {
+        std::size_t count = 0;
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (auto element : soa) {
+                count += std::get<3>(element) & 1;
+            }
+        }
+        do_not_optimize(count);
+    });
+
+    return 0;
+}
@@ -1,15 +1,27 @@
 #include "benchmark.h"
 #include "../src/vector.h"
 
-template <typename Func>
-void measure(const std::string & label, Func && func)
+/**
+ * @brief 从空vector开始push_back n个元素，测量扩容的总开销
+ */
+template <class Vector, class Make>
+void growth(const std::string & name, std::size_t n, Make && make)
 {
-    auto start = std::chrono::high_resolution_clock::now();
-    func();
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << label << ": " 
-              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() 
-              << " ms" << std::endl;
+    measure(name, n, [&]() {
+        Vector vec;
+        for (std::size_t i = 0; i < n; ++i) {
+            vec.push_back(make(i));
+        }
+        do_not_optimize(vec.size());
+    });
+}
+
+template <class T, class Make>
+void growth_all(const std::string & type, std::size_t n, Make && make)
+{
+    growth<std::vector<T>>("std growth " + type, n, make);
+    growth<stl::vector<T>>("stl growth " + type, n, make);
+    growth<stl::vector<T, stl::malloc_allocator<T>>>("stl growth " + type + ", malloc_allocator", n, make);
 }
 
 int main()
@@ -87,5 +99,12 @@ int main()
         }
     });
 
+    // 扩容，int和unique_ptr可平凡重定位，string需要逐个移动
+    std::size_t n = 1000000;
+    std::cout << "growth: " << n << std::endl;
+    growth_all<int>("int", n, [](std::size_t i) { return static_cast<int>(i); });
+    growth_all<std::string>("string", n, [](std::size_t i) { return std::string(32, static_cast<char>('a' + i % 26)); });
+    growth_all<std::unique_ptr<int>>("unique_ptr", n, [](std::size_t i) { return std::unique_ptr<int>(new int(static_cast<int>(i))); });
+
     return 0;
 }
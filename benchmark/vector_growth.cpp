@@ -0,0 +1,55 @@
+#include <cmath>
+#include <malloc.h>
+#include "benchmark.h"
+#include "../src/vector.h"
+
+/**
+ * @brief 统计一种增长策略在不同最终大小下的扩容次数和浪费的字节数
+ * @details 浪费的字节数为malloc实际给出的空间减去元素占用的空间，包括vector未使用的容量和分配器的尺寸类别取整
+ */
+template <class Vector>
+void run(const std::string & name, const std::vector<std::size_t> & sizes)
+{
+    using value_type = typename Vector::value_type;
+    std::size_t reallocations = 0;
+    std::size_t wasted = 0;
+    std::size_t used = 0;
+    measure(name, sizes.size(), [&]() {
+        for (std::size_t n : sizes) {
+            Vector vec;
+            std::size_t capacity = vec.capacity();
+            for (std::size_t i = 0; i < n; ++i) {
+                vec.push_back(static_cast<value_type>(i));
+                if (vec.capacity() != capacity) {
+                    capacity = vec.capacity();
+                    ++reallocations;
+                }
+            }
+            std::size_t bytes = vec.data() == nullptr ? 0 : malloc_usable_size(vec.data());
+            used += n * sizeof(value_type);
+            wasted += bytes - n * sizeof(value_type);
+            do_not_optimize(vec.size());
+        }
+    });
+    std::cout << "    reallocations per vector: " << static_cast<double>(reallocations) / sizes.size()
+              << ", wasted bytes: " << 100.0 * wasted / used << "% of used" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t count = argc > 1 ? std::stoull(argv[1]) : 20000;
+    // 最终大小在对数尺度上均匀分布，覆盖小对象和大对象的尺寸类别
+    std::vector<std::size_t> sizes(count);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> exponent(0.0, 16.0);
+    for (auto & size : sizes) {
+        size = static_cast<std::size_t>(std::pow(2.0, exponent(rng)));
+    }
+
+    run<std::vector<std::uint32_t>>("std::vector", sizes);
+    run<stl::vector<std::uint32_t, stl::allocator<std::uint32_t>, stl::double_growth_policy>>("2x, allocator", sizes);
+    run<stl::vector<std::uint32_t, stl::allocator<std::uint32_t>, stl::one_and_half_growth_policy>>("1.5x, allocator", sizes);
+    run<stl::vector<std::uint32_t, stl::malloc_allocator<std::uint32_t>, stl::double_growth_policy>>("2x, malloc_allocator", sizes);
+    run<stl::vector<std::uint32_t, stl::malloc_allocator<std::uint32_t>, stl::one_and_half_growth_policy>>("1.5x, malloc_allocator", sizes);
+    return 0;
+}
@@ -8,10 +8,10 @@ namespace stl
 
 /**
  * @brief 数组
- * @details 固定长度数组
+ * @details 固定长度数组，Alignment指定数组起始地址的对齐，默认为alignof(T)
  * @link https://zh.cppreference.com/w/cpp/container/array
  */
-template <typename T, std::size_t N>
+template <typename T, std::size_t N, std::size_t Alignment = alignof(T)>
 class array
 {
 public:
@@ -177,8 +177,13 @@ public:
     using iterator = __array_iterator;
     using const_iterator = const __array_iterator;
 
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "alignment must not be weaker than alignof(T)");
+
+    static constexpr std::size_t data_alignment = Alignment;
+
 public:
-    value_type _data[N];        // 数据
+    alignas(Alignment) value_type _data[N];     // 数据
 
 public:
     // 元素访问
@@ -239,6 +244,19 @@ public:
         return _data;
     }
 
+    /**
+     * @brief 带对齐假设的底层数据指针
+     */
+    pointer aligned_data() noexcept
+    {
+        return stl::assume_aligned<Alignment>(_data);
+    }
+
+    const_pointer aligned_data() const noexcept
+    {
+        return stl::assume_aligned<Alignment>(_data);
+    }
+
     // 迭代器
 
     iterator begin()
@@ -299,7 +317,7 @@ public:
         }
     }
 
-    void swap(array<T, N> & other) noexcept
+    void swap(array<T, N, Alignment> & other) noexcept
     {
         std::swap(_data, other._data);
     }
@@ -307,38 +325,38 @@ public:
 
 // 非成员函数
 
-template <typename T, std::size_t N>
-bool operator==(const array<T, N> & a, const array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+bool operator==(const array<T, N, Alignment> & a, const array<T, N, Alignment> & b)
 {
     return std::equal(a.begin(), a.end(), b.begin(), b.end());
 }
 
-template <typename T, std::size_t N>
-bool operator!=(const array<T, N> & a, const array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+bool operator!=(const array<T, N, Alignment> & a, const array<T, N, Alignment> & b)
 {
     return !(a == b);
 }
 
-template <typename T, std::size_t N>
-bool operator<(const array<T, N> & a, const array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+bool operator<(const array<T, N, Alignment> & a, const array<T, N, Alignment> & b)
 {
     return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
 }
 
-template <typename T, std::size_t N>
-bool operator<=(const array<T, N> & a, const array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+bool operator<=(const array<T, N, Alignment> & a, const array<T, N, Alignment> & b)
 {
     return !(b < a);
 }
 
-template <typename T, std::size_t N>
-bool operator>(const array<T, N> & a, const array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+bool operator>(const array<T, N, Alignment> & a, const array<T, N, Alignment> & b)
 {
     return b < a;
 }
 
-template <typename T, std::size_t N>
-bool operator>=(const array<T, N> & a, const array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+bool operator>=(const array<T, N, Alignment> & a, const array<T, N, Alignment> & b)
 {
     return !(a < b);
 }
@@ -346,8 +364,8 @@ bool operator>=(const array<T, N> & a, const array<T, N> & b)
 /**
  * @brief 交换两个array
  */
-template <typename T, std::size_t N>
-void swap(array<T, N> & a, array<T, N> & b)
+template <typename T, std::size_t N, std::size_t Alignment>
+void swap(array<T, N, Alignment> & a, array<T, N, Alignment> & b)
 {
     a.swap(b);
 }
@@ -355,8 +373,8 @@ void swap(array<T, N> & a, array<T, N> & b)
 /**
  * @brief 获取array中第I个元素
  */
-template <std::size_t I, class T, std::size_t N>
-T & get(array<T, N> & a)
+template <std::size_t I, class T, std::size_t N, std::size_t Alignment>
+T & get(array<T, N, Alignment> & a)
 {
     return a[I];
 }
@@ -364,8 +382,8 @@ T & get(array<T, N> & a)
 /**
  * @brief 获取array中第I个元素
  */
-template <std::size_t I, class T, std::size_t N>
-T && get(array<T, N> && a)
+template <std::size_t I, class T, std::size_t N, std::size_t Alignment>
+T && get(array<T, N, Alignment> && a)
 {
     return std::move(a[I]);
 }
@@ -373,8 +391,8 @@ T && get(array<T, N> && a)
 /**
  * @brief 获取array中第I个元素
  */
-template <std::size_t I, class T, std::size_t N>
-const T & get(const array<T, N> & a)
+template <std::size_t I, class T, std::size_t N, std::size_t Alignment>
+const T & get(const array<T, N, Alignment> & a)
 {
     return a[I];
 }
@@ -382,8 +400,8 @@ const T & get(const array<T, N> & a)
 /**
  * @brief 获取array中第I个元素
  */
-template <std::size_t I, class T, std::size_t N>
-const T && get(const array<T, N> && a)
+template <std::size_t I, class T, std::size_t N, std::size_t Alignment>
+const T && get(const array<T, N, Alignment> && a)
 {
     return std::move(a[I]);
 }
@@ -393,8 +411,8 @@ const T && get(const array<T, N> && a)
 template <std::size_t I, class T>
 class tuple_element;
 
-template <std::size_t I, class T, std::size_t N>
-class tuple_element<I, array<T, N>>
+template <std::size_t I, class T, std::size_t N, std::size_t Alignment>
+class tuple_element<I, array<T, N, Alignment>>
 {
 public:
     using type = T;
@@ -403,8 +421,8 @@ public:
 template <class T>
 class tuple_size;
 
-template<class T, std::size_t N>
-class tuple_size<array<T, N>> : std::integral_constant<std::size_t, N>
+template <class T, std::size_t N, std::size_t Alignment>
+class tuple_size<array<T, N, Alignment>> : std::integral_constant<std::size_t, N>
 {
 
 };
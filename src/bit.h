@@ -0,0 +1,439 @@
+#ifndef __BIT_H__
+#define __BIT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include "cpu.h"
+
+namespace stl
+{
+
+/**
+ * @details 按位存储的容器共用的字类型、位引用、位迭代器和字级别的算法。
+ *          所有容器都保证最后一个字中超出size的位为0，计数、查找和比较可以直接按字进行
+ */
+
+using __bit_word = std::uint64_t;
+
+constexpr std::size_t __bits_per_word = 64;
+
+/**
+ * @brief 存放bits个位需要的字数
+ */
+constexpr std::size_t __bit_words(std::size_t bits) noexcept
+{
+    return (bits + __bits_per_word - 1) / __bits_per_word;
+}
+
+/**
+ * @brief 第pos位在所在字中的掩码
+ */
+constexpr __bit_word __bit_mask(std::size_t pos) noexcept
+{
+    return static_cast<__bit_word>(1) << (pos % __bits_per_word);
+}
+
+/**
+ * @brief 指向单个位的代理引用
+ */
+class __bit_reference
+{
+protected:
+    __bit_word * _word;     // 所在的字
+    __bit_word _mask;       // 位在字中的掩码
+
+public:
+    __bit_reference(__bit_word * word, __bit_word mask) noexcept
+        : _word(word), _mask(mask)
+    {}
+
+    __bit_reference(const __bit_reference &) noexcept = default;
+
+    operator bool() const noexcept
+    {
+        return (*_word & _mask) != 0;
+    }
+
+    bool operator~() const noexcept
+    {
+        return (*_word & _mask) == 0;
+    }
+
+    __bit_reference & operator=(bool value) noexcept
+    {
+        if (value) {
+            *_word |= _mask;
+        } else {
+            *_word &= ~_mask;
+        }
+        return *this;
+    }
+
+    __bit_reference & operator=(const __bit_reference & other) noexcept
+    {
+        return *this = static_cast<bool>(other);
+    }
+
+    void flip() noexcept
+    {
+        *_word ^= _mask;
+    }
+
+    friend void swap(__bit_reference lhs, __bit_reference rhs) noexcept
+    {
+        bool temp = lhs;
+        lhs = static_cast<bool>(rhs);
+        rhs = temp;
+    }
+
+    friend void swap(__bit_reference lhs, bool & rhs) noexcept
+    {
+        bool temp = lhs;
+        lhs = rhs;
+        rhs = temp;
+    }
+
+    friend void swap(bool & lhs, __bit_reference rhs) noexcept
+    {
+        swap(rhs, lhs);
+    }
+};
+
+/**
+ * @brief 按位遍历的随机访问迭代器
+ * @details 保存所在的字和位在字中的偏移，解引用得到__bit_reference，常量迭代器得到bool
+ */
+template <bool Const>
+class __bit_iterator
+{
+public:
+    using value_type = bool;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = typename std::conditional<Const, bool, __bit_reference>::type;
+    using iterator_category = std::random_access_iterator_tag;
+    using word_pointer = typename std::conditional<Const, const __bit_word *, __bit_word *>::type;
+
+protected:
+    word_pointer _word;     // 所在的字
+    unsigned _offset;       // 位在字中的偏移，[0, 64)
+
+    using self = __bit_iterator;
+    friend class __bit_iterator<!Const>;
+
+public:
+    __bit_iterator() noexcept
+        : _word(nullptr), _offset(0)
+    {}
+
+    __bit_iterator(word_pointer word, std::size_t pos) noexcept
+        : _word(word + pos / __bits_per_word), _offset(static_cast<unsigned>(pos % __bits_per_word))
+    {}
+
+    /**
+     * @brief iterator转换为const_iterator
+     */
+    template <bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+    __bit_iterator(const __bit_iterator<OtherConst> & other) noexcept
+        : _word(other._word), _offset(other._offset)
+    {}
+
+    reference operator*() const noexcept
+    {
+        return _deref(std::integral_constant<bool, Const>());
+    }
+
+    reference operator[](difference_type n) const noexcept
+    {
+        return *(*this + n);
+    }
+
+    self & operator++() noexcept
+    {
+        if (++_offset == __bits_per_word) {
+            _offset = 0;
+            ++_word;
+        }
+        return *this;
+    }
+
+    self operator++(int) noexcept
+    {
+        self temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    self & operator--() noexcept
+    {
+        if (_offset-- == 0) {
+            _offset = __bits_per_word - 1;
+            --_word;
+        }
+        return *this;
+    }
+
+    self operator--(int) noexcept
+    {
+        self temp = *this;
+        --*this;
+        return temp;
+    }
+
+    self & operator+=(difference_type n) noexcept
+    {
+        // 偏移为负时算术右移向下取整
+        difference_type pos = static_cast<difference_type>(_offset) + n;
+        _word += pos >> 6;
+        _offset = static_cast<unsigned>(pos & 63);
+        return *this;
+    }
+
+    self & operator-=(difference_type n) noexcept
+    {
+        return *this += -n;
+    }
+
+    self operator+(difference_type n) const noexcept
+    {
+        self temp = *this;
+        return temp += n;
+    }
+
+    friend self operator+(difference_type n, const self & it) noexcept
+    {
+        return it + n;
+    }
+
+    self operator-(difference_type n) const noexcept
+    {
+        self temp = *this;
+        return temp -= n;
+    }
+
+    template <bool OtherConst>
+    difference_type operator-(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return (_word - other._word) * static_cast<difference_type>(__bits_per_word)
+               + static_cast<difference_type>(_offset) - static_cast<difference_type>(other._offset);
+    }
+
+    template <bool OtherConst>
+    bool operator==(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return _word == other._word && _offset == other._offset;
+    }
+
+    template <bool OtherConst>
+    bool operator!=(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    template <bool OtherConst>
+    bool operator<(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return _word == other._word ? _offset < other._offset : _word < other._word;
+    }
+
+    template <bool OtherConst>
+    bool operator>(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return other < *this;
+    }
+
+    template <bool OtherConst>
+    bool operator<=(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return !(other < *this);
+    }
+
+    template <bool OtherConst>
+    bool operator>=(const __bit_iterator<OtherConst> & other) const noexcept
+    {
+        return !(*this < other);
+    }
+
+protected:
+    bool _deref(std::true_type) const noexcept
+    {
+        return (*_word >> _offset) & 1;
+    }
+
+    __bit_reference _deref(std::false_type) const noexcept
+    {
+        return __bit_reference(const_cast<__bit_word *>(_word), static_cast<__bit_word>(1) << _offset);
+    }
+};
+
+/**
+ * @brief 位计数内核
+ * @details 结果与内核无关，可以在运行时切换
+ */
+enum class popcount_kernel
+{
+    portable,   // __builtin_popcountll，没有开启POPCNT时由编译器展开为位运算
+    popcnt,     // 每个字一条POPCNT指令
+    avx2        // AVX2按半字节查表，一次处理4个字
+};
+
+inline std::size_t __count_bits_portable(const __bit_word * words, std::size_t n) noexcept
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return count;
+}
+
+#if _STL_X86
+
+_STL_TARGET_POPCNT inline std::size_t __count_bits_popcnt(const __bit_word * words, std::size_t n) noexcept
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return count;
+}
+
+/**
+ * @brief AVX2位计数
+ * @details 把每个字节拆成高低两个半字节，用vpshufb查出各自的位数相加，
+ *          再用vpsadbw把每8个字节的位数横向求和到64位累加器
+ */
+_STL_TARGET_AVX2 inline std::size_t __count_bits_avx2(const __bit_word * words, std::size_t n) noexcept
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+        __m256i low = _mm256_and_si256(v, low_mask);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    std::size_t count = static_cast<std::size_t>(_mm256_extract_epi64(total, 0)) + static_cast<std::size_t>(_mm256_extract_epi64(total, 1))
+                      + static_cast<std::size_t>(_mm256_extract_epi64(total, 2)) + static_cast<std::size_t>(_mm256_extract_epi64(total, 3));
+    return count + __count_bits_popcnt(words + i, n - i);
+}
+
+#endif // _STL_X86
+
+/**
+ * @brief 当前使用的位计数内核
+ * @details 首次使用时按CPU支持的指令集选择
+ */
+inline popcount_kernel & __popcount_kernel_ref()
+{
+    static popcount_kernel kernel = cpu_has_avx2() && cpu_has_popcnt() ? popcount_kernel::avx2
+                                   : cpu_has_popcnt() ? popcount_kernel::popcnt
+                                   : popcount_kernel::portable;
+    return kernel;
+}
+
+/**
+ * @brief 返回当前使用的位计数内核
+ */
+inline popcount_kernel bit_popcount_kernel()
+{
+    return __popcount_kernel_ref();
+}
+
+/**
+ * @brief 切换位计数内核
+ * @return CPU不支持该内核时返回false，保持原内核不变
+ * @details 不是线程安全的，主要用于测试和基准测试
+ */
+inline bool set_bit_popcount_kernel(popcount_kernel kernel)
+{
+    if ((kernel == popcount_kernel::avx2 && !(cpu_has_avx2() && cpu_has_popcnt())) ||
+        (kernel == popcount_kernel::popcnt && !cpu_has_popcnt())) {
+        return false;
+    }
+    __popcount_kernel_ref() = kernel;
+    return true;
+}
+
+/**
+ * @brief 统计n个字中为1的位数
+ * @details 按当前内核分派
+ */
+inline std::size_t __count_bits(const __bit_word * words, std::size_t n) noexcept
+{
+    switch (__popcount_kernel_ref()) {
+#if _STL_X86
+    case popcount_kernel::avx2:
+        return __count_bits_avx2(words, n);
+    case popcount_kernel::popcnt:
+        return __count_bits_popcnt(words, n);
+#endif
+    default:
+        return __count_bits_portable(words, n);
+    }
+}
+
+/**
+ * @brief 查找[pos, bits)中第一个为1的位
+ * @return 不存在时返回bits
+ * @details 逐字跳过全0的字，找到非0字后用__builtin_ctzll(TZCNT/BSF)取最低位
+ */
+inline std::size_t __find_next_bit(const __bit_word * words, std::size_t bits, std::size_t pos) noexcept
+{
+    if (pos >= bits) {
+        return bits;
+    }
+    std::size_t index = pos / __bits_per_word;
+    std::size_t count = __bit_words(bits);
+    __bit_word word = words[index] & (~static_cast<__bit_word>(0) << (pos % __bits_per_word));
+    while (word == 0) {
+        if (++index == count) {
+            return bits;
+        }
+        word = words[index];
+    }
+    return index * __bits_per_word + static_cast<std::size_t>(__builtin_ctzll(word));
+}
+
+/**
+ * @brief 把[first, last)的位设置为value
+ * @details 首尾不完整的字用掩码处理，中间的整字用memset
+ */
+inline void __fill_bits(__bit_word * words, std::size_t first, std::size_t last, bool value) noexcept
+{
+    if (first >= last) {
+        return;
+    }
+    std::size_t first_word = first / __bits_per_word;
+    std::size_t last_word = (last - 1) / __bits_per_word;
+    __bit_word head = ~static_cast<__bit_word>(0) << (first % __bits_per_word);
+    __bit_word tail = ~static_cast<__bit_word>(0) >> (__bits_per_word - 1 - (last - 1) % __bits_per_word);
+    if (first_word == last_word) {
+        __bit_word mask = head & tail;
+        words[first_word] = value ? words[first_word] | mask : words[first_word] & ~mask;
+        return;
+    }
+    words[first_word] = value ? words[first_word] | head : words[first_word] & ~head;
+    std::memset(static_cast<void *>(words + first_word + 1), value ? 0xff : 0, (last_word - first_word - 1) * sizeof(__bit_word));
+    words[last_word] = value ? words[last_word] | tail : words[last_word] & ~tail;
+}
+
+/**
+ * @brief 把最后一个字中超出bits的位清零
+ */
+inline void __clear_tail_bits(__bit_word * words, std::size_t bits) noexcept
+{
+    if (bits % __bits_per_word != 0) {
+        words[bits / __bits_per_word] &= __bit_mask(bits) - 1;
+    }
+}
+
+} // namespace stl
+
+#endif
@@ -0,0 +1,699 @@
+#ifndef __CONCURRENT_VECTOR_H__
+#define __CONCURRENT_VECTOR_H__
+
+#include <atomic>
+#include <new>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "memory.h"
+
+namespace stl
+{
+
+/**
+ * @brief 支持多线程并发追加的vector
+ * @details 元素存放在大小按2倍增长的段中，第k段有first_segment_size * 2^k个元素，
+ *          从不移动已有元素，所以追加时不需要加锁。
+ *          push_back、emplace_back和grow_by用一次fetch_add预留下标，第一个用到某段的线程用CAS安装该段，
+ *          同时到达的其他线程释放自己申请的段并使用胜出者的段，整个过程是无锁的。
+ *          下标访问只有两次读取，是无等待的；一个元素只有在构造它的追加操作返回后才算提交，
+ *          其他线程需要通过返回的迭代器、线程同步等方式得知这个下标后再读取，size()包含仍在构造中的元素。
+ *          元素构造抛出异常时预留的位置用值初始化的T填充，所以要求T可以默认构造，填充时再抛出异常会调用std::terminate；
+ *          段申请失败时该段被标记为不可用，之后落在该段上的追加、at()和迭代器解引用都会抛出std::bad_alloc；
+ *          operator[]、front()和back()不做检查，只能用于已提交的元素。
+ *          clear、reserve以外的容量操作、赋值和swap不是线程安全的
+ */
+template <class T, class Alloc = allocator<T>>
+class concurrent_vector
+{
+    static_assert(std::is_default_constructible<T>::value,
+                  "concurrent_vector fills abandoned slots with T()");
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    static constexpr size_type first_segment_shift = 4;
+    static constexpr size_type first_segment_size = static_cast<size_type>(1) << first_segment_shift;
+    static constexpr size_type max_segments = std::numeric_limits<size_type>::digits - first_segment_shift;
+
+    /**
+     * @brief 并发vector的迭代器
+     * @details 保存容器和下标，解引用时按下标查找所在的段，容器增长时不会失效
+     */
+    template <bool Const>
+    class __concurrent_iterator
+    {
+    public:
+        using value_type = T;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+        using owner_pointer = typename std::conditional<Const, const concurrent_vector *, concurrent_vector *>::type;
+
+    protected:
+        owner_pointer _owner;       // 所属的容器
+        difference_type _index;     // 元素下标
+
+        using self = __concurrent_iterator;
+        friend class concurrent_vector;
+        friend class __concurrent_iterator<!Const>;
+
+    public:
+        __concurrent_iterator() noexcept
+            : _owner(nullptr), _index(0)
+        {}
+
+        __concurrent_iterator(owner_pointer owner, difference_type index) noexcept
+            : _owner(owner), _index(index)
+        {}
+
+        /**
+         * @brief iterator转换为const_iterator
+         */
+        template <bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+        __concurrent_iterator(const __concurrent_iterator<OtherConst> & other) noexcept
+            : _owner(other._owner), _index(other._index)
+        {}
+
+        /**
+         * @brief 解引用，所在段申请失败时抛出std::bad_alloc
+         */
+        reference operator*() const
+        {
+            return _owner->_checked(static_cast<size_type>(_index));
+        }
+
+        pointer operator->() const
+        {
+            return &_owner->_checked(static_cast<size_type>(_index));
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return _owner->_checked(static_cast<size_type>(_index + n));
+        }
+
+        self & operator++() noexcept
+        {
+            ++_index;
+            return *this;
+        }
+
+        self operator++(int) noexcept
+        {
+            self temp = *this;
+            ++_index;
+            return temp;
+        }
+
+        self & operator--() noexcept
+        {
+            --_index;
+            return *this;
+        }
+
+        self operator--(int) noexcept
+        {
+            self temp = *this;
+            --_index;
+            return temp;
+        }
+
+        self & operator+=(difference_type n) noexcept
+        {
+            _index += n;
+            return *this;
+        }
+
+        self & operator-=(difference_type n) noexcept
+        {
+            _index -= n;
+            return *this;
+        }
+
+        self operator+(difference_type n) const noexcept
+        {
+            return self(_owner, _index + n);
+        }
+
+        friend self operator+(difference_type n, const self & it) noexcept
+        {
+            return it + n;
+        }
+
+        self operator-(difference_type n) const noexcept
+        {
+            return self(_owner, _index - n);
+        }
+
+        template <bool OtherConst>
+        difference_type operator-(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index - other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator==(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index == other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator!=(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index != other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator<(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index < other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator>(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index > other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator<=(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index <= other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator>=(const __concurrent_iterator<OtherConst> & other) const noexcept
+        {
+            return _index >= other._index;
+        }
+    };
+
+    using iterator = __concurrent_iterator<false>;
+    using const_iterator = __concurrent_iterator<true>;
+
+protected:
+    std::atomic<size_type> _size;                   // 已预留的元素个数
+    std::atomic<pointer> _segments[max_segments];   // 各段的起始地址，未申请时为空
+    allocator_type allocator;                       // 分配器
+
+public:
+    // 构造函数
+
+    concurrent_vector() noexcept
+        : _size(0)
+    {
+        _reset_segments();
+    }
+
+    explicit concurrent_vector(const allocator_type & alloc) noexcept
+        : _size(0), allocator(alloc)
+    {
+        _reset_segments();
+    }
+
+    explicit concurrent_vector(size_type count, const allocator_type & alloc = allocator_type())
+        : concurrent_vector(alloc)
+    {
+        grow_by(count);
+    }
+
+    concurrent_vector(std::initializer_list<value_type> init, const allocator_type & alloc = allocator_type())
+        : concurrent_vector(alloc)
+    {
+        grow_by(init.begin(), init.end());
+    }
+
+    concurrent_vector(const concurrent_vector & other)
+        : concurrent_vector(other.allocator)
+    {
+        grow_by(other.begin(), other.end());
+    }
+
+    concurrent_vector(concurrent_vector && other) noexcept
+        : concurrent_vector(other.allocator)
+    {
+        swap(other);
+    }
+
+    ~concurrent_vector()
+    {
+        _release();
+    }
+
+    concurrent_vector & operator=(const concurrent_vector & other)
+    {
+        if (this != &other) {
+            concurrent_vector temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    concurrent_vector & operator=(concurrent_vector && other) noexcept
+    {
+        if (this != &other) {
+            concurrent_vector temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+    }
+
+public:
+    // 元素访问
+
+    /**
+     * @brief 访问已提交的元素，无等待
+     */
+    reference operator[](size_type pos) noexcept
+    {
+        size_type k = _segment_index(pos);
+        return _segments[k].load(std::memory_order_acquire)[pos - _segment_base(k)];
+    }
+
+    const_reference operator[](size_type pos) const noexcept
+    {
+        size_type k = _segment_index(pos);
+        return _segments[k].load(std::memory_order_acquire)[pos - _segment_base(k)];
+    }
+
+    reference at(size_type pos)
+    {
+        return const_cast<reference>(static_cast<const concurrent_vector *>(this)->at(pos));
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("concurrent_vector out of range");
+        }
+        return _checked(pos);
+    }
+
+    reference front()
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        return (*this)[size() - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[size() - 1];
+    }
+
+    /**
+     * @brief 第k段的起始地址，段内的元素连续存放
+     */
+    pointer segment_data(size_type k) noexcept
+    {
+        pointer segment = _segments[k].load(std::memory_order_acquire);
+        return _is_failed(segment) ? nullptr : segment;
+    }
+
+    /**
+     * @brief 第k段能容纳的元素个数
+     */
+    static constexpr size_type segment_capacity(size_type k) noexcept
+    {
+        return first_segment_size << k;
+    }
+
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, static_cast<difference_type>(size()));
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, static_cast<difference_type>(size()));
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 已预留的元素个数，包括仍在构造中的元素
+     */
+    size_type size() const noexcept
+    {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() - first_segment_size;
+    }
+
+    /**
+     * @brief 已申请的段能容纳的元素个数
+     */
+    size_type capacity() const noexcept
+    {
+        size_type total = 0;
+        for (size_type k = 0; k < max_segments; ++k) {
+            pointer segment = _segments[k].load(std::memory_order_acquire);
+            if (segment != nullptr && !_is_failed(segment)) {
+                total += segment_capacity(k);
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief 预先申请容纳new_cap个元素需要的段，可以和追加并发执行
+     */
+    void reserve(size_type new_cap)
+    {
+        if (new_cap > max_size()) {
+            throw std::length_error("concurrent_vector reserve too large");
+        }
+        for (size_type k = 0; k < max_segments && _segment_base(k) < new_cap; ++k) {
+            _ensure_segment(k);
+        }
+    }
+
+    // 修改器
+
+    /**
+     * @brief 析构所有元素，保留已申请的段，不是线程安全的
+     */
+    void clear() noexcept
+    {
+        _destroy_elements();
+        _size.store(0, std::memory_order_relaxed);
+    }
+
+    iterator push_back(const value_type & value)
+    {
+        return emplace_back(value);
+    }
+
+    iterator push_back(value_type && value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    /**
+     * @brief 无锁地在尾部构造一个元素
+     * @return 指向新元素的迭代器，元素在返回后才能被其他线程读取
+     */
+    template <class... Args>
+    iterator emplace_back(Args&&... args)
+    {
+        size_type pos = _size.fetch_add(1, std::memory_order_acq_rel);
+        _construct_range(pos, 1, [&](pointer slot) {
+            allocator.construct(slot, std::forward<Args>(args)...);
+        });
+        return iterator(this, static_cast<difference_type>(pos));
+    }
+
+    /**
+     * @brief 无锁地追加count个值初始化的元素
+     * @return 指向第一个新元素的迭代器
+     */
+    iterator grow_by(size_type count)
+    {
+        return _grow_by(count, [&](pointer slot) {
+            allocator.construct(slot);
+        });
+    }
+
+    /**
+     * @brief 无锁地追加count个value的副本
+     */
+    iterator grow_by(size_type count, const value_type & value)
+    {
+        return _grow_by(count, [&](pointer slot) {
+            allocator.construct(slot, value);
+        });
+    }
+
+    /**
+     * @brief 无锁地追加[first, last)中的元素，要求前向迭代器
+     */
+    template <class ForwardIterator, typename = typename std::enable_if<!std::is_integral<ForwardIterator>::value>::type>
+    iterator grow_by(ForwardIterator first, ForwardIterator last)
+    {
+        size_type count = static_cast<size_type>(std::distance(first, last));
+        return _grow_by(count, [&](pointer slot) {
+            allocator.construct(slot, *first);
+            ++first;
+        });
+    }
+
+    /**
+     * @brief 交换两个容器，不是线程安全的
+     */
+    void swap(concurrent_vector & other) noexcept
+    {
+        size_type size = _size.load(std::memory_order_relaxed);
+        _size.store(other._size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other._size.store(size, std::memory_order_relaxed);
+        for (size_type k = 0; k < max_segments; ++k) {
+            pointer segment = _segments[k].load(std::memory_order_relaxed);
+            _segments[k].store(other._segments[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other._segments[k].store(segment, std::memory_order_relaxed);
+        }
+        std::swap(allocator, other.allocator);
+    }
+
+protected:
+    // 内部函数
+
+    /**
+     * @brief 第pos个元素所在的段
+     */
+    static size_type _segment_index(size_type pos) noexcept
+    {
+        return static_cast<size_type>(std::numeric_limits<unsigned long long>::digits - 1
+            - __builtin_clzll(static_cast<unsigned long long>((pos >> first_segment_shift) + 1)));
+    }
+
+    /**
+     * @brief 第k段第一个元素的下标
+     */
+    static constexpr size_type _segment_base(size_type k) noexcept
+    {
+        return (first_segment_size << k) - first_segment_size;
+    }
+
+    /**
+     * @brief 申请失败的段使用的标记值
+     */
+    static pointer _failed_segment() noexcept
+    {
+        return reinterpret_cast<pointer>(alignof(value_type));
+    }
+
+    static bool _is_failed(pointer segment) noexcept
+    {
+        return segment == _failed_segment();
+    }
+
+    /**
+     * @brief 访问第pos个元素，所在段申请失败时抛出std::bad_alloc
+     */
+    reference _checked(size_type pos) const
+    {
+        size_type k = _segment_index(pos);
+        pointer segment = _segments[k].load(std::memory_order_acquire);
+        if (_is_failed(segment)) {
+            throw std::bad_alloc();
+        }
+        return segment[pos - _segment_base(k)];
+    }
+
+    void _reset_segments() noexcept
+    {
+        for (size_type k = 0; k < max_segments; ++k) {
+            _segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 返回第k段，不存在时申请并用CAS安装
+     * @details 多个线程同时安装时只有一个成功，其余线程释放自己申请的内存
+     */
+    pointer _ensure_segment(size_type k)
+    {
+        pointer segment = _segments[k].load(std::memory_order_acquire);
+        if (segment == nullptr) {
+            pointer fresh = nullptr;
+            try {
+                fresh = allocator.allocate(segment_capacity(k));
+            } catch (...) {
+                // 段申请失败，标记后其他线程不再尝试；其他线程已经安装了该段时直接使用
+                if (!_segments[k].compare_exchange_strong(segment, _failed_segment(), std::memory_order_acq_rel, std::memory_order_acquire)
+                    && !_is_failed(segment)) {
+                    return segment;
+                }
+                throw;
+            }
+            if (_segments[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                segment = fresh;
+            } else {
+                allocator.deallocate(fresh, segment_capacity(k));
+            }
+        }
+        if (_is_failed(segment)) {
+            throw std::bad_alloc();
+        }
+        return segment;
+    }
+
+    template <class Construct>
+    iterator _grow_by(size_type count, Construct construct)
+    {
+        if (count > max_size() - size()) {
+            throw std::length_error("concurrent_vector grow_by too large");
+        }
+        size_type pos = _size.fetch_add(count, std::memory_order_acq_rel);
+        _construct_range(pos, count, construct);
+        return iterator(this, static_cast<difference_type>(pos));
+    }
+
+    /**
+     * @brief 在预留的[pos, pos + count)上逐个构造元素
+     * @details 抛出异常时，剩下的位置用T()填充，所在段申请失败的位置跳过，然后继续抛出
+     */
+    template <class Construct>
+    void _construct_range(size_type pos, size_type count, Construct construct)
+    {
+        size_type done = 0;
+        try {
+            while (done < count) {
+                size_type k = _segment_index(pos + done);
+                pointer segment = _ensure_segment(k);
+                size_type offset = pos + done - _segment_base(k);
+                size_type n = segment_capacity(k) - offset;
+                n = n < count - done ? n : count - done;
+                for (pointer slot = segment + offset; n != 0; --n, ++slot) {
+                    construct(slot);
+                    ++done;
+                }
+            }
+        } catch (...) {
+            _fill_abandoned(pos + done, count - done);
+            throw;
+        }
+    }
+
+    /**
+     * @brief 用值初始化的元素填充预留后未能构造的位置，保证析构时每个位置都有合法的对象
+     */
+    void _fill_abandoned(size_type pos, size_type count) noexcept
+    {
+        for (size_type i = pos; i < pos + count; ++i) {
+            size_type k = _segment_index(i);
+            pointer segment = _segments[k].load(std::memory_order_acquire);
+            if (segment == nullptr) {
+                // 段还不存在，标记为失败，以后不会在该段上构造元素
+                if (_segments[k].compare_exchange_strong(segment, _failed_segment(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    continue;
+                }
+            }
+            if (!_is_failed(segment)) {
+                ::new(static_cast<void *>(segment + (i - _segment_base(k)))) value_type();
+            }
+        }
+    }
+
+    void _destroy_elements() noexcept
+    {
+        size_type count = _size.load(std::memory_order_acquire);
+        for (size_type k = 0; k < max_segments && _segment_base(k) < count; ++k) {
+            pointer segment = _segments[k].load(std::memory_order_acquire);
+            if (segment == nullptr || _is_failed(segment)) {
+                continue;
+            }
+            size_type n = count - _segment_base(k);
+            n = n < segment_capacity(k) ? n : segment_capacity(k);
+            for (size_type i = 0; i < n; ++i) {
+                allocator.destroy(segment + i);
+            }
+        }
+    }
+
+    void _release() noexcept
+    {
+        _destroy_elements();
+        for (size_type k = 0; k < max_segments; ++k) {
+            pointer segment = _segments[k].load(std::memory_order_relaxed);
+            if (segment != nullptr && !_is_failed(segment)) {
+                allocator.deallocate(segment, segment_capacity(k));
+            }
+            _segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+        _size.store(0, std::memory_order_relaxed);
+    }
+};
+
+// 非成员函数
+
+template <class T, class Alloc>
+bool operator==(const concurrent_vector<T, Alloc> & lhs, const concurrent_vector<T, Alloc> & rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator!=(const concurrent_vector<T, Alloc> & lhs, const concurrent_vector<T, Alloc> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+void swap(concurrent_vector<T, Alloc> & lhs, concurrent_vector<T, Alloc> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace stl
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef __CPU_H__
+#define __CPU_H__
+
+/**
+ * @details 运行时CPU特性检测，用于在SIMD内核之间选择
+ *          只在x86上使用GCC/Clang的内建函数检测，其他平台一律返回false，使用可移植的实现
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define _STL_X86 1
+    #include <immintrin.h>
+    // 为单个函数开启指令集，使未开启-mavx2编译的程序也能在运行时使用AVX2
+    #define _STL_TARGET_SSE2 __attribute__((target("sse2")))
+    #define _STL_TARGET_AVX2 __attribute__((target("avx2")))
+    #define _STL_TARGET_POPCNT __attribute__((target("popcnt")))
+#else
+    #define _STL_X86 0
+    #define _STL_TARGET_SSE2
+    #define _STL_TARGET_AVX2
+    #define _STL_TARGET_POPCNT
+#endif
+
+namespace stl
+{
+
+/**
+ * @brief CPU是否支持SSE2
+ * @details x86_64上SSE2是基础指令集
+ */
+inline bool cpu_has_sse2()
+{
+#if _STL_X86
+    static const bool supported = __builtin_cpu_supports("sse2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief CPU是否支持AVX2
+ */
+inline bool cpu_has_avx2()
+{
+#if _STL_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief CPU是否支持POPCNT
+ */
+inline bool cpu_has_popcnt()
+{
+#if _STL_X86
+    static const bool supported = __builtin_cpu_supports("popcnt");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace stl
+
+#endif
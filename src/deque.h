@@ -4,18 +4,53 @@
 #include <stdexcept>
 #include <limits>
 #include <initializer_list>
+#include <algorithm>
 #include "memory.h"
+#include "utility.h"
+#include "iterator.h"
 
 #include <iostream>
 
 namespace stl
 {
 
+/**
+ * @brief 按字节预算确定缓冲区大小的策略
+ * @details 每个缓冲区的元素个数是2的幂，取不超过ByteBudget字节的最大值，但至少16个元素，
+ *          这样迭代器的下标运算只需要移位和按位与。
+ *          SpareBuffers是deque最多缓存的空闲缓冲区个数，队列式的一端进一端出时可以复用缓冲区而不用反复申请释放
+ */
+template <std::size_t ByteBudget, std::size_t SpareBuffers = 2>
+class deque_buffer_policy
+{
+    static_assert(ByteBudget > 0, "buffer byte budget must be positive");
+
+public:
+    static constexpr std::size_t byte_budget = ByteBudget;
+    static constexpr std::size_t spare_buffers = SpareBuffers;
+
+    /**
+     * @brief 元素类型为T时，每个缓冲区有2^buffer_shift<T>()个元素
+     */
+    template <class T>
+    static constexpr std::size_t buffer_shift() noexcept
+    {
+        std::size_t shift = 4;
+        while ((static_cast<std::size_t>(2) << shift) * sizeof(T) <= ByteBudget) {
+            ++shift;
+        }
+        return shift;
+    }
+};
+
+using small_deque_buffer_policy = deque_buffer_policy<512>;     // 512字节，元素少时占用内存小
+using page_deque_buffer_policy = deque_buffer_policy<4096>;     // 4KB，两端操作时申请缓冲区的次数少
+
 /**
  * @brief 双端队列
  * @link https://zh.cppreference.com/w/cpp/container/deque
  */
-template <class T, class Alloc = allocator<T>>
+template <class T, class Alloc = allocator<T>, class BufferPolicy = stl::small_deque_buffer_policy>
 class deque
 {
 public:
@@ -148,16 +183,15 @@ public:
         self & operator+=(difference_type n)
         {
             difference_type offset = n + (_cur - _first);
-            difference_type _buffer_size = static_cast<difference_type>(buffer_size());
-            if (offset >= 0 && offset < _buffer_size) {
+            if (offset >= 0 && offset < static_cast<difference_type>(deque::buffer_size)) {
                 // 在当前的node中
                 _cur += n;
             } else {
                 // 不在当前的node中
-                // 计算需要移动的node数
-                difference_type node_offset = offset > 0 ? offset / _buffer_size : -((-offset - 1) / _buffer_size) - 1;
+                // 缓冲区大小是2的幂，算术右移对负数向下取整，正好是需要移动的node数
+                difference_type node_offset = offset >> deque::buffer_shift;
                 set_node(_node + node_offset);
-                _cur = _first + (offset - node_offset * _buffer_size);
+                _cur = _first + (offset & static_cast<difference_type>(deque::buffer_mask));
             }
             return *this;
         }
@@ -181,7 +215,7 @@ public:
 
         difference_type operator-(const self & other) const
         {
-            return static_cast<difference_type>((_node - other._node) * buffer_size() + (_cur - _first) - (other._cur - other._first));
+            return (_node - other._node) * static_cast<difference_type>(deque::buffer_size) + (_cur - _first) - (other._cur - other._first);
         }
 
         reference operator[](difference_type n) const
@@ -197,12 +231,7 @@ public:
         {
             _node = new_node;
             _first = *_node;
-            _last = _first + buffer_size();
-        }
-
-        size_type buffer_size() const noexcept
-        {
-            return deque::__deque_buffer_size();
+            _last = _first + deque::buffer_size;
         }
     };
 
@@ -219,6 +248,17 @@ public:
     using iterator = __deque_iterator;
     using const_iterator = __deque_iterator;
     using map_allocator_type = typename allocator_type::template rebind<pointer>::other;
+    using buffer_policy = BufferPolicy;
+
+    static constexpr size_type buffer_shift = BufferPolicy::template buffer_shift<T>();
+    static constexpr size_type buffer_size = static_cast<size_type>(1) << buffer_shift;    // 每个缓冲区的元素个数
+    static constexpr size_type buffer_mask = buffer_size - 1;
+    static constexpr size_type spare_capacity = BufferPolicy::spare_buffers;                // 最多缓存的空闲缓冲区个数
+
+    /**
+     * @brief 每个缓冲区起始地址保证的对齐字节数，由分配器决定
+     */
+    static constexpr std::size_t buffer_alignment = stl::__allocator_alignment<Alloc>::value;
 
 protected:
     iterator _start;                    // 起始位置迭代器，指向头部
@@ -226,17 +266,69 @@ protected:
     map_pointer _map;                   // 中控器指针
     size_type _map_size;                // 中控器大小
 
+    pointer _spare[spare_capacity == 0 ? 1 : spare_capacity];    // 空闲缓冲区缓存
+    size_type _spare_count;             // 缓存的空闲缓冲区个数
+
     allocator_type allocator;           // 元素分配器
     map_allocator_type  map_allocator;  // 中控器分配器
 
 public:
     // 构造函数
     deque()
-        : _start(), _finish(), _map(nullptr), _map_size(0)
+        : _start(), _finish(), _map(nullptr), _map_size(0), _spare(), _spare_count(0)
     {
         __initialize_map(0);
     }
 
+    explicit deque(const allocator_type & alloc)
+        : _start(), _finish(), _map(nullptr), _map_size(0), _spare(), _spare_count(0), allocator(alloc), map_allocator(alloc)
+    {
+        __initialize_map(0);
+    }
+
+    deque(const deque & other)
+        : deque(stl::__select_on_container_copy_construction(other.allocator))
+    {
+        append_range(other.begin(), other.end());
+    }
+
+    /**
+     * @brief 移动构造
+     * @details other会重新初始化为空的双端队列，因此需要申请一个缓冲区
+     */
+    deque(deque && other)
+        : deque(other.allocator)
+    {
+        swap(other);
+    }
+
+    ~deque()
+    {
+        __destroy_elements();
+        __destroy_nodes(_start._node, _finish._node + 1);
+        __clear_spare();
+        __deallocate_map();
+    }
+
+    deque & operator=(const deque & other)
+    {
+        if (this != &other) {
+            // 拷贝赋值不传播分配器，元素用自己的分配器构造
+            deque temp(allocator);
+            temp.append_range(other.begin(), other.end());
+            swap(temp);
+        }
+        return *this;
+    }
+
+    deque & operator=(deque && other)
+    {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
 public:
     // 小工具
 
@@ -263,14 +355,19 @@ public:
         return (*this)[static_cast<difference_type>(n)];
     }
 
+    /**
+     * @brief 下标访问，直接由起始位置算出所在的缓冲区和偏移
+     */
     reference operator[](size_type n)
     {
-        return begin()[static_cast<difference_type>(n)];
+        size_type offset = n + static_cast<size_type>(_start._cur - _start._first);
+        return _start._node[offset >> buffer_shift][offset & buffer_mask];
     }
 
     const_reference operator[](size_type n) const
     {
-        return begin()[static_cast<difference_type>(n)];
+        size_type offset = n + static_cast<size_type>(_start._cur - _start._first);
+        return _start._node[offset >> buffer_shift][offset & buffer_mask];
     }
 
     reference front()
@@ -353,34 +450,29 @@ public:
 
     /**
      * @brief 释放不使用的空间
+     * @details 释放缓存的空闲缓冲区
      */
     void shrink_to_fit()
     {
-        // TODO
+        __clear_spare();
     }
 
     // 修改器
 
     /**
      * @brief 清空双端队列
-     * @details 和标准库中的实现不太一样
+     * @details 和标准库中的实现不太一样，保留中控器和一个缓冲区，并把它移到中控器中间
      */
     void clear()
     {
-        // 暂存迭代器位置
-        map_pointer old_start = _start._node;
-        map_pointer old_finish = _finish._node;
-        // 删除所有元素
-        while (!empty())
-        {
-            pop_back();
-        }
-        // 释放所有的缓冲区
-        __destroy_nodes(old_start, old_finish + 1);
-        // 释放中控器
-        map_allocator.deallocate(_map, _map_size);
-        // 重新初始化中控器
-        __initialize_map(0);
+        __destroy_elements();
+        // 只保留起始缓冲区，其余的放入缓存或释放
+        __release_nodes(_start._node + 1, _finish._node + 1);
+        map_pointer center = _map + _map_size / 2;
+        *center = *_start._node;
+        _start.set_node(center);
+        _start._cur = _start._first;
+        _finish = _start;
     }
 
     /**
@@ -492,32 +584,51 @@ public:
         // 判断移动前面的元素还是后面的元素
         difference_type n = last - first;
         difference_type nums_before = first - _start;       // 前面的元素个数
-        if (nums_before < static_cast<difference_type>(size() - n / 2)) {
+        if (n == 0) {
+            return _start + nums_before;
+        }
+        if (nums_before < static_cast<difference_type>((size() - n) / 2)) {
             // 移动前面的元素
-            std::copy_backward(_start, first, last);
+            std::move_backward(_start, first, last);
+            iterator new_start = _start + n;
             // 销毁前面的元素
-            for (size_type i = 0; i < n; ++i) {
-                allocator.destroy((_start + i)._cur);
+            for (iterator it = _start; it != new_start; ++it) {
+                allocator.destroy(it._cur);
             }
-            // 释放前面的缓冲区
-            __destroy_nodes(_start._node, (_start + n)._node);  // 注意_start + n是新的起点缓冲区，不能被释放
-            // 设置新的起点
-            _start = _start + n;
+            // 释放前面的缓冲区，new_start所在的缓冲区不能被释放
+            __release_nodes(_start._node, new_start._node);
+            _start = new_start;
         } else {
             // 移动后面的元素
-            std::copy(last, _finish, first);
+            std::move(last, _finish, first);
+            iterator new_finish = _finish - n;
             // 销毁后面的元素
-            for (size_type i = 0; i < n; ++i) {
-                allocator.destroy((_finish - i - 1)._cur);
+            for (iterator it = new_finish; it != _finish; ++it) {
+                allocator.destroy(it._cur);
             }
-            // 释放后面的缓冲区
-            __destroy_nodes((_finish - n + 1)._node, (_finish + 1)._node);
-            // 设置新的终点
-            _finish = _finish - n;
+            // 释放后面的缓冲区，new_finish所在的缓冲区不能被释放
+            __release_nodes(new_finish._node + 1, _finish._node + 1);
+            _finish = new_finish;
         }
         return _start + nums_before;
     }
 
+    /**
+     * @brief 用尾部元素替换指定位置的元素，不保持元素顺序
+     * @details 只移动一个元素，复杂度O(1)
+     * @return 指向pos的迭代器，该位置现在是原来的尾部元素
+     */
+    iterator unordered_erase(const_iterator pos)
+    {
+        difference_type index = pos - _start;
+        iterator last = _finish - 1;
+        if (pos != last) {
+            *iterator(pos) = std::move(*last);
+        }
+        pop_back();
+        return _start + index;
+    }
+
     /**
      * @brief 尾部插入元素
      */
@@ -623,6 +734,114 @@ public:
         }
     }
 
+    /**
+     * @brief 修改双端队列的大小，新元素默认初始化
+     * @details 平凡类型的新元素不会被写入，适合随后整体覆盖的缓冲区
+     */
+    void resize_default_init(size_type count)
+    {
+        if (count < size()) {
+            erase(_start + count, _finish);
+            return;
+        }
+        size_type remaining = count - size();
+        while (remaining > 0) {
+            auto space = append_uninitialized(remaining);
+            stl::__uninitialized_default_construct_n(space.first, space.second);
+            commit_append(space.second);
+            remaining -= space.second;
+        }
+    }
+
+    /**
+     * @brief 同resize_default_init
+     */
+    void resize_for_overwrite(size_type count)
+    {
+        resize_default_init(count);
+    }
+
+    /**
+     * @brief 返回尾部可以直接写入的一段未初始化空间
+     * @param n 希望写入的元素个数
+     * @return 空间的起始指针和长度，长度不超过n，n不为0时至少为1
+     * @details 双端队列的空间不连续，一次只能给出当前缓冲区剩余的部分。
+     *          调用者在其中构造元素后调用commit_append，在此之前不能修改双端队列
+     */
+    stl::pair<pointer, size_type> append_uninitialized(size_type n)
+    {
+        size_type available = _finish._last - _finish._cur;
+        // 提前扩展中控器，使commit_append只需要申请缓冲区
+        reserve_back(n < available ? n : available);
+        return stl::pair<pointer, size_type>(_finish._cur, n < available ? n : available);
+    }
+
+    /**
+     * @brief 把append_uninitialized给出的空间中前n个已构造的元素加入双端队列
+     */
+    void commit_append(size_type n)
+    {
+        _finish._cur += n;
+        __finish_segment();
+    }
+
+    /**
+     * @brief 在中控器中为尾部的n个元素预留位置
+     * @details 缓冲区在写到时才申请，预留之后的尾部插入不再需要扩展中控器
+     */
+    void reserve_back(size_type n)
+    {
+        __reserve_map_at_back(n / __deque_buffer_size() + 1);
+    }
+
+    /**
+     * @brief 在尾部构造元素，不检查中控器的容量
+     * @details 调用者需要先用reserve_back预留位置，每个元素仍然要检查缓冲区边界
+     */
+    template <class... Args>
+    void unchecked_emplace_back(Args&&... args)
+    {
+        allocator.construct(_finish._cur, std::forward<Args>(args)...);
+        ++_finish._cur;
+        __finish_segment();
+    }
+
+    /**
+     * @brief 在尾部追加迭代器范围的元素
+     * @details 前向迭代器只预留一次中控器，然后按缓冲区整段构造
+     */
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void append_range(InputIterator first, InputIterator last)
+    {
+        __append_range(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    /**
+     * @brief 在尾部追加n个由gen()生成的元素
+     * @details 只预留一次中控器，然后按缓冲区整段构造；gen抛出异常时已追加的元素保留
+     */
+    template <class Generator>
+    void append(size_type n, Generator gen)
+    {
+        reserve_back(n);
+        while (n > 0) {
+            size_type room = _finish._last - _finish._cur;
+            size_type count = n < room ? n : room;
+            pointer first = _finish._cur;
+            pointer last = first + count;
+            try {
+                for (pointer cur = first; cur != last; ++cur, ++_finish._cur) {
+                    allocator.construct(cur, gen());
+                }
+            } catch (...) {
+                __finish_segment();
+                throw;
+            }
+            __finish_segment();
+            n -= count;
+        }
+    }
+
     /**
      * @brief 交换双端队列
      */
@@ -632,10 +851,10 @@ public:
         std::swap(_finish, other._finish);
         std::swap(_map, other._map);
         std::swap(_map_size, other._map_size);
-        // TODO，等写完allocator_traits再实现
-        // if (allocator_type::propagate_on_container_swap::value) {
-        //     std::swap(_alloc, other._alloc);
-        // }
+        std::swap(_spare, other._spare);
+        std::swap(_spare_count, other._spare_count);
+        std::swap(allocator, other.allocator);
+        std::swap(map_allocator, other.map_allocator);
     }
 
 protected:
@@ -644,10 +863,9 @@ protected:
     /**
      * @brief 计算缓冲区大小
      */
-    static size_type __deque_buffer_size()
+    static constexpr size_type __deque_buffer_size() noexcept
     {
-        // 设计为使用对象大小的8倍
-        return 8 * sizeof(value_type);
+        return buffer_size;
     }
 
     /**
@@ -667,13 +885,46 @@ protected:
         allocator.deallocate(p, __deque_buffer_size());
     }
 
+    /**
+     * @brief 取得一个缓冲区，优先使用缓存的空闲缓冲区
+     */
+    pointer __acquire_node()
+    {
+        if (_spare_count != 0) {
+            return _spare[--_spare_count];
+        }
+        return __allocate_node();
+    }
+
+    /**
+     * @brief 归还一个不再使用的缓冲区，缓存已满时才释放内存
+     */
+    void __release_node(pointer p)
+    {
+        if (_spare_count < spare_capacity) {
+            _spare[_spare_count++] = p;
+        } else {
+            __deallocate_node(p);
+        }
+    }
+
+    /**
+     * @brief 释放缓存的所有空闲缓冲区
+     */
+    void __clear_spare()
+    {
+        while (_spare_count != 0) {
+            __deallocate_node(_spare[--_spare_count]);
+        }
+    }
+
     /**
      * @brief 在中控器的某个范围内申请缓冲区内存
      */
     void __create_nodes(map_pointer first, map_pointer last)
     {
         for (map_pointer cur = first; cur != last; ++cur) {
-            *cur = __allocate_node();
+            *cur = __acquire_node();
         }
     }
 
@@ -687,6 +938,28 @@ protected:
         }
     }
 
+    /**
+     * @brief 在中控器的某个范围内归还缓冲区
+     */
+    void __release_nodes(map_pointer first, map_pointer last)
+    {
+        for (map_pointer cur = first; cur != last; ++cur) {
+            __release_node(*cur);
+        }
+    }
+
+    /**
+     * @brief 析构所有元素，不释放缓冲区
+     */
+    void __destroy_elements()
+    {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (iterator it = _start; it != _finish; ++it) {
+                allocator.destroy(it._cur);
+            }
+        }
+    }
+
     /**
      * @brief 申请中控器所需内存
      * @param n 缓冲区个数
@@ -739,9 +1012,14 @@ protected:
         // 这里需要判断是否需要重新扩展中控器，如果还有剩余缓冲区则直接构造并移动到下一个缓冲区
         __reserve_map_at_back();
         // 不管是否扩展，下一个缓冲区都是未申请内存的
-        *(_finish._node + 1) = __allocate_node();
+        *(_finish._node + 1) = __acquire_node();
         // 在当前缓冲区的最后一个位置构造元素
-        allocator.construct(_finish._cur, std::forward<Args>(args)...);
+        try {
+            allocator.construct(_finish._cur, std::forward<Args>(args)...);
+        } catch (...) {
+            __release_node(*(_finish._node + 1));
+            throw;
+        }
         // 移动到下一个位置
         _finish.set_node(_finish._node + 1);
         _finish._cur = _finish._first;
@@ -756,13 +1034,72 @@ protected:
     {
         __reserve_map_at_front();
         // 申请内存
-        *(_start._node - 1) = __allocate_node();
-        // 需要先移动到上一个缓冲区的最后一个位置，再构造元素
+        pointer node = __acquire_node();
+        *(_start._node - 1) = node;
+        try {
+            allocator.construct(node + (buffer_size - 1), std::forward<Args>(args)...);
+        } catch (...) {
+            __release_node(node);
+            throw;
+        }
+        // 移动到上一个缓冲区的最后一个位置
         _start.set_node(_start._node - 1);
         _start._cur = _start._last - 1;
-        allocator.construct(_start._cur, std::forward<Args>(args)...);
     }
     
+    /**
+     * @brief 终点移动到下一个缓冲区的起始位置
+     * @details 下一个缓冲区在这里申请，调用者保证中控器已经预留了位置
+     */
+    void __advance_finish_node()
+    {
+        *(_finish._node + 1) = __acquire_node();
+        _finish.set_node(_finish._node + 1);
+        _finish._cur = _finish._first;
+    }
+
+    /**
+     * @brief 整段写入后，写满了当前缓冲区则移动到下一个缓冲区
+     * @details 申请缓冲区失败时舍弃最后一个元素，保持终点不在缓冲区末尾
+     */
+    void __finish_segment()
+    {
+        if (_finish._cur == _finish._last) {
+            try {
+                __advance_finish_node();
+            } catch (...) {
+                --_finish._cur;
+                allocator.destroy(_finish._cur);
+                throw;
+            }
+        }
+    }
+
+    template <class ForwardIterator>
+    void __append_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+    {
+        size_type n = std::distance(first, last);
+        reserve_back(n);
+        while (n > 0) {
+            size_type room = _finish._last - _finish._cur;
+            size_type count = n < room ? n : room;
+            ForwardIterator mid = std::next(first, count);
+            std::uninitialized_copy(first, mid, _finish._cur);
+            _finish._cur += count;
+            __finish_segment();
+            first = mid;
+            n -= count;
+        }
+    }
+
+    template <class InputIterator>
+    void __append_range(InputIterator first, InputIterator last, std::input_iterator_tag)
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
     /**
      * @brief 在需要时于尾部扩展中控器
      */
@@ -786,7 +1123,9 @@ protected:
 
     /**
      * @brief 重新分配中控器
-     * @details 如果预留的缓冲区足够，则只移动中控器中缓冲区的位置，否则需要重新分配中控器内存
+     * @details 如果中控器还有足够的空位，则只把使用中的部分移到中间，否则需要重新分配中控器内存。
+     *          只在空位至少是使用中部分的一半时移动，每次移动的代价可以分摊到之后腾出的空位上，
+     *          队列式的一端进一端出时使用中的部分大小不变，中控器不会再增长
      */
     void __reallocate_map(size_type n, bool is_front)
     {
@@ -794,7 +1133,7 @@ protected:
         const size_type new_num_nodes = old_num_nodes + n;
         map_pointer new_start;
 
-        if (_map_size > 2 * new_num_nodes) {
+        if (_map_size >= new_num_nodes + new_num_nodes / 2 + 2) {
             // 预留的缓冲区足够，计算新的起始位置
             new_start = _map + (_map_size - new_num_nodes) / 2 + (is_front ? n : 0);
             if (new_start < _start._node) {
@@ -935,7 +1274,8 @@ protected:
      */
     void __pop_back_aux()
     {
-        // 先移动到上一个缓冲区
+        // 先归还空出来的缓冲区，再移动到上一个缓冲区
+        __release_node(_finish._first);
         _finish.set_node(_finish._node - 1);
         _finish._cur = _finish._last - 1;
         allocator.destroy(_finish._cur);
@@ -946,8 +1286,9 @@ protected:
      */
     void __pop_front_aux()
     {
-        // 先销毁元素再跳转
+        // 先销毁元素并归还缓冲区，再跳转
         allocator.destroy(_start._cur);
+        __release_node(_start._first);
         _start.set_node(_start._node + 1);
         _start._cur = _start._first;
     }
@@ -955,48 +1296,72 @@ protected:
 
 // 非成员函数
 
-template <class T, class Alloc>
-bool operator==(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+bool operator==(const deque<T, Alloc, BufferPolicy> & lhs, const deque<T, Alloc, BufferPolicy> & rhs)
 {
     return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Alloc>
-bool operator!=(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+bool operator!=(const deque<T, Alloc, BufferPolicy> & lhs, const deque<T, Alloc, BufferPolicy> & rhs)
 {
     return !(lhs == rhs);
 }
 
-template <class T, class Alloc>
-bool operator<(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+bool operator<(const deque<T, Alloc, BufferPolicy> & lhs, const deque<T, Alloc, BufferPolicy> & rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Alloc>
-bool operator>(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+bool operator>(const deque<T, Alloc, BufferPolicy> & lhs, const deque<T, Alloc, BufferPolicy> & rhs)
 {
     return rhs < lhs;
 }
 
-template <class T, class Alloc>
-bool operator<=(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+bool operator<=(const deque<T, Alloc, BufferPolicy> & lhs, const deque<T, Alloc, BufferPolicy> & rhs)
 {
     return !(rhs < lhs);
 }
 
-template <class T, class Alloc>
-bool operator>=(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+bool operator>=(const deque<T, Alloc, BufferPolicy> & lhs, const deque<T, Alloc, BufferPolicy> & rhs)
 {
     return !(lhs < rhs);
 }
 
-template <class T, class Alloc>
-void swap(deque<T, Alloc> & lhs, deque<T, Alloc> & rhs)
+template <class T, class Alloc, class BufferPolicy>
+void swap(deque<T, Alloc, BufferPolicy> & lhs, deque<T, Alloc, BufferPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief 删除所有满足pred的元素
+ * @details 一次遍历把保留的元素依次移到前面，最后一次性销毁尾部并释放空出的缓冲区，复杂度O(n)
+ * @return 删除的元素个数
+ */
+template <class T, class Alloc, class BufferPolicy, class Pred>
+typename deque<T, Alloc, BufferPolicy>::size_type erase_if(deque<T, Alloc, BufferPolicy> & c, Pred pred)
+{
+    auto it = std::remove_if(c.begin(), c.end(), pred);
+    auto count = c.end() - it;
+    c.erase(it, c.end());
+    return count;
+}
+
+/**
+ * @brief 删除所有等于value的元素
+ * @return 删除的元素个数
+ */
+template <class T, class Alloc, class BufferPolicy, class U>
+typename deque<T, Alloc, BufferPolicy>::size_type erase(deque<T, Alloc, BufferPolicy> & c, const U & value)
+{
+    return stl::erase_if(c, [&](const T & element) { return element == value; });
+}
+
 } // namespace stl
 
 #endif
\ No newline at end of file
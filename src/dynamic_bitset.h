@@ -0,0 +1,453 @@
+#ifndef __DYNAMIC_BITSET_H__
+#define __DYNAMIC_BITSET_H__
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "memory.h"
+#include "bit.h"
+
+namespace stl
+{
+
+/**
+ * @brief 运行时确定大小的位集合
+ * @details 位按64位字存储，与、或、异或和差集逐字进行，计数按CPU选择POPCNT或AVX2内核，
+ *          查找用TZCNT跳过全0的字，区间赋值对中间的整字直接memset。
+ *          两个位集合之间的运算要求大小相同，否则抛出std::invalid_argument
+ */
+template <class Alloc = stl::allocator<stl::__bit_word>>
+class dynamic_bitset
+{
+public:
+    using word_type = stl::__bit_word;
+    using size_type = std::size_t;
+    using allocator_type = typename Alloc::template rebind<word_type>::other;
+    using reference = stl::__bit_reference;
+    using const_reference = bool;
+
+    static constexpr size_type bits_per_word = stl::__bits_per_word;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+protected:
+    word_type * _words;         // 字数组，最后一个字中超出_size的位始终为0
+    size_type _size;            // 位数
+    allocator_type allocator;   // 字分配器
+
+public:
+    // 构造函数
+
+    dynamic_bitset() noexcept
+        : _words(nullptr), _size(0)
+    {}
+
+    explicit dynamic_bitset(size_type count, bool value = false, const allocator_type & alloc = allocator_type())
+        : _words(nullptr), _size(0), allocator(alloc)
+    {
+        resize(count, value);
+    }
+
+    dynamic_bitset(const dynamic_bitset & other)
+        : _words(nullptr), _size(0), allocator(other.allocator)
+    {
+        _words = _allocate(other.num_words());
+        if (other.num_words() != 0) {
+            std::memcpy(static_cast<void *>(_words), static_cast<const void *>(other._words), other.num_words() * sizeof(word_type));
+        }
+        _size = other._size;
+    }
+
+    dynamic_bitset(dynamic_bitset && other) noexcept
+        : _words(other._words), _size(other._size), allocator(other.allocator)
+    {
+        other._words = nullptr;
+        other._size = 0;
+    }
+
+    ~dynamic_bitset()
+    {
+        _deallocate(_words, num_words());
+    }
+
+    dynamic_bitset & operator=(const dynamic_bitset & other)
+    {
+        if (this != &other) {
+            dynamic_bitset temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    dynamic_bitset & operator=(dynamic_bitset && other) noexcept
+    {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+public:
+    // 元素访问
+
+    bool test(size_type pos) const
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("dynamic_bitset out of range");
+        }
+        return (*this)[pos];
+    }
+
+    reference operator[](size_type pos)
+    {
+        return reference(_words + pos / bits_per_word, stl::__bit_mask(pos));
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return (_words[pos / bits_per_word] & stl::__bit_mask(pos)) != 0;
+    }
+
+    /**
+     * @brief 底层的字数组，第i位位于第i / 64个字的第i % 64位
+     */
+    word_type * data() noexcept
+    {
+        return _words;
+    }
+
+    const word_type * data() const noexcept
+    {
+        return _words;
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * @brief 字数组的长度
+     */
+    size_type num_words() const noexcept
+    {
+        return stl::__bit_words(_size);
+    }
+
+    /**
+     * @brief 修改位数，新增的位设置为value
+     */
+    void resize(size_type count, bool value = false)
+    {
+        size_type old_words = num_words();
+        size_type new_words = stl::__bit_words(count);
+        if (new_words != old_words) {
+            word_type * words = _allocate(new_words);
+            size_type kept = old_words < new_words ? old_words : new_words;
+            if (kept != 0) {
+                std::memcpy(static_cast<void *>(words), static_cast<const void *>(_words), kept * sizeof(word_type));
+            }
+            if (new_words > kept) {
+                std::memset(static_cast<void *>(words + kept), 0, (new_words - kept) * sizeof(word_type));
+            }
+            _deallocate(_words, old_words);
+            _words = words;
+        }
+        if (count > _size) {
+            size_type old_size = _size;
+            _size = count;
+            if (value) {
+                stl::__fill_bits(_words, old_size, count, true);
+            }
+        } else {
+            _size = count;
+            if (_words != nullptr) {
+                stl::__clear_tail_bits(_words, _size);
+            }
+        }
+    }
+
+    // 修改器
+
+    dynamic_bitset & set(size_type pos, bool value = true)
+    {
+        (*this)[pos] = value;
+        return *this;
+    }
+
+    dynamic_bitset & reset(size_type pos)
+    {
+        _words[pos / bits_per_word] &= ~stl::__bit_mask(pos);
+        return *this;
+    }
+
+    dynamic_bitset & flip(size_type pos)
+    {
+        _words[pos / bits_per_word] ^= stl::__bit_mask(pos);
+        return *this;
+    }
+
+    /**
+     * @brief 设置所有位
+     */
+    dynamic_bitset & set() noexcept
+    {
+        return set_range(0, _size, true);
+    }
+
+    /**
+     * @brief 清除所有位
+     */
+    dynamic_bitset & reset() noexcept
+    {
+        if (_words != nullptr) {
+            std::memset(static_cast<void *>(_words), 0, num_words() * sizeof(word_type));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 翻转所有位
+     */
+    dynamic_bitset & flip() noexcept
+    {
+        size_type words = num_words();
+        for (size_type i = 0; i < words; ++i) {
+            _words[i] = ~_words[i];
+        }
+        _clear_tail();
+        return *this;
+    }
+
+    /**
+     * @brief 把[first, last)的位设置为value
+     * @details 首尾不完整的字用掩码修改，中间的整字直接memset
+     */
+    dynamic_bitset & set_range(size_type first, size_type last, bool value = true) noexcept
+    {
+        stl::__fill_bits(_words, first, last, value);
+        return *this;
+    }
+
+    /**
+     * @brief 清除[first, last)的位
+     */
+    dynamic_bitset & reset_range(size_type first, size_type last) noexcept
+    {
+        stl::__fill_bits(_words, first, last, false);
+        return *this;
+    }
+
+    // 位运算
+
+    dynamic_bitset & operator&=(const dynamic_bitset & other)
+    {
+        _check_size(other);
+        size_type words = num_words();
+        for (size_type i = 0; i < words; ++i) {
+            _words[i] &= other._words[i];
+        }
+        return *this;
+    }
+
+    dynamic_bitset & operator|=(const dynamic_bitset & other)
+    {
+        _check_size(other);
+        size_type words = num_words();
+        for (size_type i = 0; i < words; ++i) {
+            _words[i] |= other._words[i];
+        }
+        return *this;
+    }
+
+    dynamic_bitset & operator^=(const dynamic_bitset & other)
+    {
+        _check_size(other);
+        size_type words = num_words();
+        for (size_type i = 0; i < words; ++i) {
+            _words[i] ^= other._words[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 差集，清除other中为1的位(andnot)
+     */
+    dynamic_bitset & operator-=(const dynamic_bitset & other)
+    {
+        _check_size(other);
+        size_type words = num_words();
+        for (size_type i = 0; i < words; ++i) {
+            _words[i] &= ~other._words[i];
+        }
+        return *this;
+    }
+
+    dynamic_bitset operator~() const
+    {
+        dynamic_bitset result(*this);
+        result.flip();
+        return result;
+    }
+
+    // 查询
+
+    /**
+     * @brief 为1的位数
+     */
+    size_type count() const noexcept
+    {
+        return stl::__count_bits(_words, num_words());
+    }
+
+    bool any() const noexcept
+    {
+        size_type words = num_words();
+        for (size_type i = 0; i < words; ++i) {
+            if (_words[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool none() const noexcept
+    {
+        return !any();
+    }
+
+    bool all() const noexcept
+    {
+        size_type full = _size / bits_per_word;
+        for (size_type i = 0; i < full; ++i) {
+            if (_words[i] != ~static_cast<word_type>(0)) {
+                return false;
+            }
+        }
+        return _size % bits_per_word == 0 || _words[full] == stl::__bit_mask(_size) - 1;
+    }
+
+    /**
+     * @brief 第一个为1的位，不存在时返回npos
+     */
+    size_type find_first() const noexcept
+    {
+        return _found(stl::__find_next_bit(_words, _size, 0));
+    }
+
+    /**
+     * @brief pos之后第一个为1的位，不存在时返回npos
+     */
+    size_type find_next(size_type pos) const noexcept
+    {
+        if (pos + 1 >= _size) {
+            return npos;
+        }
+        return _found(stl::__find_next_bit(_words, _size, pos + 1));
+    }
+
+    void swap(dynamic_bitset & other) noexcept
+    {
+        std::swap(_words, other._words);
+        std::swap(_size, other._size);
+        std::swap(allocator, other.allocator);
+    }
+
+protected:
+    // 内部函数
+
+    word_type * _allocate(size_type words)
+    {
+        return words == 0 ? nullptr : allocator.allocate(words);
+    }
+
+    void _deallocate(word_type * words, size_type count) noexcept
+    {
+        if (words != nullptr) {
+            allocator.deallocate(words, count);
+        }
+    }
+
+    void _clear_tail() noexcept
+    {
+        if (_words != nullptr) {
+            stl::__clear_tail_bits(_words, _size);
+        }
+    }
+
+    void _check_size(const dynamic_bitset & other) const
+    {
+        if (_size != other._size) {
+            throw std::invalid_argument("dynamic_bitset size mismatch");
+        }
+    }
+
+    size_type _found(size_type pos) const noexcept
+    {
+        return pos == _size ? npos : pos;
+    }
+};
+
+// 非成员函数
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator&(const dynamic_bitset<Alloc> & lhs, const dynamic_bitset<Alloc> & rhs)
+{
+    dynamic_bitset<Alloc> result(lhs);
+    result &= rhs;
+    return result;
+}
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator|(const dynamic_bitset<Alloc> & lhs, const dynamic_bitset<Alloc> & rhs)
+{
+    dynamic_bitset<Alloc> result(lhs);
+    result |= rhs;
+    return result;
+}
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator^(const dynamic_bitset<Alloc> & lhs, const dynamic_bitset<Alloc> & rhs)
+{
+    dynamic_bitset<Alloc> result(lhs);
+    result ^= rhs;
+    return result;
+}
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator-(const dynamic_bitset<Alloc> & lhs, const dynamic_bitset<Alloc> & rhs)
+{
+    dynamic_bitset<Alloc> result(lhs);
+    result -= rhs;
+    return result;
+}
+
+template <class Alloc>
+bool operator==(const dynamic_bitset<Alloc> & lhs, const dynamic_bitset<Alloc> & rhs)
+{
+    return lhs.size() == rhs.size()
+        && (lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.num_words() * sizeof(stl::__bit_word)) == 0);
+}
+
+template <class Alloc>
+bool operator!=(const dynamic_bitset<Alloc> & lhs, const dynamic_bitset<Alloc> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class Alloc>
+void swap(dynamic_bitset<Alloc> & lhs, dynamic_bitset<Alloc> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace stl
+
+#endif
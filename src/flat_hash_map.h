@@ -0,0 +1,491 @@
+#ifndef __FLAT_HASH_MAP_H__
+#define __FLAT_HASH_MAP_H__
+
+#include "flat_hashtable.h"
+#include "hashtable.h"
+#include "functional.h"
+
+namespace stl
+{
+
+/**
+ * @brief 开放寻址的无序映射
+ * @details 接口与unordered_map一致，元素内联存放在槽数组中，
+ *          插入和删除会使所有迭代器和引用失效
+ */
+template <
+    class Key,
+    class T,
+    class Hash = stl::hash<Key>,
+    class KeyEqual = stl::equal_to<Key>,
+    class Allocator = stl::allocator<stl::pair<const Key, T>>
+> class flat_hash_map
+{
+public:
+    // 类型定义
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = stl::pair<const key_type, mapped_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using hashtable_type = stl::flat_hashtable<key_type, value_type, hasher, key_equal, stl::keyExtractor<value_type>, allocator_type>;
+    using iterator = typename hashtable_type::iterator;
+    using const_iterator = typename hashtable_type::const_iterator;
+
+protected:
+    template <class K>
+    using _transparent_key = typename hashtable_type::template _transparent_key<K>;
+
+    hashtable_type _ht;    // 哈希表
+
+public:
+    // 构造函数
+
+    flat_hash_map()
+        : _ht(0, hasher(), key_equal())
+    {}
+
+    explicit flat_hash_map(size_type bucket_count, const hasher & hash = hasher(), const key_equal & equal = key_equal())
+        : _ht(bucket_count, hash, equal)
+    {}
+
+public:
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return _ht.begin();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return _ht.begin();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return _ht.cbegin();
+    }
+
+    iterator end() noexcept
+    {
+        return _ht.end();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _ht.end();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return _ht.cend();
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        _ht.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    stl::pair<iterator, bool> insert(const value_type & value)
+    {
+        return _ht.insert_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    stl::pair<iterator, bool> insert(value_type && value)
+    {
+        return _ht.insert_unique(std::move(value));
+    }
+
+    /**
+     * @brief 原地构造元素
+     * @details 需要先构造出元素才能得到key
+     */
+    template <class... Args>
+    stl::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return _ht.insert_unique(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键不存在时原地构造元素，键存在时什么都不做
+     */
+    template <class... Args>
+    stl::pair<iterator, bool> try_emplace(const key_type & key, Args&&... args)
+    {
+        return _ht.try_emplace_unique(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 删除指定位置的元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _ht.erase(pos);
+    }
+
+    /**
+     * @brief 删除指定范围的元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _ht.erase(first, last);
+    }
+
+    /**
+     * @brief 删除指定key的元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _ht.erase(key);
+    }
+
+    void swap(flat_hash_map & other) noexcept
+    {
+        _ht.swap(other._ht);
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _ht.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return _ht.size();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return _ht.max_size();
+    }
+
+    // 查找
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    mapped_type & at(const key_type & key)
+    {
+        iterator it = _ht.find(key);
+        if (it == _ht.end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    const mapped_type & at(const key_type & key) const
+    {
+        const_iterator it = _ht.find(key);
+        if (it == _ht.end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief 访问或插入指定的元素
+     */
+    mapped_type & operator[](const key_type & key)
+    {
+        return _ht.try_emplace_unique(key).first->second;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _ht.count(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 检查是否包含特定键的元素
+     */
+    bool contains(const key_type & key) const
+    {
+        return _ht.count(key) != 0;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    stl::pair<iterator, iterator> equal_range(const key_type & key)
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    stl::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素数量
+     * @details 哈希函数和比较函数都声明了is_transparent时可用，查找时不构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 检查是否包含与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    bool contains(const K & key) const
+    {
+        return _ht.count(key) != 0;
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 带越界检查访问与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    mapped_type & at(const K & key)
+    {
+        iterator it = _ht.find(key);
+        if (it == _ht.end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief 带越界检查访问与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    const mapped_type & at(const K & key) const
+    {
+        const_iterator it = _ht.find(key);
+        if (it == _ht.end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief 访问或插入与key等价的元素
+     * @details 只有在key不存在、需要插入时才构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    mapped_type & operator[](const K & key)
+    {
+        iterator it = _ht.find(key);
+        if (it != _ht.end()) {
+            return it->second;
+        }
+        return _ht.try_emplace_unique(key_type(key)).first->second;
+    }
+
+    // 桶接口
+
+    /**
+     * @brief 返回槽数
+     */
+    size_type bucket_count() const
+    {
+        return _ht.bucket_count();
+    }
+
+    /**
+     * @brief 返回槽的最大数量
+     */
+    size_type max_bucket_count() const
+    {
+        return _ht.max_bucket_count();
+    }
+
+    /**
+     * @brief 返回特定的槽中的元素数量
+     */
+    size_type bucket_size(size_type n) const
+    {
+        return _ht.bucket_size(n);
+    }
+
+    /**
+     * @brief 返回特定键的初始探测位置
+     */
+    size_type bucket(const key_type & key) const
+    {
+        return _ht.bucket(key);
+    }
+
+    // 散列策略
+
+    /**
+     * @brief 负载因子
+     */
+    float load_factor() const
+    {
+        return _ht.load_factor();
+    }
+
+    /**
+     * @brief 查找特定键时探测的组数
+     */
+    size_type probe_length(const key_type & key) const
+    {
+        return _ht.probe_length(key);
+    }
+
+    /**
+     * @brief 最大负载因子
+     */
+    float max_load_factor() const
+    {
+        return _ht.max_load_factor();
+    }
+
+    /**
+     * @brief 设置最大负载因子
+     */
+    void max_load_factor(float ml)
+    {
+        _ht.max_load_factor(ml);
+    }
+
+    /**
+     * @brief 预留至少指定数量的槽并重新生成散列表
+     */
+    void rehash(size_type count)
+    {
+        _ht.rehash(count);
+    }
+
+    /**
+     * @brief 为至少指定数量的元素预留空间并重新生成散列表
+     */
+    void reserve(size_type count)
+    {
+        _ht.reserve(count);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于对键求散列的函数
+     */
+    hasher hash_function() const
+    {
+        return _ht.hash_function();
+    }
+
+    /**
+     * @brief 返回用于比较键的相等性的函数
+     */
+    key_equal key_eq() const
+    {
+        return _ht.key_eq();
+    }
+};
+
+// 非成员函数
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual, Allocator> & lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual, Allocator> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief 删除所有满足pred的元素
+ * @details 一次遍历整个表，删除时直接取得下一个元素，复杂度O(n)
+ * @return 删除的元素个数
+ */
+template <class Key, class T, class Hash, class KeyEqual, class Allocator, class Pred>
+typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::size_type erase_if(flat_hash_map<Key, T, Hash, KeyEqual, Allocator> & c, Pred pred)
+{
+    typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::size_type count = 0;
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+            ++count;
+        } else {
+            ++it;
+        }
+    }
+    return count;
+}
+
+} // namespace stl
+
+#endif
@@ -0,0 +1,326 @@
+#ifndef __FLAT_HASH_SET_H__
+#define __FLAT_HASH_SET_H__
+
+#include "flat_hashtable.h"
+#include "functional.h"
+
+namespace stl
+{
+
+/**
+ * @brief 开放寻址的无序集合
+ * @details 接口与unordered_set一致，槽中只存放key本身，
+ *          插入和删除会使所有迭代器和引用失效
+ */
+template <
+    class Key,
+    class Hash = stl::hash<Key>,
+    class Equal = stl::equal_to<Key>,
+    class Allocator = stl::allocator<Key>
+> class flat_hash_set
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using hashtable_type = stl::flat_hashtable<key_type, value_type, hasher, key_equal, stl::identityExtractor<key_type>, allocator_type>;
+    // 集合中的元素不允许修改，iterator和const_iterator都是常量迭代器
+    using iterator = typename hashtable_type::const_iterator;
+    using const_iterator = typename hashtable_type::const_iterator;
+
+protected:
+    template <class K>
+    using _transparent_key = typename hashtable_type::template _transparent_key<K>;
+
+    hashtable_type _ht;     // 哈希表
+
+public:
+    flat_hash_set()
+        : _ht(0, hasher(), key_equal())
+    {}
+
+    explicit flat_hash_set(size_type bucket_count, const hasher & hash = hasher(), const key_equal & equal = key_equal())
+        : _ht(bucket_count, hash, equal)
+    {}
+
+public:
+    // 迭代器
+
+    iterator begin() const noexcept
+    {
+        return _ht.cbegin();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return _ht.cbegin();
+    }
+
+    iterator end() const noexcept
+    {
+        return _ht.cend();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return _ht.cend();
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _ht.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return _ht.size();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return _ht.max_size();
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        _ht.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    stl::pair<iterator, bool> insert(const value_type & value)
+    {
+        auto result = _ht.insert_unique(value);
+        return stl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    stl::pair<iterator, bool> insert(value_type && value)
+    {
+        auto result = _ht.insert_unique(std::move(value));
+        return stl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    /**
+     * @brief 原地构造元素
+     */
+    template <class... Args>
+    stl::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 删除指定位置的元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _ht.erase(pos);
+    }
+
+    /**
+     * @brief 删除指定范围的元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _ht.erase(first, last);
+    }
+
+    /**
+     * @brief 删除指定key的元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _ht.erase(key);
+    }
+
+    void swap(flat_hash_set & other) noexcept
+    {
+        _ht.swap(other._ht);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _ht.count(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 检查是否包含特定键的元素
+     */
+    bool contains(const key_type & key) const
+    {
+        return _ht.count(key) != 0;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    stl::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素数量
+     * @details 哈希函数和比较函数都声明了is_transparent时可用，查找时不构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 检查是否包含与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    bool contains(const K & key) const
+    {
+        return _ht.count(key) != 0;
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
+    // 桶接口
+
+    size_type bucket_count() const
+    {
+        return _ht.bucket_count();
+    }
+
+    size_type max_bucket_count() const
+    {
+        return _ht.max_bucket_count();
+    }
+
+    size_type bucket_size(size_type n) const
+    {
+        return _ht.bucket_size(n);
+    }
+
+    size_type bucket(const key_type & key) const
+    {
+        return _ht.bucket(key);
+    }
+
+    // 散列策略
+
+    float load_factor() const
+    {
+        return _ht.load_factor();
+    }
+
+    size_type probe_length(const key_type & key) const
+    {
+        return _ht.probe_length(key);
+    }
+
+    float max_load_factor() const
+    {
+        return _ht.max_load_factor();
+    }
+
+    void max_load_factor(float ml)
+    {
+        _ht.max_load_factor(ml);
+    }
+
+    void rehash(size_type count)
+    {
+        _ht.rehash(count);
+    }
+
+    void reserve(size_type count)
+    {
+        _ht.reserve(count);
+    }
+
+    // 观察器
+
+    hasher hash_function() const
+    {
+        return _ht.hash_function();
+    }
+
+    key_equal key_eq() const
+    {
+        return _ht.key_eq();
+    }
+};
+
+// 非成员函数
+
+template <class Key, class Hash, class Equal, class Allocator>
+void swap(flat_hash_set<Key, Hash, Equal, Allocator> & lhs,
+          flat_hash_set<Key, Hash, Equal, Allocator> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief 删除所有满足pred的元素
+ * @details 一次遍历整个表，删除时直接取得下一个元素，复杂度O(n)
+ * @return 删除的元素个数
+ */
+template <class Key, class Hash, class Equal, class Allocator, class Pred>
+typename flat_hash_set<Key, Hash, Equal, Allocator>::size_type erase_if(flat_hash_set<Key, Hash, Equal, Allocator> & c, Pred pred)
+{
+    typename flat_hash_set<Key, Hash, Equal, Allocator>::size_type count = 0;
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+            ++count;
+        } else {
+            ++it;
+        }
+    }
+    return count;
+}
+
+} // namespace stl
+
+#endif
@@ -0,0 +1,1101 @@
+#ifndef __FLAT_HASHTABLE_H__
+#define __FLAT_HASHTABLE_H__
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "memory.h"
+#include "hash.h"
+#include "functional.h"
+#include "utility.h"
+#include "cpu.h"
+
+namespace stl
+{
+
+/**
+ * @brief 直接返回元素本身作为key
+ * @details 用于set类容器，元素本身就是key
+ */
+template <class T>
+class identityExtractor
+{
+public:
+    const T & operator()(const T & value) const
+    {
+        return value;
+    }
+};
+
+/**
+ * @brief 控制字节组的探测内核
+ * @details 探测时一次比较一组控制字节，组的宽度由内核决定，
+ *          槽的布局与内核无关，所以可以在运行时切换内核
+ */
+enum class flat_group_kernel
+{
+    portable,   // 可移植实现，8字节，使用64位整数的位运算(SWAR)
+    sse2,       // 16字节，SSE2
+    avx2        // 32字节，AVX2
+};
+
+/**
+ * @brief 可移植的组探测内核
+ * @details 把8个控制字节读入一个64位整数，用位运算同时比较，
+ *          第i个控制字节的结果位于掩码的第8i+7位
+ */
+class __flat_group_portable
+{
+public:
+    using mask_type = std::uint64_t;
+
+    static constexpr std::size_t width = 8;
+    static constexpr int shift = 3;
+
+public:
+    /**
+     * @brief 返回tag相同的控制字节
+     * @details 可能出现假阳性，但只会出现在满槽上，调用方总会再比较key
+     */
+    static mask_type match(const signed char * ctrl, signed char tag)
+    {
+        mask_type x = _load(ctrl) ^ (lsbs * static_cast<unsigned char>(tag));
+        return (x - lsbs) & ~x & msbs;
+    }
+
+    /**
+     * @brief 返回为空的控制字节
+     * @details 空为0x80，已删除为0xFE，只有空的第1位为0
+     */
+    static mask_type match_empty(const signed char * ctrl)
+    {
+        mask_type x = _load(ctrl);
+        return x & ~(x << 6) & msbs;
+    }
+
+    /**
+     * @brief 返回为空或已删除的控制字节，即最高位为1的控制字节
+     */
+    static mask_type match_empty_or_deleted(const signed char * ctrl)
+    {
+        return _load(ctrl) & msbs;
+    }
+
+protected:
+    static constexpr mask_type lsbs = 0x0101010101010101ull;
+    static constexpr mask_type msbs = 0x8080808080808080ull;
+
+    static mask_type _load(const signed char * ctrl)
+    {
+        mask_type x;
+        std::memcpy(&x, ctrl, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        x = __builtin_bswap64(x);   // 保证第i个字节位于低位起的第i个字节
+#endif
+        return x;
+    }
+};
+
+#if _STL_X86
+
+/**
+ * @brief SSE2组探测内核
+ * @details 一次比较16个控制字节
+ */
+class __flat_group_sse2
+{
+public:
+    using mask_type = std::uint32_t;
+
+    static constexpr std::size_t width = 16;
+    static constexpr int shift = 0;
+
+public:
+    _STL_TARGET_SSE2 static mask_type match(const signed char * ctrl, signed char tag)
+    {
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+        return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), group)));
+    }
+
+    _STL_TARGET_SSE2 static mask_type match_empty(const signed char * ctrl)
+    {
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+        return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(-128), group)));
+    }
+
+    _STL_TARGET_SSE2 static mask_type match_empty_or_deleted(const signed char * ctrl)
+    {
+        // 空和已删除的最高位为1，直接取每个字节的最高位
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+        return static_cast<mask_type>(_mm_movemask_epi8(group));
+    }
+};
+
+/**
+ * @brief AVX2组探测内核
+ * @details 一次比较32个控制字节
+ */
+class __flat_group_avx2
+{
+public:
+    using mask_type = std::uint32_t;
+
+    static constexpr std::size_t width = 32;
+    static constexpr int shift = 0;
+
+public:
+    _STL_TARGET_AVX2 static mask_type match(const signed char * ctrl, signed char tag)
+    {
+        __m256i group = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ctrl));
+        return static_cast<mask_type>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(tag), group)));
+    }
+
+    _STL_TARGET_AVX2 static mask_type match_empty(const signed char * ctrl)
+    {
+        __m256i group = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ctrl));
+        return static_cast<mask_type>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(-128), group)));
+    }
+
+    _STL_TARGET_AVX2 static mask_type match_empty_or_deleted(const signed char * ctrl)
+    {
+        __m256i group = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ctrl));
+        return static_cast<mask_type>(_mm256_movemask_epi8(group));
+    }
+};
+
+#endif // _STL_X86
+
+/**
+ * @brief 当前使用的组探测内核
+ * @details 首次使用时按CPU支持的指令集选择最宽的内核
+ */
+inline flat_group_kernel & __flat_group_kernel_ref()
+{
+    static flat_group_kernel kernel = cpu_has_avx2() ? flat_group_kernel::avx2
+                                    : cpu_has_sse2() ? flat_group_kernel::sse2
+                                    : flat_group_kernel::portable;
+    return kernel;
+}
+
+/**
+ * @brief 返回当前使用的组探测内核
+ */
+inline flat_group_kernel flat_hash_group_kernel()
+{
+    return __flat_group_kernel_ref();
+}
+
+/**
+ * @brief 切换组探测内核
+ * @return CPU不支持该内核时返回false，保持原内核不变
+ * @details 不是线程安全的，应在使用哈希表之前调用，主要用于测试和基准测试
+ */
+inline bool set_flat_hash_group_kernel(flat_group_kernel kernel)
+{
+    if ((kernel == flat_group_kernel::avx2 && !cpu_has_avx2()) ||
+        (kernel == flat_group_kernel::sse2 && !cpu_has_sse2())) {
+        return false;
+    }
+    __flat_group_kernel_ref() = kernel;
+    return true;
+}
+
+/**
+ * @brief 开放寻址哈希表
+ * @details 元素直接存放在连续的槽数组中，不再为每个元素单独申请节点。
+ *          每个槽对应一个控制字节，记录槽为空、已删除，或者保存哈希值的低7位(tag)，
+ *          查找时用SIMD一次比较一组控制字节，只有tag相同才调用比较函数，命中时通常只访问一条缓存行。
+ *          控制字节数组末尾镜像了前max_group_width个控制字节，使从任意槽开始的组都能连续读取
+ * @tparam Value 槽中存放的元素类型，map为pair<const Key, T>，set为Key
+ */
+template <
+    class Key,
+    class Value,
+    class Hash,
+    class Equal,
+    class ExtractKey,
+    class Allocator
+>
+class flat_hashtable
+{
+public:
+    using ctrl_type = signed char;
+
+    static constexpr ctrl_type ctrl_empty = -128;   // 0b10000000，空槽
+    static constexpr ctrl_type ctrl_deleted = -2;   // 0b11111110，已删除的槽
+    // 满槽的控制字节为0b0xxxxxxx，即哈希值的低7位
+
+public:
+    /**
+     * @brief 开放寻址哈希表迭代器
+     * @tparam IsConst 是否为常量迭代器
+     */
+    template <bool IsConst>
+    class __flat_hashtable_iterator
+    {
+    public:
+        using value_type = Value;
+        using reference = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+        using pointer = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        using self = __flat_hashtable_iterator;
+        using table_pointer = typename std::conditional<IsConst, const flat_hashtable*, flat_hashtable*>::type;
+
+    public:
+        size_type _index;               // 当前槽的索引
+        table_pointer _hashtable;       // 指向所在的哈希表
+
+    public:
+        __flat_hashtable_iterator()
+            : _index(0), _hashtable(nullptr)
+        {}
+
+        __flat_hashtable_iterator(size_type index, table_pointer hst)
+            : _index(index), _hashtable(hst)
+        {}
+
+        // 非常量迭代器可以转换为常量迭代器
+        template <bool OtherConst, class = typename std::enable_if<IsConst && !OtherConst>::type>
+        __flat_hashtable_iterator(const __flat_hashtable_iterator<OtherConst> & other)
+            : _index(other._index), _hashtable(other._hashtable)
+        {}
+
+    public:
+        reference operator*() const
+        {
+            return _hashtable->_slots[_index];
+        }
+
+        pointer operator->() const
+        {
+            return &(operator*());
+        }
+
+        self & operator++()
+        {
+            _index = _hashtable->_next_full(_index + 1);
+            return *this;
+        }
+
+        self operator++(int)
+        {
+            self tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        template <bool OtherConst>
+        bool operator==(const __flat_hashtable_iterator<OtherConst> & other) const
+        {
+            return _index == other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator!=(const __flat_hashtable_iterator<OtherConst> & other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+    using extract_key = ExtractKey;
+    using allocator_type = Allocator;
+    using iterator = __flat_hashtable_iterator<false>;
+    using const_iterator = __flat_hashtable_iterator<true>;
+    using Slot_Alloc = typename Allocator::template rebind<value_type>::other;
+    using Ctrl_Alloc = typename Allocator::template rebind<ctrl_type>::other;
+
+    // 哈希函数和比较函数都声明了is_transparent时，查找接口接受任意可比较的key
+    template <class K>
+    using _transparent_key = typename std::enable_if<
+        stl::__is_transparent<hasher>::value && stl::__is_transparent<key_equal>::value, K>::type;
+
+protected:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type min_capacity = 16;
+    static constexpr size_type max_group_width = 32;    // 所有内核中最宽的组
+
+protected:
+    ctrl_type * _ctrl;                  // 控制字节数组
+    value_type * _slots;                // 槽数组
+    size_type _capacity;                // 槽的数量，总是0或者2的幂
+    size_type _size;                    // 元素个数
+    size_type _deleted;                 // 已删除的槽的个数
+    Slot_Alloc _slot_allocator;         // 槽分配器
+    Ctrl_Alloc _ctrl_allocator;         // 控制字节分配器
+    hasher _hash;                       // 哈希函数
+    key_equal _equal;                   // 比较函数
+    extract_key _extract_key;           // 提取key的函数
+    float _max_load_factor;             // 最大负载因子
+
+public:
+    flat_hashtable(size_type n, const hasher & hash, const key_equal & equal)
+        : _ctrl(nullptr), _slots(nullptr), _capacity(0), _size(0), _deleted(0),
+          _hash(hash), _equal(equal), _extract_key(extract_key()), _max_load_factor(0.875f)
+    {
+        if (n > 0) {
+            _initialize_slots(_normalize_capacity(n));
+        }
+    }
+
+    flat_hashtable(const flat_hashtable & other)
+        : _ctrl(nullptr), _slots(nullptr), _capacity(0), _size(0), _deleted(0),
+          _hash(other._hash), _equal(other._equal), _extract_key(other._extract_key), _max_load_factor(other._max_load_factor)
+    {
+        if (other._capacity == 0) {
+            return;
+        }
+        // 容量相同，直接按槽拷贝，不需要重新探测
+        _initialize_slots(other._capacity);
+        size_type i = 0;
+        try {
+            for (; i < _capacity; ++i) {
+                if (_is_full(other._ctrl[i])) {
+                    _slot_allocator.construct(_slots + i, other._slots[i]);
+                }
+            }
+        } catch (...) {
+            // 析构函数不会执行，销毁已经拷贝的元素并归还槽数组
+            for (size_type j = 0; j < i; ++j) {
+                if (_is_full(other._ctrl[j])) {
+                    _slot_allocator.destroy(_slots + j);
+                }
+            }
+            _deallocate_slots(_ctrl, _slots, _capacity);
+            throw;
+        }
+        std::memcpy(_ctrl, other._ctrl, _ctrl_bytes(_capacity));
+        _size = other._size;
+        _deleted = other._deleted;
+    }
+
+    flat_hashtable(flat_hashtable && other)
+        : _ctrl(other._ctrl), _slots(other._slots), _capacity(other._capacity), _size(other._size), _deleted(other._deleted),
+          _hash(std::move(other._hash)), _equal(std::move(other._equal)), _extract_key(other._extract_key), _max_load_factor(other._max_load_factor)
+    {
+        other._ctrl = nullptr;
+        other._slots = nullptr;
+        other._capacity = 0;
+        other._size = 0;
+        other._deleted = 0;
+    }
+
+    flat_hashtable & operator=(const flat_hashtable & other)
+    {
+        if (this != &other) {
+            flat_hashtable tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    flat_hashtable & operator=(flat_hashtable && other)
+    {
+        if (this != &other) {
+            flat_hashtable tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~flat_hashtable()
+    {
+        _destroy_slots();
+        _deallocate_slots(_ctrl, _slots, _capacity);
+    }
+
+public:
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return iterator(_next_full(0), this);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_next_full(0), this);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(_capacity, this);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(_capacity, this);
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 按key查找，不存在时用args原地构造元素
+     * @details 元素只在确实需要插入时才构造，operator[]和insert都以此实现
+     */
+    template <class... Args>
+    stl::pair<iterator, bool> emplace_unique_with_key(const key_type & key, Args&&... args)
+    {
+        size_type hash = _hash_of(key);
+        size_type index = _find_index(key, hash);
+        if (index != npos) {
+            return stl::pair<iterator, bool>(iterator(index, this), false);
+        }
+        _reserve_for_insert();      // 判断是否需要重建哈希表，之后再寻找插入点
+        index = _find_insert_slot(hash);
+        _construct_slot(index, hash, std::forward<Args>(args)...);
+        return stl::pair<iterator, bool>(iterator(index, this), true);
+    }
+
+    /**
+     * @brief 按key查找，不存在时用key和args构造的值插入
+     * @details 值只在确实需要插入时才构造，键存在时不会移动args
+     */
+    template <class... Args>
+    stl::pair<iterator, bool> try_emplace_unique(const key_type & key, Args&&... args)
+    {
+        using mapped_type = typename value_type::second_type;
+        size_type hash = _hash_of(key);
+        size_type index = _find_index(key, hash);
+        if (index != npos) {
+            return stl::pair<iterator, bool>(iterator(index, this), false);
+        }
+        _reserve_for_insert();
+        index = _find_insert_slot(hash);
+        _construct_slot(index, hash, key, mapped_type(std::forward<Args>(args)...));
+        return stl::pair<iterator, bool>(iterator(index, this), true);
+    }
+
+    /**
+     * @brief 不允许重复的插入
+     */
+    stl::pair<iterator, bool> insert_unique(const value_type & value)
+    {
+        return emplace_unique_with_key(_extract_key(value), value);
+    }
+
+    /**
+     * @brief 不允许重复的插入
+     */
+    stl::pair<iterator, bool> insert_unique(value_type && value)
+    {
+        return emplace_unique_with_key(_extract_key(value), std::move(value));
+    }
+
+    /**
+     * @brief 清空哈希表
+     * @details 不归还槽数组
+     */
+    void clear()
+    {
+        _destroy_slots();
+        if (_capacity != 0) {
+            std::memset(_ctrl, static_cast<unsigned char>(ctrl_empty), _ctrl_bytes(_capacity));
+        }
+        _size = 0;
+        _deleted = 0;
+    }
+
+    /**
+     * @brief 删除元素
+     * @return 指向下一个元素的迭代器
+     */
+    iterator erase(const_iterator pos)
+    {
+        size_type index = pos._index;
+        _erase_slot(index);
+        return iterator(_next_full(index + 1), this);
+    }
+
+    /**
+     * @brief 删除指定范围的元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last._index, this);
+    }
+
+    /**
+     * @brief 删除指定key的元素
+     */
+    size_type erase(const key_type & key)
+    {
+        size_type index = _find_index(key, _hash_of(key));
+        if (index == npos) {
+            return 0;
+        }
+        _erase_slot(index);
+        return 1;
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_hashtable & other)
+    {
+        std::swap(_ctrl, other._ctrl);
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+        std::swap(_size, other._size);
+        std::swap(_deleted, other._deleted);
+        std::swap(_slot_allocator, other._slot_allocator);
+        std::swap(_ctrl_allocator, other._ctrl_allocator);
+        std::swap(_hash, other._hash);
+        std::swap(_equal, other._equal);
+        std::swap(_extract_key, other._extract_key);
+        std::swap(_max_load_factor, other._max_load_factor);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _find_index(key, _hash_of(key)) == npos ? 0 : 1;
+    }
+
+    iterator find(const key_type & key)
+    {
+        size_type index = _find_index(key, _hash_of(key));
+        return index == npos ? end() : iterator(index, this);
+    }
+
+    const_iterator find(const key_type & key) const
+    {
+        size_type index = _find_index(key, _hash_of(key));
+        return index == npos ? end() : const_iterator(index, this);
+    }
+
+    stl::pair<iterator, iterator> equal_range(const key_type & key)
+    {
+        iterator first = find(key);
+        iterator last = first;
+        if (last != end()) {
+            ++last;
+        }
+        return stl::pair<iterator, iterator>(first, last);
+    }
+
+    stl::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        const_iterator first = find(key);
+        const_iterator last = first;
+        if (last != end()) {
+            ++last;
+        }
+        return stl::pair<const_iterator, const_iterator>(first, last);
+    }
+
+    /**
+     * @brief 返回与key等价的元素数量
+     * @details 哈希函数和比较函数都透明时可用，不需要构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K & key) const
+    {
+        return _find_index(key, _hash_of(key)) == npos ? 0 : 1;
+    }
+
+    template <class K, class = _transparent_key<K>>
+    iterator find(const K & key)
+    {
+        size_type index = _find_index(key, _hash_of(key));
+        return index == npos ? end() : iterator(index, this);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K & key) const
+    {
+        size_type index = _find_index(key, _hash_of(key));
+        return index == npos ? end() : const_iterator(index, this);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    stl::pair<iterator, iterator> equal_range(const K & key)
+    {
+        iterator first = find(key);
+        iterator last = first;
+        if (last != end()) {
+            ++last;
+        }
+        return stl::pair<iterator, iterator>(first, last);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        const_iterator first = find(key);
+        const_iterator last = first;
+        if (last != end()) {
+            ++last;
+        }
+        return stl::pair<const_iterator, const_iterator>(first, last);
+    }
+
+    // 桶接口，开放寻址中一个槽就是一个桶
+
+    size_type bucket_count() const
+    {
+        return _capacity;
+    }
+
+    size_type max_bucket_count() const
+    {
+        return max_size();
+    }
+
+    /**
+     * @brief 返回索引为n的槽的元素个数，只可能是0或1
+     */
+    size_type bucket_size(size_type n) const
+    {
+        return _is_full(_ctrl[n]) ? 1 : 0;
+    }
+
+    /**
+     * @brief 返回key的初始探测位置
+     */
+    size_type bucket(const key_type & key) const
+    {
+        return _capacity == 0 ? 0 : _h1(_hash_of(key)) & (_capacity - 1);
+    }
+
+    // 散列策略
+
+    float load_factor() const
+    {
+        return _capacity == 0 ? 0.0f : static_cast<float>(_size) / static_cast<float>(_capacity);
+    }
+
+    /**
+     * @brief 返回查找key时探测的组数
+     * @details 用于观察负载因子对探测长度的影响，组的宽度取决于当前的内核
+     */
+    size_type probe_length(const key_type & key) const
+    {
+        size_type probes = 0;
+        _find_index(key, _hash_of(key), probes);
+        return probes;
+    }
+
+    float max_load_factor() const
+    {
+        return _max_load_factor;
+    }
+
+    /**
+     * @brief 设置最大加载因子
+     * @details 开放寻址必须保留空槽来终止探测，所以最大加载因子被限制在(0, 1)之间
+     */
+    void max_load_factor(float ml)
+    {
+        if (!(ml > 0.0f && ml < 1.0f)) {
+            throw std::invalid_argument("max_load_factor must be in (0, 1)");
+        }
+        _max_load_factor = ml;
+    }
+
+    /**
+     * @brief 预留至少n个槽并重新生成散列表
+     * @details 槽数不会小于当前元素在最大负载因子下所需的槽数
+     */
+    void rehash(size_type n)
+    {
+        size_type need = static_cast<size_type>(std::ceil(_size / max_load_factor()));
+        n = n < need ? need : n;
+        if (n == 0) {
+            // 没有元素也不需要槽，释放所有空间
+            _deallocate_slots(_ctrl, _slots, _capacity);
+            _ctrl = nullptr;
+            _slots = nullptr;
+            _capacity = 0;
+            _deleted = 0;
+            return;
+        }
+        _rehash_to(_normalize_capacity(n));
+    }
+
+    /**
+     * @brief 为至少count个元素预留空间并重新生成散列表
+     */
+    void reserve(size_type count)
+    {
+        size_type n = static_cast<size_type>(std::ceil(count / max_load_factor()));
+        if (n > _capacity) {
+            rehash(n);
+        }
+    }
+
+    // 观察器
+
+    hasher hash_function() const
+    {
+        return _hash;
+    }
+
+    key_equal key_eq() const
+    {
+        return _equal;
+    }
+
+protected:
+    // 内部函数
+
+    static bool _is_full(ctrl_type c)
+    {
+        return c >= 0;
+    }
+
+    /**
+     * @brief 计算key的哈希值
+     * @details 对用户哈希值再做一次乘法混合，避免恒等哈希(如整数)在低位和高位上分布不均，
+     *          已经充分混合的哈希函数直接使用其结果
+     */
+    template <class K>
+    size_type _hash_of(const K & key) const
+    {
+        if (stl::hash_is_avalanching<hasher>::value) {
+            return static_cast<size_type>(_hash(key));
+        }
+        std::uint64_t h = static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_type>(h ^ (h >> 32));
+    }
+
+    /**
+     * @brief 哈希值的高位，用于确定初始探测位置
+     */
+    static size_type _h1(size_type hash)
+    {
+        return hash >> 7;
+    }
+
+    /**
+     * @brief 哈希值的低7位，保存在控制字节中
+     */
+    static ctrl_type _h2(size_type hash)
+    {
+        return static_cast<ctrl_type>(hash & 0x7f);
+    }
+
+    /**
+     * @brief 控制字节数组的大小
+     */
+    static size_type _ctrl_bytes(size_type capacity)
+    {
+        return capacity + max_group_width;
+    }
+
+    /**
+     * @brief 计算不小于n的槽数，保证为2的幂
+     */
+    static size_type _normalize_capacity(size_type n)
+    {
+        size_type capacity = min_capacity;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /**
+     * @brief 从index开始寻找下一个满槽
+     */
+    size_type _next_full(size_type index) const
+    {
+        while (index < _capacity && !_is_full(_ctrl[index])) {
+            ++index;
+        }
+        return index;
+    }
+
+    /**
+     * @brief 掩码中最低的置位对应的组内偏移
+     */
+    template <class Group>
+    static size_type _lowest(typename Group::mask_type mask)
+    {
+        return static_cast<size_type>(__builtin_ctzll(mask)) >> Group::shift;
+    }
+
+    template <class K>
+    size_type _find_index(const K & key, size_type hash) const
+    {
+        size_type probes = 0;
+        return _find_index(key, hash, probes);
+    }
+
+    /**
+     * @brief 查找key所在的槽
+     * @param probes 累加探测的组数
+     * @return 槽索引，不存在时返回npos
+     * @details 按当前内核分派
+     */
+    template <class K>
+    size_type _find_index(const K & key, size_type hash, size_type & probes) const
+    {
+        if (_capacity == 0) {
+            return npos;
+        }
+        switch (flat_hash_group_kernel()) {
+#if _STL_X86
+        case flat_group_kernel::avx2:
+            return _find_index_avx2(key, hash, probes);
+        case flat_group_kernel::sse2:
+            return _find_index_impl<__flat_group_sse2>(key, hash, probes);
+#endif
+        default:
+            return _find_index_impl<__flat_group_portable>(key, hash, probes);
+        }
+    }
+
+    /**
+     * @brief 按组线性探测查找key
+     * @details 先比较组内所有tag，再检查组内是否有空槽，有空槽说明key不存在
+     */
+    template <class Group, class K>
+    size_type _find_index_impl(const K & key, size_type hash, size_type & probes) const
+    {
+        size_type mask = _capacity - 1;
+        size_type pos = _h1(hash) & mask;
+        ctrl_type tag = _h2(hash);
+        for (size_type probed = 0; probed < _capacity; probed += Group::width) {
+            ++probes;
+            typename Group::mask_type match = Group::match(_ctrl + pos, tag);
+            while (match != 0) {
+                size_type index = (pos + _lowest<Group>(match)) & mask;
+                if (_equal(_extract_key(_slots[index]), key)) {
+                    return index;
+                }
+                match &= match - 1;
+            }
+            if (Group::match_empty(_ctrl + pos) != 0) {
+                return npos;
+            }
+            pos = (pos + Group::width) & mask;
+        }
+        return npos;
+    }
+
+    /**
+     * @brief 寻找第一个可用(空或者已删除)的槽
+     * @details 调用前需要保证存在可用的槽
+     */
+    size_type _find_insert_slot(size_type hash) const
+    {
+        switch (flat_hash_group_kernel()) {
+#if _STL_X86
+        case flat_group_kernel::avx2:
+            return _find_insert_slot_avx2(hash);
+        case flat_group_kernel::sse2:
+            return _find_insert_slot_impl<__flat_group_sse2>(hash);
+#endif
+        default:
+            return _find_insert_slot_impl<__flat_group_portable>(hash);
+        }
+    }
+
+    template <class Group>
+    size_type _find_insert_slot_impl(size_type hash) const
+    {
+        size_type mask = _capacity - 1;
+        size_type pos = _h1(hash) & mask;
+        while (true) {
+            typename Group::mask_type match = Group::match_empty_or_deleted(_ctrl + pos);
+            if (match != 0) {
+                return (pos + _lowest<Group>(match)) & mask;
+            }
+            pos = (pos + Group::width) & mask;
+        }
+    }
+
+#if _STL_X86
+    // 以AVX2编译整个探测循环，并把循环和内核全部内联进来(flatten)，
+    // 否则在未开启-mavx2时，AVX2内核会在每个组上产生一次函数调用
+
+    template <class K>
+    _STL_TARGET_AVX2 __attribute__((flatten)) size_type _find_index_avx2(const K & key, size_type hash, size_type & probes) const
+    {
+        return _find_index_impl<__flat_group_avx2>(key, hash, probes);
+    }
+
+    _STL_TARGET_AVX2 __attribute__((flatten)) size_type _find_insert_slot_avx2(size_type hash) const
+    {
+        return _find_insert_slot_impl<__flat_group_avx2>(hash);
+    }
+#endif
+
+    /**
+     * @brief 设置控制字节
+     * @details 同时更新数组末尾的镜像
+     */
+    void _set_ctrl(size_type index, ctrl_type c)
+    {
+        _ctrl[index] = c;
+        for (size_type mirror = index + _capacity; mirror < _capacity + max_group_width; mirror += _capacity) {
+            _ctrl[mirror] = c;
+        }
+    }
+
+    /**
+     * @brief 在指定槽构造元素
+     */
+    template <class... Args>
+    void _construct_slot(size_type index, size_type hash, Args&&... args)
+    {
+        _slot_allocator.construct(_slots + index, std::forward<Args>(args)...);
+        if (_ctrl[index] == ctrl_deleted) {
+            --_deleted;
+        }
+        _set_ctrl(index, _h2(hash));
+        ++_size;
+    }
+
+    /**
+     * @brief 删除指定槽的元素
+     * @details 如果下一个槽为空，说明没有探测序列经过这里，可以直接置为空，否则留下删除标记
+     */
+    void _erase_slot(size_type index)
+    {
+        _slot_allocator.destroy(_slots + index);
+        --_size;
+        if (_ctrl[(index + 1) & (_capacity - 1)] == ctrl_empty) {
+            _set_ctrl(index, ctrl_empty);
+        } else {
+            _set_ctrl(index, ctrl_deleted);
+            ++_deleted;
+        }
+    }
+
+    /**
+     * @brief 插入前判断是否需要重建哈希表
+     * @details 元素过多时扩容，删除标记过多时按原容量重建以清除删除标记
+     */
+    void _reserve_for_insert()
+    {
+        if (_capacity == 0) {
+            _rehash_to(min_capacity);
+            return;
+        }
+        size_type limit = static_cast<size_type>(_capacity * max_load_factor());
+        if (_size + 1 > limit) {
+            _rehash_to(_capacity * 2);
+        } else if (_size + _deleted + 1 > limit) {
+            _rehash_to(_capacity);
+        }
+    }
+
+    /**
+     * @brief 申请并初始化指定大小的槽数组
+     */
+    void _initialize_slots(size_type capacity)
+    {
+        _ctrl = _ctrl_allocator.allocate(_ctrl_bytes(capacity));
+        _slots = _slot_allocator.allocate(capacity);
+        _capacity = capacity;
+        std::memset(_ctrl, static_cast<unsigned char>(ctrl_empty), _ctrl_bytes(capacity));
+    }
+
+    /**
+     * @brief 销毁所有元素，不释放槽数组
+     */
+    void _destroy_slots()
+    {
+        if (std::is_trivially_destructible<value_type>::value) {
+            return;
+        }
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (_is_full(_ctrl[i])) {
+                _slot_allocator.destroy(_slots + i);
+            }
+        }
+    }
+
+    void _deallocate_slots(ctrl_type * ctrl, value_type * slots, size_type capacity)
+    {
+        if (capacity == 0) {
+            return;
+        }
+        _ctrl_allocator.deallocate(ctrl, _ctrl_bytes(capacity));
+        _slot_allocator.deallocate(slots, capacity);
+    }
+
+    /**
+     * @brief 重建为指定槽数的散列表
+     * @details 把所有元素移动到新的槽数组，同时清除删除标记
+     */
+    void _rehash_to(size_type capacity)
+    {
+        ctrl_type * old_ctrl = _ctrl;
+        value_type * old_slots = _slots;
+        size_type old_capacity = _capacity;
+
+        _initialize_slots(capacity);
+        _deleted = 0;
+        for (size_type i = 0; i < old_capacity; ++i) {
+            if (_is_full(old_ctrl[i])) {
+                size_type hash = _hash_of(_extract_key(old_slots[i]));
+                size_type index = _find_insert_slot(hash);
+                _slot_allocator.construct(_slots + index, std::move(old_slots[i]));
+                _set_ctrl(index, _h2(hash));
+                _slot_allocator.destroy(old_slots + i);
+            }
+        }
+        _deallocate_slots(old_ctrl, old_slots, old_capacity);
+    }
+};
+
+// 非成员函数
+
+template <class Key, class Value, class Hash, class KeyEqual, class ExtractKey, class Allocator>
+void swap(stl::flat_hashtable<Key, Value, Hash, KeyEqual, ExtractKey, Allocator> & lhs,
+          stl::flat_hashtable<Key, Value, Hash, KeyEqual, ExtractKey, Allocator> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace stl
+
+#endif
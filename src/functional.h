@@ -1,10 +1,13 @@
 #ifndef __FUNCTIONAL_H__
 #define __FUNCTIONAL_H__
 
+#include <type_traits>
+#include <utility>
+
 namespace stl
 {
 
-template <class T>
+template <class T = void>
 class equal_to
 {
 public:
@@ -19,6 +22,37 @@ public:
     }    
 };
 
+/**
+ * @brief 透明的相等比较
+ * @details 两个参数的类型可以不同，只要能用==比较，声明is_transparent以启用异构查找
+ */
+template <>
+class equal_to<void>
+{
+public:
+    using is_transparent = void;
+
+public:
+    template <class T, class U>
+    auto operator()(T&& x, U&& y) const -> decltype(std::forward<T>(x) == std::forward<U>(y))
+    {
+        return std::forward<T>(x) == std::forward<U>(y);
+    }
+};
+
+/**
+ * @brief 判断函数对象是否声明了is_transparent
+ */
+template <class T, class = void>
+class __is_transparent
+    : public std::false_type
+{};
+
+template <class T>
+class __is_transparent<T, typename std::conditional<true, void, typename T::is_transparent>::type>
+    : public std::true_type
+{};
+
 }
 
 #endif
\ No newline at end of file
@@ -2,6 +2,15 @@
 #define __HASH_H__
 
 #include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <cstring>
+#include <string>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#include "cpu.h"
 
 namespace stl
 {
@@ -122,6 +131,529 @@ public:
     }
 };
 
+/**
+ * @brief 64位乘法的高64位
+ */
+inline std::uint64_t __mul_high_u64(std::uint64_t a, std::uint64_t b) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+    std::uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+    std::uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+    std::uint64_t lo_lo = a_lo * b_lo;
+    std::uint64_t hi_lo = a_hi * b_lo;
+    std::uint64_t lo_hi = a_lo * b_hi;
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief murmur3的fmix64
+ * @details 每个输入位都会影响所有输出位，且是双射，不会引入额外冲突
+ */
+inline std::uint64_t fmix64(std::uint64_t x) noexcept
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief wyhash的乘法折叠
+ * @details 128位乘积的高低两半异或，比fmix64少一次乘法
+ */
+inline std::uint64_t wymix(std::uint64_t a, std::uint64_t b) noexcept
+{
+    return a * b ^ __mul_high_u64(a, b);
+}
+
+/**
+ * @brief 哈希值混合器
+ * @details 混合器把一个已经算出的哈希值再打散，使低位和高位都能均匀分布，
+ *          开放寻址和2的幂桶数的哈希表只使用哈希值的一部分位，需要混合后的哈希值。
+ *          混合器用嵌套类型is_avalanching声明结果是否充分混合，没有声明的视为没有混合
+ */
+
+/**
+ * @brief 不做任何混合
+ */
+class identity_mixer
+{
+public:
+    using is_avalanching = std::false_type;
+
+public:
+    std::size_t operator()(std::size_t h) const noexcept
+    {
+        return h;
+    }
+};
+
+/**
+ * @brief 使用fmix64混合
+ */
+class fmix64_mixer
+{
+public:
+    using is_avalanching = std::true_type;
+
+public:
+    std::size_t operator()(std::size_t h) const noexcept
+    {
+        return static_cast<std::size_t>(stl::fmix64(h));
+    }
+};
+
+/**
+ * @brief 使用wyhash风格的乘法异或混合
+ */
+class wyhash_mixer
+{
+public:
+    using is_avalanching = std::true_type;
+
+public:
+    std::size_t operator()(std::size_t h) const noexcept
+    {
+        return static_cast<std::size_t>(stl::wymix(h ^ 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL));
+    }
+};
+
+/**
+ * @brief 对齐指针的混合
+ * @details 堆上的指针通常按16字节对齐，低4位恒为0，先循环右移把这些位移到高位，
+ *          不丢失任何位，再做一次乘法异或混合
+ */
+class aligned_pointer_mixer
+{
+public:
+    using is_avalanching = std::true_type;
+
+    static constexpr unsigned shift = 4;
+
+public:
+    std::size_t operator()(std::size_t h) const noexcept
+    {
+        std::uint64_t x = static_cast<std::uint64_t>(h);
+        x = (x >> shift) | (x << (64 - shift));
+        return static_cast<std::size_t>(stl::wymix(x, 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+/**
+ * @brief 为每种key选择混合器
+ * @details 整数默认使用fmix64，指针使用对齐指针混合，可以特化以选择其他混合器
+ */
+template <class Key>
+class hash_mixer_traits
+{
+public:
+    using mixer_type = stl::fmix64_mixer;
+};
+
+template <class T>
+class hash_mixer_traits<T*>
+{
+public:
+    using mixer_type = stl::aligned_pointer_mixer;
+};
+
+/**
+ * @brief 判断哈希函数的结果是否已经充分混合
+ * @details 哈希函数通过嵌套类型is_avalanching = std::true_type声明，
+ *          哈希表对这样的哈希函数不再做额外的混合
+ */
+template <class Hash, class = void>
+class hash_is_avalanching
+    : public std::false_type
+{};
+
+template <class Hash>
+class hash_is_avalanching<Hash, typename std::enable_if<Hash::is_avalanching::value>::type>
+    : public std::true_type
+{};
+
+/**
+ * @brief 混合后的hash
+ * @details 先用stl::hash求出哈希值，再用混合器打散，是否充分混合由混合器决定
+ */
+template <class Key, class Mixer = typename stl::hash_mixer_traits<Key>::mixer_type>
+class mixed_hash
+    : public _hash_base<std::size_t, Key>
+{
+public:
+    using typename _hash_base<std::size_t, Key>::argument_type;
+    using typename _hash_base<std::size_t, Key>::result_type;
+    using is_avalanching = std::integral_constant<bool, stl::hash_is_avalanching<Mixer>::value>;
+
+public:
+    result_type operator()(const argument_type& key) const
+    {
+        return Mixer()(stl::hash<Key>()(key));
+    }
+};
+
+/**
+ * @brief 字节序列哈希使用的常量
+ * @details 短输入使用wyhash的常量，长输入的条带密钥由splitmix64生成
+ */
+static const std::uint64_t __wyhash_secret[4] =
+{
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+static const std::uint64_t __hash_stripe_secret[24] =
+{
+    0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL, 0x06c45d188009454fULL,
+    0xf88bb8a8724c81ecULL, 0x1b39896a51a8749bULL, 0x53cb9f0c747ea2eaULL,
+    0x2c829abe1f4532e1ULL, 0xc584133ac916ab3cULL, 0x3ee5789041c98ac3ULL,
+    0xf3b8488c368cb0a6ULL, 0x657eecdd3cb13d09ULL, 0xc2d326e0055bdef6ULL,
+    0x8621a03fe0bbdb7bULL, 0x8e1f7555983aa92fULL, 0xb54e0f1600cc4d19ULL,
+    0x84bb3f97971d80abULL, 0x7d29825c75521255ULL, 0xc3cf17102b7f7f86ULL,
+    0x3466e9a083914f64ULL, 0xd81a8d2b5a4485acULL, 0xdb01602b100b9ed7ULL,
+    0xa9038a921825f10dULL, 0xedf5f1d90dca2f6aULL, 0x54496ad67bd2634cULL
+};
+
+static const std::size_t __hash_short_max = 240;        // 超过这个长度使用条带累加
+static const std::size_t __hash_stripe_size = 64;       // 每个条带8个64位lane
+static const std::size_t __hash_block_stripes = 16;     // 每16个条带打散一次累加器
+static const std::uint64_t __hash_scramble_prime = 0x9E3779B1ULL;
+
+inline std::uint64_t __read_u64(const unsigned char * p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t __read_u32(const unsigned char * p) noexcept
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief 128位乘积，低64位存入a，高64位存入b
+ */
+inline void __mul_u128(std::uint64_t & a, std::uint64_t & b) noexcept
+{
+    std::uint64_t hi = stl::__mul_high_u64(a, b);
+    a = a * b;
+    b = hi;
+}
+
+/**
+ * @brief 不超过240字节的输入，wyhash
+ */
+inline std::uint64_t __hash_bytes_short(const unsigned char * p, std::size_t len, std::uint64_t seed) noexcept
+{
+    const std::uint64_t * secret = __wyhash_secret;
+    seed ^= stl::wymix(seed ^ secret[0], secret[1]);
+    std::uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (__read_u32(p) << 32) | __read_u32(p + ((len >> 3) << 2));
+            b = (__read_u32(p + len - 4) << 32) | __read_u32(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = len;
+        if (i > 48) {
+            std::uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = stl::wymix(__read_u64(p) ^ secret[1], __read_u64(p + 8) ^ seed);
+                see1 = stl::wymix(__read_u64(p + 16) ^ secret[2], __read_u64(p + 24) ^ see1);
+                see2 = stl::wymix(__read_u64(p + 32) ^ secret[3], __read_u64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = stl::wymix(__read_u64(p) ^ secret[1], __read_u64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = __read_u64(p + i - 16);
+        b = __read_u64(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    __mul_u128(a, b);
+    return stl::wymix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/**
+ * @brief 把一个64字节条带累加到8个lane中
+ * @details 与XXH3相同：acc[i ^ 1] += v，acc[i] += 低32位(v ^ key) * 高32位(v ^ key)
+ */
+inline void __hash_accumulate_stripe(std::uint64_t * acc, const unsigned char * p, const std::uint64_t * key) noexcept
+{
+    for (std::size_t i = 0; i < 8; ++i) {
+        std::uint64_t v = __read_u64(p + 8 * i);
+        std::uint64_t k = v ^ key[i];
+        acc[i ^ 1] += v;
+        acc[i] += (k & 0xffffffffULL) * (k >> 32);
+    }
+}
+
+/**
+ * @brief 打散累加器，防止乘积只集中在部分位上
+ */
+inline void __hash_scramble(std::uint64_t * acc, const std::uint64_t * key) noexcept
+{
+    for (std::size_t i = 0; i < 8; ++i) {
+        std::uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= key[i];
+        acc[i] = a * __hash_scramble_prime;
+    }
+}
+
+/**
+ * @brief 长输入的条带累加，可移植实现
+ */
+inline void __hash_accumulate_portable(std::uint64_t * acc, const unsigned char * p, std::size_t len) noexcept
+{
+    const std::uint64_t * secret = __hash_stripe_secret;
+    std::size_t stripes = (len - 1) / __hash_stripe_size;   // 最后一个条带单独处理
+    std::size_t blocks = stripes / __hash_block_stripes;
+    for (std::size_t n = 0; n < blocks; ++n) {
+        for (std::size_t s = 0; s < __hash_block_stripes; ++s) {
+            __hash_accumulate_stripe(acc, p + s * __hash_stripe_size, secret + s);
+        }
+        __hash_scramble(acc, secret + 16);
+        p += __hash_block_stripes * __hash_stripe_size;
+    }
+    std::size_t rest = stripes - blocks * __hash_block_stripes;
+    for (std::size_t s = 0; s < rest; ++s) {
+        __hash_accumulate_stripe(acc, p + s * __hash_stripe_size, secret + s);
+    }
+    std::size_t tail = len - blocks * __hash_block_stripes * __hash_stripe_size;
+    __hash_accumulate_stripe(acc, p + tail - __hash_stripe_size, secret + 7);
+}
+
+#if _STL_X86
+/**
+ * @brief 长输入的条带累加，AVX2实现
+ * @details 两个256位寄存器各保存4个lane，结果与可移植实现完全相同
+ */
+_STL_TARGET_AVX2 inline void __hash_accumulate_avx2_stripe(__m256i & acc0, __m256i & acc1, const unsigned char * p, const std::uint64_t * key) noexcept
+{
+    __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+    __m256i k0 = _mm256_xor_si256(d0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key)));
+    __m256i k1 = _mm256_xor_si256(d1, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + 4)));
+    __m256i prod0 = _mm256_mul_epu32(k0, _mm256_srli_epi64(k0, 32));
+    __m256i prod1 = _mm256_mul_epu32(k1, _mm256_srli_epi64(k1, 32));
+    // 交换相邻的两个lane，对应acc[i ^ 1] += v
+    __m256i swap0 = _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2));
+    __m256i swap1 = _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2));
+    acc0 = _mm256_add_epi64(acc0, _mm256_add_epi64(prod0, swap0));
+    acc1 = _mm256_add_epi64(acc1, _mm256_add_epi64(prod1, swap1));
+}
+
+_STL_TARGET_AVX2 inline __m256i __hash_scramble_avx2(__m256i acc, const std::uint64_t * key) noexcept
+{
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(__hash_scramble_prime));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+    acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key)));
+    // 64位乘32位常数：低32位和高32位分别相乘
+    __m256i lo = _mm256_mul_epu32(acc, prime);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+}
+
+__attribute__((target("avx2"), flatten))
+inline void __hash_accumulate_avx2(std::uint64_t * acc, const unsigned char * p, std::size_t len) noexcept
+{
+    const std::uint64_t * secret = __hash_stripe_secret;
+    __m256i acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc));
+    __m256i acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + 4));
+    std::size_t stripes = (len - 1) / __hash_stripe_size;
+    std::size_t blocks = stripes / __hash_block_stripes;
+    for (std::size_t n = 0; n < blocks; ++n) {
+        for (std::size_t s = 0; s < __hash_block_stripes; ++s) {
+            __hash_accumulate_avx2_stripe(acc0, acc1, p + s * __hash_stripe_size, secret + s);
+        }
+        acc0 = __hash_scramble_avx2(acc0, secret + 16);
+        acc1 = __hash_scramble_avx2(acc1, secret + 20);
+        p += __hash_block_stripes * __hash_stripe_size;
+    }
+    std::size_t rest = stripes - blocks * __hash_block_stripes;
+    for (std::size_t s = 0; s < rest; ++s) {
+        __hash_accumulate_avx2_stripe(acc0, acc1, p + s * __hash_stripe_size, secret + s);
+    }
+    std::size_t tail = len - blocks * __hash_block_stripes * __hash_stripe_size;
+    __hash_accumulate_avx2_stripe(acc0, acc1, p + tail - __hash_stripe_size, secret + 7);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc), acc0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + 4), acc1);
+}
+#endif
+
+/**
+ * @brief 超过240字节的输入，XXH3风格的8路条带累加
+ * @param use_avx2 是否使用AVX2累加，调用者需要保证CPU支持
+ */
+inline std::uint64_t __hash_bytes_long(const unsigned char * p, std::size_t len, std::uint64_t seed, bool use_avx2) noexcept
+{
+    std::uint64_t acc[8] =
+    {
+        0x00000000C2B2AE3DULL, 0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL,
+        0x85EBCA77C2B2AE63ULL, 0x0000000085EBCA77ULL, 0x27D4EB2F165667C5ULL, 0x000000009E3779B1ULL
+    };
+#if _STL_X86
+    if (use_avx2) {
+        __hash_accumulate_avx2(acc, p, len);
+    } else {
+        __hash_accumulate_portable(acc, p, len);
+    }
+#else
+    (void)use_avx2;
+    __hash_accumulate_portable(acc, p, len);
+#endif
+    // 合并8个lane
+    const std::uint64_t * secret = __hash_stripe_secret;
+    std::uint64_t h = (len * 0x9E3779B185EBCA87ULL) ^ seed;
+    for (std::size_t i = 0; i < 4; ++i) {
+        h += stl::wymix(acc[2 * i] ^ secret[11 + 2 * i], acc[2 * i + 1] ^ secret[12 + 2 * i]);
+    }
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * @brief 计算一段字节序列的哈希值
+ * @details 短输入使用wyhash，超过240字节使用XXH3风格的条带累加，
+ *          CPU支持AVX2时长输入使用AVX2实现，结果与平台无关，且充分混合
+ */
+inline std::size_t hash_bytes(const void * data, std::size_t len, std::uint64_t seed = 0) noexcept
+{
+    const unsigned char * p = static_cast<const unsigned char *>(data);
+    if (len <= __hash_short_max) {
+        return static_cast<std::size_t>(__hash_bytes_short(p, len, seed));
+    }
+    return static_cast<std::size_t>(__hash_bytes_long(p, len, seed, stl::cpu_has_avx2()));
+}
+
+/**
+ * @brief 只读的字节序列视图
+ * @details 用作原始字节序列的key，不拥有数据
+ */
+class byte_span
+{
+protected:
+    const unsigned char * _data;
+    std::size_t _size;
+
+public:
+    byte_span() noexcept
+        : _data(nullptr), _size(0)
+    {}
+
+    byte_span(const void * data, std::size_t size) noexcept
+        : _data(static_cast<const unsigned char *>(data)), _size(size)
+    {}
+
+public:
+    const unsigned char * data() const noexcept
+    {
+        return _data;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    bool operator==(const byte_span & other) const noexcept
+    {
+        return _size == other._size && (_size == 0 || std::memcmp(_data, other._data, _size) == 0);
+    }
+
+    bool operator!=(const byte_span & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief 字节序列类型的hash特化
+ * @details 结果已经充分混合
+ */
+#define _HASH_BYTES_SPECIALIZATION_TEMPLATE(Key) \
+    template<> \
+    class hash<Key> \
+        : public _hash_base<std::size_t, Key> \
+    { \
+    public: \
+        using is_avalanching = std::true_type; \
+    \
+    public: \
+        result_type operator()(const argument_type& key) const noexcept \
+        { \
+            return stl::hash_bytes(key.data(), key.size()); \
+        } \
+    };
+
+_HASH_BYTES_SPECIALIZATION_TEMPLATE(std::string)
+
+#if __cplusplus >= 201703L
+_HASH_BYTES_SPECIALIZATION_TEMPLATE(std::string_view)
+#endif
+
+_HASH_BYTES_SPECIALIZATION_TEMPLATE(stl::byte_span)
+
+#undef _HASH_BYTES_SPECIALIZATION_TEMPLATE
+
+/**
+ * @brief 透明的字符串hash
+ * @details std::string、字符串字面量和const char*得到相同的哈希值，
+ *          配合stl::equal_to<void>使用时，可以不构造std::string直接查找
+ */
+class string_hash
+{
+public:
+    using is_transparent = void;
+    using is_avalanching = std::true_type;
+    using result_type = std::size_t;
+
+public:
+    result_type operator()(const std::string & key) const noexcept
+    {
+        return stl::hash_bytes(key.data(), key.size());
+    }
+
+    result_type operator()(const char * key) const noexcept
+    {
+        return stl::hash_bytes(key, std::strlen(key));
+    }
+
+#if __cplusplus >= 201703L
+    result_type operator()(std::string_view key) const noexcept
+    {
+        return stl::hash_bytes(key.data(), key.size());
+    }
+#endif
+};
+
 } // namespace stl
 
 #endif
\ No newline at end of file
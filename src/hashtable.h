@@ -3,8 +3,10 @@
 
 #include <stdexcept>
 #include <cmath>
+#include <cstdint>
 #include "vector.h"
 #include "hash.h"
+#include "functional.h"
 #include "utility.h"
 
 namespace stl
@@ -24,7 +26,208 @@ public:
 };
 
 /**
- * 
+ * @brief 桶索引策略
+ * @details 策略决定桶的数量以及哈希值到桶索引的映射：
+ *          next_size(n)返回不小于n的实际桶数，reset(n)在桶数确定后预计算参数，
+ *          index(hash)把哈希值映射到[0, n)，requires_mixing表示是否需要先打散哈希值
+ */
+
+/**
+ * @brief 取模策略
+ * @details 桶数任意，每次计算索引都是一次运行时除法，默认策略
+ */
+class mod_range_policy
+{
+public:
+    static constexpr bool requires_mixing = false;
+
+protected:
+    std::size_t _n = 1;
+
+public:
+    std::size_t next_size(std::size_t n) const noexcept
+    {
+        return n == 0 ? 1 : n;
+    }
+
+    void reset(std::size_t n) noexcept
+    {
+        _n = n;
+    }
+
+    std::size_t index(std::size_t hash) const noexcept
+    {
+        return hash % _n;
+    }
+};
+
+/**
+ * @brief 2的幂策略
+ * @details 桶数向上取整到2的幂，索引只需一次按位与，
+ *          掩码只保留低位，所以哈希值需要先混合
+ */
+class pow2_range_policy
+{
+public:
+    static constexpr bool requires_mixing = true;
+
+protected:
+    std::size_t _mask = 0;
+
+public:
+    std::size_t next_size(std::size_t n) const noexcept
+    {
+        std::size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    void reset(std::size_t n) noexcept
+    {
+        _mask = n - 1;
+    }
+
+    std::size_t index(std::size_t hash) const noexcept
+    {
+        return hash & _mask;
+    }
+};
+
+/**
+ * @brief Lemire的fastrange策略
+ * @details 桶数任意，索引为(hash * n) >> 64，用一次乘法代替除法，
+ *          结果只取决于哈希值的高位，所以哈希值需要先混合
+ */
+class fastrange_policy
+{
+public:
+    static constexpr bool requires_mixing = true;
+
+protected:
+    std::uint64_t _n = 1;
+
+public:
+    std::size_t next_size(std::size_t n) const noexcept
+    {
+        return n == 0 ? 1 : n;
+    }
+
+    void reset(std::size_t n) noexcept
+    {
+        _n = n;
+    }
+
+    std::size_t index(std::size_t hash) const noexcept
+    {
+        return static_cast<std::size_t>(__mul_high_u64(hash, _n));
+    }
+};
+
+/**
+ * @brief 哈希表使用的质数表
+ * @details 来自SGI STL，相邻质数约为两倍关系
+ */
+static const std::size_t __stl_num_primes = 28;
+static const unsigned long long __stl_prime_list[__stl_num_primes] =
+{
+    53ull,         97ull,         193ull,       389ull,       769ull,
+    1543ull,       3079ull,       6151ull,      12289ull,     24593ull,
+    49157ull,      98317ull,      196613ull,    393241ull,    786433ull,
+    1572869ull,    3145739ull,    6291469ull,   12582917ull,  25165843ull,
+    50331653ull,   100663319ull,  201326611ull, 402653189ull, 805306457ull,
+    1610612741ull, 3221225473ull, 4294967291ull
+};
+
+/**
+ * @brief 质数策略
+ * @details 桶数取质数表中不小于n的质数，对未混合的哈希值也能分布均匀，
+ *          桶数确定后预计算libdivide风格的魔数，把取模变成乘法和移位
+ */
+class prime_range_policy
+{
+public:
+    static constexpr bool requires_mixing = false;
+
+protected:
+    static constexpr std::uint8_t _add_marker = 0x40;    // 魔数溢出，需要额外的加法修正
+    static constexpr std::uint8_t _shift_mask = 0x3f;
+
+    std::uint64_t _n = 1;
+    std::uint64_t _magic = 0;
+    std::uint8_t _more = 0;
+
+public:
+    std::size_t next_size(std::size_t n) const noexcept
+    {
+        for (std::size_t i = 0; i < __stl_num_primes; ++i) {
+            if (__stl_prime_list[i] >= n) {
+                return static_cast<std::size_t>(__stl_prime_list[i]);
+            }
+        }
+        return static_cast<std::size_t>(__stl_prime_list[__stl_num_primes - 1]);
+    }
+
+    /**
+     * @brief 计算除以n的魔数
+     * @details 与libdivide的libdivide_u64_gen相同
+     */
+    void reset(std::size_t n) noexcept
+    {
+        _n = n;
+#ifdef __SIZEOF_INT128__
+        std::uint64_t d = n;
+        std::uint8_t floor_log_2_d = static_cast<std::uint8_t>(63 - __builtin_clzll(d));
+        if ((d & (d - 1)) == 0) {
+            // 2的幂直接移位
+            _magic = 0;
+            _more = floor_log_2_d;
+            return;
+        }
+        unsigned __int128 numerator = static_cast<unsigned __int128>(1) << (64 + floor_log_2_d);
+        std::uint64_t proposed_m = static_cast<std::uint64_t>(numerator / d);
+        std::uint64_t rem = static_cast<std::uint64_t>(numerator % d);
+        std::uint64_t e = d - rem;
+        if (e < (static_cast<std::uint64_t>(1) << floor_log_2_d)) {
+            _more = floor_log_2_d;
+        } else {
+            proposed_m += proposed_m;
+            std::uint64_t twice_rem = rem + rem;
+            if (twice_rem >= d || twice_rem < rem) {
+                proposed_m += 1;
+            }
+            _more = floor_log_2_d | _add_marker;
+        }
+        _magic = 1 + proposed_m;
+#endif
+    }
+
+    std::size_t index(std::size_t hash) const noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        std::uint64_t h = hash;
+        std::uint64_t q;
+        if (_magic == 0) {
+            q = h >> _more;
+        } else {
+            q = __mul_high_u64(_magic, h);
+            if (_more & _add_marker) {
+                q = (((h - q) >> 1) + q) >> (_more & _shift_mask);
+            } else {
+                q >>= _more;
+            }
+        }
+        return static_cast<std::size_t>(h - q * _n);
+#else
+        return hash % _n;
+#endif
+    }
+};
+
+/**
+ * @brief 链式哈希表
+ * @details RangePolicy决定桶数和桶索引的计算方式，默认取模
  */
 template <
     class Key,
@@ -32,7 +235,8 @@ template <
     class Hash,
     class Equal,
     class ExtractKey,
-    class Allocator
+    class Allocator,
+    class RangePolicy = stl::mod_range_policy
 >
 class hashtable
 {
@@ -122,20 +326,8 @@ public:
 
         self& operator++()
         {
-            node * old = _node;
-            _node = _node->_next;   // 尝试指向下一个节点
-            if (_node == nullptr) {
-                // 不存在下一个节点，需要跳转到下一个桶
-                size_type index = _hashtable->_hash_key(old->_value) + 1;  // 下一个桶的索引，这是怎么算的，O(1)?
-                while (index < _hashtable->bucket_count() && _hashtable->_buckets[index] == nullptr) {
-                    ++index;
-                }
-                // 设置新的节点
-                if (index < _hashtable->bucket_count()) {
-                    _node = _hashtable->_buckets[index];
-                }
-                // 否则已经到达桶的末尾，保持为nullptr
-            }
+            // 不存在下一个节点时需要跳转到下一个非空的桶，渐进式重建时可能跨越新旧两个桶数组
+            _node = _hashtable->_next_node(_node);
             return *this;
         }
 
@@ -232,25 +424,42 @@ public:
     using local_iterator = __hashtable_local_iterator;
     using const_local_iterator = const __hashtable_local_iterator;
     using Node_Alloc = typename Alloc::template rebind<__hashtable_node>::other;
+    using range_policy = RangePolicy;
+    using allocator_type = Alloc;
+    using bucket_vector = stl::vector<node *, typename Alloc::template rebind<node *>::other>;
+
+    // 哈希函数和比较函数都声明了is_transparent时，查找接口接受任意可比较的key
+    template <class K>
+    using _transparent_key = typename std::enable_if<
+        stl::__is_transparent<hasher>::value && stl::__is_transparent<key_equal>::value, K>::type;
 
 protected:
-    stl::vector<node *> _buckets;       // 哈希表桶
+    bucket_vector _buckets;             // 哈希表桶
     Node_Alloc _node_allocator;         // 节点分配器
     size_type _hashtable_elements;      // 哈希表的元素个数
     hasher _hash;                       // 哈希函数
     key_equal _equal;                   // 比较函数
     extract_key _extract_key;           // 提取key的函数
     float _max_load_factor;             // 最大负载因子
+    range_policy _range;                // 桶索引策略
+    bucket_vector _old_buckets;         // 渐进式重建时尚未迁移完的旧桶，不在重建时为空
+    range_policy _old_range;            // 旧桶的索引策略
+    size_type _rehash_index;            // 下一个要迁移的旧桶
+    bool _incremental;                  // 是否开启渐进式重建
+    size_type _rehash_buckets_per_step; // 每次插入迁移的非空旧桶数
 
 public:
-    hashtable(size_type n, const hasher & hash, const key_equal & equal)
-        : _hashtable_elements(0), _hash(hash), _equal(equal), _extract_key(extract_key()), _max_load_factor(1.0)   // key提取函数和键值对类型绑定，无法更改，所以不能传入
+    hashtable(size_type n, const hasher & hash, const key_equal & equal, const allocator_type & alloc = allocator_type())
+        : _buckets(alloc), _node_allocator(alloc), _hashtable_elements(0), _hash(hash), _equal(equal), _extract_key(extract_key()), _max_load_factor(1.0),   // key提取函数和键值对类型绑定，无法更改，所以不能传入
+          _old_buckets(alloc), _rehash_index(0), _incremental(false), _rehash_buckets_per_step(1)
     {
         _initialize_buckets(n);
     }
 
     ~hashtable()
-    {}
+    {
+        clear();
+    }
 
 public:
     // 迭代器
@@ -260,22 +469,12 @@ public:
      */
     iterator begin()
     {
-        for (size_type index = 0; index < _buckets.size(); ++index) {
-            if (_buckets[index] != nullptr) {
-                return iterator(_buckets[index], this);
-            }
-        }
-        return end();
+        return iterator(_first_node(), this);
     }
 
     const_iterator begin() const
     {
-        for (size_type index = 0; index < _buckets.size(); ++index) {
-            if (_buckets[index] != nullptr) {
-                return const_iterator(_buckets[index], this);
-            }
-        }
-        return end();
+        return const_iterator(_first_node(), const_cast<hashtable *>(this));
     }
 
     const_iterator cbegin() const
@@ -343,16 +542,12 @@ public:
      */
     void clear()
     {
-        for (size_type i = 0; i < _buckets.size(); ++i) {
-            node * first = _buckets[i];
-            while (first != nullptr) {
-                node * next = first->_next;
-                _node_allocator.destroy(first);
-                _node_allocator.deallocate(first, 1);
-                first = next;
-            }
-            _buckets[i] = nullptr;
+        _clear_buckets(_buckets);
+        if (_rehashing()) {
+            _clear_buckets(_old_buckets);
+            _end_rehash();
         }
+        _hashtable_elements = 0;
     }
 
     /**
@@ -363,98 +558,48 @@ public:
         if (pos == end()) {
             return end();
         }
-        return erase(pos, std::next(pos));
+        return _erase(pos);
     }
 
     /**
      * @brief 删除指定范围的元素
-     * @details 相当丑陋
+     * @details 逐个删除，范围可以跨越多个桶
      */
     iterator erase(const_iterator first, const_iterator last)
     {
-        if (first == last) {
-            return end();
-        }
-
-        size_type first_index = _hash_key(*first);
-        size_type last_index = -1;
-        if (last != cend())
-            last_index = _hash_key(*last);
-        node* cur = first._node;
-
-        // 同一个桶
-        if (first_index == last_index || last == cend()) {
-            node* pre = nullptr;
-            while (cur != last._node) {
-                node* next = cur->_next;
-                if (pre == nullptr) {
-                    _buckets[first_index] = next; // 更新桶头指针
-                } else {
-                    pre->_next = next; // 更新链表指针
-                }
-                _destroy_node(cur);
-                --_hashtable_elements;
-                cur = next;
-            }
-            return iterator(last._node, this);
-        }
-
-        // 跨桶删除
-        for (size_type i = first_index; i <= last_index; ++i) {
-            node* pre = nullptr;
-            node* current = _buckets[i];
-
-            if (i == first_index) {
-                // 第一个桶：删除从 first 到桶尾
-                while (current && current != last._node) {
-                    node* next = current->_next;
-                    if (current == cur) {
-                        _buckets[i] = next; // 更新桶头
-                    } else {
-                        pre->_next = next; // 更新链表指针
-                    }
-                    _destroy_node(current);
-                    --_hashtable_elements;
-                    current = next;
-                }
-                cur = nullptr; // 标记后续不需要处理起始节点
-            } else if (i == last_index) {
-                // 最后一个桶：删除到 last 节点之前
-                while (current && current != last._node) {
-                    node* next = current->_next;
-                    if (pre == nullptr) {
-                        _buckets[i] = next;
-                    } else {
-                        pre->_next = next;
-                    }
-                    _destroy_node(current);
-                    --_hashtable_elements;
-                    current = next;
-                }
-            } else {
-                // 中间桶：清空整个桶
-                while (current) {
-                    node* next = current->_next;
-                    _destroy_node(current);
-                    --_hashtable_elements;
-                    current = next;
-                }
-                _buckets[i] = nullptr; // 清空桶头指针
-            }
+        iterator cur(first._node, first._hashtable);
+        while (cur != last) {
+            cur = _erase(cur);
         }
-
         return iterator(last._node, this);
     }
 
-
     /**
      * @brief 删除指定key的元素
+     * @details 相同key的元素只可能在同一个桶中，遍历一次这个桶即可
      */
     size_type erase(const key_type & key)
     {
-        size_type n = count(key);
-        auto pair = equal_range(key);
-        erase(pair.first, pair.second);
+        node *& head = _bucket_ref(key);
+        node * cur = head;
+        node * prev = nullptr;
+        size_type n = 0;
+        while (cur != nullptr) {
+            node * next = cur->_next;
+            if (_equal(_extract_key(cur->_value), key)) {
+                if (prev == nullptr) {
+                    head = next;
+                } else {
+                    prev->_next = next;
+                }
+                _destroy_node(cur);
+                ++n;
+            } else {
+                prev = cur;
+            }
+            cur = next;
+        }
+        _hashtable_elements -= n;
         return n;
     }
 
@@ -463,13 +608,19 @@ public:
      */
     void swap(hashtable & other)
     {
-        std::swap(_buckets, other._buckets);
+        _buckets.swap(other._buckets);
         std::swap(_node_allocator, other._node_allocator);
         std::swap(_hashtable_elements, other._hashtable_elements);
         std::swap(_hash, other._hash);
         std::swap(_equal, other._equal);
         std::swap(_extract_key, other._extract_key);
         std::swap(_max_load_factor, other._max_load_factor);
+        std::swap(_range, other._range);
+        _old_buckets.swap(other._old_buckets);
+        std::swap(_old_range, other._old_range);
+        std::swap(_rehash_index, other._rehash_index);
+        std::swap(_incremental, other._incremental);
+        std::swap(_rehash_buckets_per_step, other._rehash_buckets_per_step);
     }
 
     // 查找
@@ -509,69 +660,61 @@ public:
      */
     size_type count(const key_type & key) const
     {
-        size_type index = _hash_key(key);
-        node * first = _buckets[index];
-        size_type _count = 0;
-        while (first != nullptr) {
-            if (_equal(_extract_key(first->_value), key)) {
-                ++_count;
-            }
-            first = first->_next;
-        }
-        return _count;
+        return _count(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素数量
+     * @details 哈希函数和比较函数都透明时可用，不需要构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K & key) const
+    {
+        return _count(key);
     }
 
     iterator find(const key_type & key)
     {
-        size_type index = _hash_key(key);
-        node * first = _buckets[index];
-        while (first != nullptr) {
-            if (_equal(_extract_key(first->_value), key)) {
-                return iterator(first, this);
-            }
-            first = first->_next;
-        }
-        return end();
+        return iterator(_find_node(key), this);
     }
 
     const_iterator find(const key_type & key) const
     {
-        size_type index = _hash_key(key);
-        node * first = _buckets[index];
-        while (first != nullptr) {
-            if (_equal(_extract_key(first->_value), key)) {
-                return const_iterator(first, const_cast<hashtable *>(this));
-            }
-            first = first->_next;
-        }
-        return cend();
+        return const_iterator(_find_node(key), const_cast<hashtable *>(this));
+    }
+
+    template <class K, class = _transparent_key<K>>
+    iterator find(const K & key)
+    {
+        return iterator(_find_node(key), this);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K & key) const
+    {
+        return const_iterator(_find_node(key), const_cast<hashtable *>(this));
     }
 
     stl::pair<iterator, iterator> equal_range(const key_type & key)
     {
-        iterator it = find(key);
-        iterator it2 = it;
-        if (it != end()) {
-            while (it2 != end() && _equal(_extract_key(*it2), key)) {
-                ++it2;
-            }
-        }
-        return stl::pair<iterator, iterator>(it, it2);
+        return _equal_range<iterator>(key);
     }
 
     stl::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
     {
-        std::cout << "equal_range" << std::endl;
-        const_iterator it = find(key);
-        std::cout << "getval: " << it->second << std::endl;
-        const_iterator it2 = it;
-        std::cout << "getval2: " << it2->second << std::endl;
-        if (it != cend()) {
-            while (it2 != cend() && _equal(_extract_key(*it2), key)) {
-                ++it2;
-            }
-        }
-        return stl::pair<const_iterator, const_iterator>(it, it2);
+        return const_cast<hashtable *>(this)->template _equal_range<const_iterator>(key);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    stl::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _equal_range<iterator>(key);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return const_cast<hashtable *>(this)->template _equal_range<const_iterator>(key);
     }
 
     // 桶接口
@@ -652,6 +795,12 @@ public:
         return _hash_key(key);
     }
 
+    template <class K, class = _transparent_key<K>>
+    size_type bucket(const K & key) const
+    {
+        return _hash_key(key);
+    }
+
     // 散列策略
 
     /**
@@ -680,13 +829,17 @@ public:
 
     /**
      * @brief 预留至少指定数量的桶并重新生成散列表
-     * @details 生成一个有n个桶的散列表
+     * @details 生成一个有n个桶的散列表，实际桶数由桶索引策略决定
      */
     void rehash(size_type n)
     {
+        _finish_rehash();
+        n = _range.next_size(n);
+        range_policy new_range(_range);
+        new_range.reset(n);
         // TODO 等vector功能完善再修改
         // stl::vector<node *> new_buckets(n, nullptr);
-        stl::vector<node *> new_buckets;
+        bucket_vector new_buckets(_buckets.get_allocator());
         new_buckets.reserve(n);
         new_buckets.insert(new_buckets.end(), n, nullptr);
         // 遍历所有桶，拿出节点存放到新的桶中
@@ -694,7 +847,7 @@ public:
         for (size_type i = 0; i < old_elements; ++i) {
             node * old_first = _buckets[i];
             while (old_first != nullptr) {
-                size_type new_index = _hash_key(old_first->_value, n);
+                size_type new_index = _hash_key(_extract_key(old_first->_value), new_range);
                 _buckets[i] = old_first->_next;  // 旧桶指向下一个节点
                 // 插入到新桶
                 old_first->_next = new_buckets[new_index];
@@ -705,6 +858,7 @@ public:
         }
         // 交换桶
         _buckets.swap(new_buckets);
+        _range = new_range;
     }
 
     /**
@@ -716,6 +870,48 @@ public:
         rehash(std::ceil(count / max_load_factor()));
     }
 
+    /**
+     * @brief 开启或关闭渐进式重建
+     * @param buckets_per_step 每次插入迁移的非空旧桶数
+     * @details 开启后负载因子超过上限时不再一次性迁移所有节点，而是同时保留新旧两个桶数组，
+     *          每次插入迁移一部分旧桶，查找和删除根据key所在的旧桶是否已经迁移决定访问哪个数组。
+     *          重建期间的插入会改变遍历顺序，桶接口只反映新桶数组。关闭时会立即完成正在进行的重建
+     */
+    void incremental_rehash(bool enable, size_type buckets_per_step = 1)
+    {
+        if (!enable) {
+            _finish_rehash();
+        }
+        _incremental = enable;
+        _rehash_buckets_per_step = buckets_per_step == 0 ? 1 : buckets_per_step;
+    }
+
+    bool incremental_rehash() const
+    {
+        return _incremental;
+    }
+
+    /**
+     * @brief 是否正在进行渐进式重建
+     */
+    bool rehashing() const
+    {
+        return _rehashing();
+    }
+
+    /**
+     * @brief 主动迁移最多n个非空旧桶
+     * @return 迁移后是否仍在重建
+     * @details 可以在空闲时调用，尽快结束重建
+     */
+    bool rehash_step(size_type n = 1)
+    {
+        if (_rehashing()) {
+            _rehash_step(n);
+        }
+        return _rehashing();
+    }
+
     // 观察器
 
     hasher hash_function() const
@@ -756,7 +952,8 @@ protected:
     void _initialize_buckets(size_type buckets_size)
     {
         // 计算需要多大的桶
-        // TODO
+        buckets_size = _range.next_size(buckets_size);
+        _range.reset(buckets_size);
         _buckets.reserve(buckets_size);
         _buckets.insert(_buckets.end(), buckets_size, nullptr);
     }
@@ -764,21 +961,27 @@ protected:
     /**
      * @brief 计算key所在的桶
      * @param key 键
-     * @param n 桶的数量
+     * @param range 桶索引策略
      */
-    size_type _hash_key(const key_type & key, size_type n) const
+    template <class K>
+    size_type _hash_key(const K & key, const range_policy & range) const
     {
-        // 计算模
-        return _hash(key) % n;
+        size_type h = _hash(key);
+        // 已经充分混合的哈希函数不需要再混合一次
+        if (range_policy::requires_mixing && !stl::hash_is_avalanching<hasher>::value) {
+            h = stl::fmix64(h);
+        }
+        return range.index(h);
     }
 
     /**
      * @brief 计算key所在的桶
      * @param key 键
      */
-    size_type _hash_key(const key_type & key) const
+    template <class K>
+    size_type _hash_key(const K & key) const
     {
-        return _hash_key(key, _buckets.size());
+        return _hash_key(key, _range);
     }
 
     /**
@@ -787,17 +990,253 @@ protected:
      */
     size_type _hash_key(const value_type & value) const
     {
-        return _hash_key(_extract_key(value), _buckets.size());
+        return _hash_key(_extract_key(value), _range);
     }
 
     /**
-     * @brief 计算pair<key, value>所在的桶
-     * @param value 键值对
-     * @param n 桶的数量
+     * @brief 计算key所在的桶
+     * @return key在尚未迁移的旧桶中时返回true，index为旧桶的索引，否则为新桶的索引
+     * @details 旧桶是整体迁移的，并且插入前会先迁移key所在的旧桶，
+     *          所以只要key对应的旧桶非空，与key等价的节点就都在这个旧桶中
      */
-    size_type _hash_key(const value_type & value, size_type n) const
+    template <class K>
+    bool _locate(const K & key, size_type & index) const
     {
-        return _hash_key(_extract_key(value), n);
+        if (_rehashing()) {
+            index = _hash_key(key, _old_range);
+            if (_old_buckets[index] != nullptr) {
+                return true;
+            }
+        }
+        index = _hash_key(key, _range);
+        return false;
+    }
+
+    /**
+     * @brief key所在的桶的头指针
+     */
+    template <class K>
+    node * _bucket_head(const K & key) const
+    {
+        size_type index;
+        return _locate(key, index) ? _old_buckets[index] : _buckets[index];
+    }
+
+    /**
+     * @brief key所在的桶的头指针的引用，用于修改链表
+     */
+    template <class K>
+    node *& _bucket_ref(const K & key)
+    {
+        size_type index;
+        return _locate(key, index) ? _old_buckets[index] : _buckets[index];
+    }
+
+    /**
+     * @brief 第一个节点，先遍历旧桶再遍历新桶
+     */
+    node * _first_node() const
+    {
+        if (_rehashing()) {
+            for (size_type index = _rehash_index; index < _old_buckets.size(); ++index) {
+                if (_old_buckets[index] != nullptr) {
+                    return _old_buckets[index];
+                }
+            }
+        }
+        for (size_type index = 0; index < _buckets.size(); ++index) {
+            if (_buckets[index] != nullptr) {
+                return _buckets[index];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 遍历顺序中的下一个节点
+     */
+    node * _next_node(node * cur) const
+    {
+        if (cur->_next != nullptr) {
+            return cur->_next;
+        }
+        size_type index;
+        if (_locate(_extract_key(cur->_value), index)) {
+            // 旧桶遍历完之后再从头遍历新桶
+            for (++index; index < _old_buckets.size(); ++index) {
+                if (_old_buckets[index] != nullptr) {
+                    return _old_buckets[index];
+                }
+            }
+            index = 0;
+        } else {
+            ++index;
+        }
+        for (; index < _buckets.size(); ++index) {
+            if (_buckets[index] != nullptr) {
+                return _buckets[index];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 销毁桶数组中的所有节点
+     */
+    void _clear_buckets(bucket_vector & buckets)
+    {
+        for (size_type i = 0; i < buckets.size(); ++i) {
+            node * first = buckets[i];
+            while (first != nullptr) {
+                node * next = first->_next;
+                _destroy_node(first);
+                first = next;
+            }
+            buckets[i] = nullptr;
+        }
+    }
+
+    bool _rehashing() const
+    {
+        return !_old_buckets.empty();
+    }
+
+    /**
+     * @brief 开始渐进式重建
+     * @details 只分配新桶数组，当前的桶数组成为旧桶，节点在之后的插入中逐步迁移
+     */
+    void _start_rehash(size_type n)
+    {
+        n = _range.next_size(n);
+        range_policy new_range(_range);
+        new_range.reset(n);
+        bucket_vector new_buckets(_buckets.get_allocator());
+        new_buckets.reserve(n);
+        new_buckets.insert(new_buckets.end(), n, nullptr);
+        _old_buckets.swap(_buckets);
+        _buckets.swap(new_buckets);
+        _old_range = _range;
+        _range = new_range;
+        _rehash_index = 0;
+    }
+
+    /**
+     * @brief 把一个旧桶中的所有节点迁移到新桶
+     */
+    void _migrate_bucket(size_type index)
+    {
+        node * first = _old_buckets[index];
+        while (first != nullptr) {
+            node * next = first->_next;
+            size_type new_index = _hash_key(_extract_key(first->_value), _range);
+            first->_next = _buckets[new_index];
+            _buckets[new_index] = first;
+            first = next;
+        }
+        _old_buckets[index] = nullptr;
+    }
+
+    /**
+     * @brief 插入前迁移key所在的旧桶，保证新节点和与它等价的节点都在新桶中
+     */
+    template <class K>
+    void _migrate_key_bucket(const K & key)
+    {
+        if (_rehashing()) {
+            size_type index = _hash_key(key, _old_range);
+            if (_old_buckets[index] != nullptr) {
+                _migrate_bucket(index);
+            }
+        }
+    }
+
+    /**
+     * @brief 迁移最多n个非空旧桶
+     * @details 与Redis的dictRehash相同，最多跳过10n个空桶，保证每一步的耗时有上限
+     */
+    void _rehash_step(size_type n)
+    {
+        size_type empty_visits = n * 10;
+        while (n > 0 && _rehash_index < _old_buckets.size()) {
+            if (_old_buckets[_rehash_index] == nullptr) {
+                ++_rehash_index;
+                if (--empty_visits == 0) {
+                    break;
+                }
+                continue;
+            }
+            _migrate_bucket(_rehash_index++);
+            --n;
+        }
+        if (_rehash_index >= _old_buckets.size()) {
+            _end_rehash();
+        }
+    }
+
+    /**
+     * @brief 立即迁移所有剩余的旧桶
+     */
+    void _finish_rehash()
+    {
+        while (_rehashing()) {
+            _rehash_step(_old_buckets.size());
+        }
+    }
+
+    void _end_rehash()
+    {
+        bucket_vector empty(_old_buckets.get_allocator());
+        _old_buckets.swap(empty);
+        _rehash_index = 0;
+    }
+
+    /**
+     * @brief 查找第一个与key等价的节点
+     * @return 没有找到时返回nullptr
+     */
+    template <class K>
+    node * _find_node(const K & key) const
+    {
+        node * first = _bucket_head(key);
+        while (first != nullptr) {
+            if (_equal(_extract_key(first->_value), key)) {
+                return first;
+            }
+            first = first->_next;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 统计与key等价的节点数
+     */
+    template <class K>
+    size_type _count(const K & key) const
+    {
+        node * first = _bucket_head(key);
+        size_type n = 0;
+        while (first != nullptr) {
+            if (_equal(_extract_key(first->_value), key)) {
+                ++n;
+            }
+            first = first->_next;
+        }
+        return n;
+    }
+
+    /**
+     * @brief 与key等价的元素范围
+     * @details 等价的元素在桶中相邻，从第一个开始向后找到第一个不等价的元素
+     */
+    template <class It, class K>
+    stl::pair<It, It> _equal_range(const K & key)
+    {
+        iterator first(_find_node(key), this);
+        iterator last = first;
+        while (last != end() && _equal(_extract_key(*last), key)) {
+            ++last;
+        }
+        return stl::pair<It, It>(first, last);
     }
 
     /**
@@ -805,9 +1244,18 @@ protected:
      */
     void _resize(size_type hashtable_elements)
     {
+        // 渐进式重建期间每次插入只迁移一部分旧桶
+        if (_rehashing()) {
+            _rehash_step(_rehash_buckets_per_step);
+            return;
+        }
         // 根据《STL源码剖析》，判断方法是当哈希表中的元素个数大于桶的大小，就重建，体现在_max_load_factor = 1.0
         if (load_factor() > max_load_factor()) {
-            rehash(hashtable_elements * 2);
+            if (_incremental) {
+                _start_rehash(hashtable_elements * 2);
+            } else {
+                rehash(hashtable_elements * 2);
+            }
         }
     }
 
@@ -816,6 +1264,7 @@ protected:
      */
     stl::pair<iterator, bool> _insert_unique_noresize(const value_type & value)
     {
+        _migrate_key_bucket(_extract_key(value));
         // 计算key所在的桶
         size_type index = _hash_key(value);
         // 寻找插入点
@@ -839,6 +1288,7 @@ protected:
      */
     iterator _insert_equal_noresize(const value_type & value)
     {
+        _migrate_key_bucket(_extract_key(value));
         size_type index = _hash_key(value);
         node * new_node = _create_node(value);
         node * first = _buckets[index];
@@ -861,9 +1311,8 @@ protected:
     template <typename T>
     iterator _erase(T && pos)
     {
-        value_type to_del = *pos;
-        size_type index = _hash_key(to_del);
-        node * cur = _buckets[index];
+        node *& head = _bucket_ref(_extract_key(*pos));
+        node * cur = head;
         node * prev = nullptr;
 
         while (cur && cur != pos._node) {
@@ -875,15 +1324,18 @@ protected:
             throw std::logic_error("Invalid iterator: node not found");
         }
 
+        // 先计算下一个位置，下一个元素可能在其他桶中
+        iterator next_pos(cur, this);
+        ++next_pos;
+
         if (prev == nullptr) {
             // 当前节点是桶头，直接修改桶的头指针
-            _buckets[index] = cur->_next;
+            head = cur->_next;
         } else {
             // 当前节点是链表中的非头部节点
             prev->_next = cur->_next;
         }
 
-        iterator next_pos(cur->_next, this);
         _destroy_node(cur);
         --_hashtable_elements;
         return next_pos;
@@ -892,9 +1344,9 @@ protected:
 
 // 非成员函数
 
-template <class Key, class Value, class Hash, class KeyEqual, class ExtractKey, class Allocator>
-void swap(stl::hashtable<Key, Value, Hash, KeyEqual, ExtractKey, Allocator> & lhs,
-          stl::hashtable<Key, Value, Hash, KeyEqual, ExtractKey, Allocator> & rhs)
+template <class Key, class Value, class Hash, class KeyEqual, class ExtractKey, class Allocator, class RangePolicy>
+void swap(stl::hashtable<Key, Value, Hash, KeyEqual, ExtractKey, Allocator, RangePolicy> & lhs,
+          stl::hashtable<Key, Value, Hash, KeyEqual, ExtractKey, Allocator, RangePolicy> & rhs)
 {
     lhs.swap(rhs);
 }
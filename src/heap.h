@@ -51,7 +51,7 @@ void make_heap(RandomIt first, RandomIt last, Compare comp)
 template <class RandomIt>
 void make_heap(RandomIt first, RandomIt last)
 {
-    make_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+    stl::make_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
 }
 
 /**
@@ -80,7 +80,7 @@ void push_heap(RandomIt first, RandomIt last, Compare comp)
 template <class RandomIt>
 void push_heap(RandomIt first, RandomIt last)
 {
-    push_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+    stl::push_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
 }
 
 /**
@@ -102,21 +102,21 @@ void pop_heap(RandomIt first, RandomIt last, Compare comp)
 template <class RandomIt>
 void pop_heap(RandomIt first, RandomIt last)
 {
-    pop_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+    stl::pop_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
 }
 
 template <class RandomIt, class Compare>
 void sort_heap(RandomIt first, RandomIt last, Compare comp)
 {
     while (last - first > 1) {
-        pop_heap(first, last--, comp);
+        stl::pop_heap(first, last--, comp);
     }
 }
 
 template <class RandomIt>
 void sort_heap(RandomIt first, RandomIt last)
 {
-    sort_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+    stl::sort_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
 }
 
 } // namespace stl
@@ -1,12 +1,82 @@
 #ifndef __ITERATOR_H__
 #define __ITERATOR_H__
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
 namespace stl
 {
 
 // 迭代器tag
 
 
+// 迭代器适配器
+
+/**
+ * @brief 不检查容量的尾部插入迭代器
+ * @link https://zh.cppreference.com/w/cpp/iterator/back_insert_iterator
+ * @details 赋值时调用容器的unchecked_emplace_back，调用者需要先用reserve_back预留足够的空间，
+ *          省去每个元素的容量检查
+ */
+template <class Container>
+class unchecked_back_insert_iterator
+{
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+    using container_type = Container;
+
+protected:
+    Container * _container;
+
+public:
+    explicit unchecked_back_insert_iterator(Container & container)
+        : _container(std::addressof(container))
+    {}
+
+    unchecked_back_insert_iterator & operator=(const typename Container::value_type & value)
+    {
+        _container->unchecked_emplace_back(value);
+        return *this;
+    }
+
+    unchecked_back_insert_iterator & operator=(typename Container::value_type && value)
+    {
+        _container->unchecked_emplace_back(std::move(value));
+        return *this;
+    }
+
+    unchecked_back_insert_iterator & operator*()
+    {
+        return *this;
+    }
+
+    unchecked_back_insert_iterator & operator++()
+    {
+        return *this;
+    }
+
+    unchecked_back_insert_iterator operator++(int)
+    {
+        return *this;
+    }
+};
+
+/**
+ * @brief 预留n个元素的空间，返回不检查容量的尾部插入迭代器
+ */
+template <class Container>
+unchecked_back_insert_iterator<Container> unchecked_back_inserter(Container & container, typename Container::size_type n)
+{
+    container.reserve_back(n);
+    return unchecked_back_insert_iterator<Container>(container);
+}
+
 } // namespace stl
 
-#endif
\ No newline at end of file
+#endif
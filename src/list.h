@@ -185,6 +185,14 @@ public:
         dummy->next = dummy;
     }
 
+    explicit list(const allocator_type & alloc)
+        : dummy(nullptr), _size(0), __allocator(alloc), __list_node_allocator(alloc)
+    {
+        dummy = get_node();
+        dummy->prev = dummy;
+        dummy->next = dummy;
+    }
+
     ~list()
     {
         clear();
@@ -531,7 +539,7 @@ protected:
      */
     void put_node(node_pointer ptr)
     {
-        __list_node_allocator.deallocate(ptr);
+        __list_node_allocator.deallocate(ptr, 1);
     }
 
     /**
@@ -636,7 +644,35 @@ protected:
 
 // 非成员函数
 
+/**
+ * @brief 删除所有满足pred的元素
+ * @details 逐个摘除节点，不移动其他元素，复杂度O(n)
+ * @return 删除的元素个数
+ */
+template <class T, class Alloc, class Pred>
+typename list<T, Alloc>::size_type erase_if(list<T, Alloc> & c, Pred pred)
+{
+    typename list<T, Alloc>::size_type count = 0;
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+            ++count;
+        } else {
+            ++it;
+        }
+    }
+    return count;
+}
 
+/**
+ * @brief 删除所有等于value的元素
+ * @return 删除的元素个数
+ */
+template <class T, class Alloc, class U>
+typename list<T, Alloc>::size_type erase(list<T, Alloc> & c, const U & value)
+{
+    return stl::erase_if(c, [&](const T & element) { return element == value; });
+}
 
 } // namespace stl
 
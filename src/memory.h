@@ -4,6 +4,22 @@
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
+#include <atomic>
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <mutex>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace stl
 {
@@ -122,6 +138,1792 @@ public:
     }
 };
 
+/**
+ * @brief 自旋锁
+ * @details 节点池的临界区只有几条指令，自旋比互斥量开销更小
+ */
+class __spin_lock
+{
+protected:
+    std::atomic_flag _flag = ATOMIC_FLAG_INIT;
+
+public:
+    void lock() noexcept
+    {
+        while (_flag.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+
+    void unlock() noexcept
+    {
+        _flag.clear(std::memory_order_release);
+    }
+};
+
+/**
+ * @brief 节点池中空闲槽的侵入式链表节点
+ */
+class __pool_free_node
+{
+public:
+    __pool_free_node * _next;
+};
+
+/**
+ * @brief 固定大小的节点池
+ * @tparam SlotSize 槽的大小，总是alignof(std::max_align_t)的倍数
+ * @details 每次从系统申请一整块slab，切分成等大的槽串到空闲链表上，分配和释放都是链表的头部操作。
+ *          所有槽大小相同的pool_allocator共享同一个池，池和slab永远不会释放，
+ *          因此静态存储期的容器在程序退出时析构也是安全的
+ */
+template <std::size_t SlotSize>
+class __node_pool
+{
+public:
+    static constexpr std::size_t slot_size = SlotSize;
+    static constexpr std::size_t slab_size = SlotSize * 64 > 64 * 1024 ? SlotSize * 64 : 64 * 1024;
+    static constexpr std::size_t slots_per_slab = slab_size / SlotSize;
+
+protected:
+    __pool_free_node * _free;
+    __spin_lock _lock;
+
+    __node_pool() noexcept
+        : _free(nullptr)
+    {}
+
+public:
+    static __node_pool & instance()
+    {
+        static __node_pool * pool = new __node_pool();  // 有意不释放，见类说明
+        return *pool;
+    }
+
+    void * allocate()
+    {
+        _lock.lock();
+        if (_free == nullptr) {
+            _refill();
+        }
+        __pool_free_node * node = _free;
+        _free = node->_next;
+        _lock.unlock();
+        return node;
+    }
+
+    void deallocate(void * ptr) noexcept
+    {
+        __pool_free_node * node = static_cast<__pool_free_node *>(ptr);
+        _lock.lock();
+        node->_next = _free;
+        _free = node;
+        _lock.unlock();
+    }
+
+    /**
+     * @brief 一次取出n个槽，供线程缓存使用
+     * @return 以nullptr结尾的链表
+     */
+    __pool_free_node * allocate_batch(std::size_t n)
+    {
+        _lock.lock();
+        __pool_free_node * first = nullptr;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (_free == nullptr) {
+                _refill();
+            }
+            __pool_free_node * node = _free;
+            _free = node->_next;
+            node->_next = first;
+            first = node;
+        }
+        _lock.unlock();
+        return first;
+    }
+
+    /**
+     * @brief 归还一段链表[first, last]
+     */
+    void deallocate_batch(__pool_free_node * first, __pool_free_node * last) noexcept
+    {
+        _lock.lock();
+        last->_next = _free;
+        _free = first;
+        _lock.unlock();
+    }
+
+protected:
+    /**
+     * @brief 申请一个新的slab并切分成槽，调用时需要持有锁
+     */
+    void _refill()
+    {
+        char * slab = static_cast<char *>(::operator new(slab_size));
+        for (std::size_t i = slots_per_slab; i > 0; --i) {
+            __pool_free_node * node = reinterpret_cast<__pool_free_node *>(slab + (i - 1) * SlotSize);
+            node->_next = _free;
+            _free = node;
+        }
+    }
+};
+
+/**
+ * @brief 节点池的线程缓存
+ * @details 每个线程持有一条私有的空闲链表，成批地从共享的池中取出和归还，
+ *          大部分分配和释放不需要加锁。在一个线程分配、在另一个线程释放的槽会进入释放线程的缓存
+ */
+template <std::size_t SlotSize>
+class __node_pool_thread_cache
+{
+public:
+    static constexpr std::size_t batch_size = 32;
+
+protected:
+    __pool_free_node * _free;
+    std::size_t _count;
+
+public:
+    __node_pool_thread_cache() noexcept
+        : _free(nullptr), _count(0)
+    {}
+
+    /**
+     * @brief 线程退出时把缓存的槽全部还给共享的池
+     */
+    ~__node_pool_thread_cache()
+    {
+        if (_free != nullptr) {
+            __pool_free_node * last = _free;
+            while (last->_next != nullptr) {
+                last = last->_next;
+            }
+            __node_pool<SlotSize>::instance().deallocate_batch(_free, last);
+        }
+    }
+
+    static __node_pool_thread_cache & instance()
+    {
+        static thread_local __node_pool_thread_cache cache;
+        return cache;
+    }
+
+    void * allocate()
+    {
+        if (_free == nullptr) {
+            _free = __node_pool<SlotSize>::instance().allocate_batch(batch_size);
+            _count = batch_size;
+        }
+        __pool_free_node * node = _free;
+        _free = node->_next;
+        --_count;
+        return node;
+    }
+
+    void deallocate(void * ptr) noexcept
+    {
+        __pool_free_node * node = static_cast<__pool_free_node *>(ptr);
+        node->_next = _free;
+        _free = node;
+        ++_count;
+        // 缓存过多时归还一批，避免一个线程囤积大量空闲槽
+        if (_count >= 2 * batch_size) {
+            __pool_free_node * last = _free;
+            for (std::size_t i = 1; i < batch_size; ++i) {
+                last = last->_next;
+            }
+            __pool_free_node * rest = last->_next;
+            __node_pool<SlotSize>::instance().deallocate_batch(_free, last);
+            _free = rest;
+            _count -= batch_size;
+        }
+    }
+};
+
+/**
+ * @brief 节点池分配器
+ * @tparam ThreadCache 是否启用线程缓存
+ * @details 单个元素的分配来自按槽大小共享的节点池，适合链表、哈希表、红黑树等每次只分配一个节点的容器；
+ *          一次分配多个元素或者对齐要求超过max_align_t时退回到operator new。
+ *          分配器无状态，任意两个实例都相等，可以通过rebind用于节点类型
+ */
+template <class T, bool ThreadCache = false>
+class pool_allocator
+{
+public:
+    // 嵌套类型
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    // 槽的大小，向上取整到max_align_t的对齐，使所有槽都满足对齐要求
+    static constexpr std::size_t slot_size =
+        ((sizeof(T) > sizeof(__pool_free_node) ? sizeof(T) : sizeof(__pool_free_node)) + alignof(std::max_align_t) - 1)
+        / alignof(std::max_align_t) * alignof(std::max_align_t);
+    static constexpr bool use_pool = alignof(T) <= alignof(std::max_align_t);
+
+public:
+    pool_allocator() noexcept = default;
+
+    pool_allocator(const pool_allocator & other) noexcept = default;
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U, ThreadCache> &) noexcept
+    {}
+
+    ~pool_allocator() = default;
+
+    template <typename U>
+    class rebind
+    {
+    public:
+        using other = pool_allocator<U, ThreadCache>;
+    };
+
+    /**
+     * @brief 分配n个元素的内存
+     * @param n 元素个数，为1时从节点池分配
+     * @param hint 忽略
+     */
+    pointer allocate(size_type n, const void * hint = nullptr)
+    {
+        (void)hint;
+        if (n > max_size())
+            throw std::bad_array_new_length();
+        if (n == 0)
+            return nullptr;
+        if (n == 1 && use_pool) {
+            return static_cast<pointer>(ThreadCache
+                ? __node_pool_thread_cache<slot_size>::instance().allocate()
+                : __node_pool<slot_size>::instance().allocate());
+        }
+        return static_cast<pointer>(::operator new(n * sizeof(value_type)));
+    }
+
+    /**
+     * @brief 释放由allocate分配的内存
+     * @param ptr 要释放的内存指针
+     * @param n 元素个数，必须与allocate时相同
+     */
+    void deallocate(pointer ptr, size_type n)
+    {
+        if (ptr == nullptr) return;
+        if (n == 1 && use_pool) {
+            if (ThreadCache) {
+                __node_pool_thread_cache<slot_size>::instance().deallocate(ptr);
+            } else {
+                __node_pool<slot_size>::instance().deallocate(ptr);
+            }
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+    template <typename U, typename... Args>
+    pointer construct(U * ptr, Args&&... args)
+    {
+        return static_cast<U *>(::new(ptr) U(std::forward<Args>(args)...));
+    }
+
+    template <typename U>
+    void destroy(U * ptr)
+    {
+        ptr->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<std::size_t>::max() / sizeof(value_type);
+    }
+
+    pointer address(reference r) const noexcept
+    {
+        return &r;
+    }
+
+    const_pointer address(const_reference r) const noexcept
+    {
+        return &r;
+    }
+
+    bool operator==(const pool_allocator &) const noexcept
+    {
+        return true;    // 所有实例共享同一个池
+    }
+
+    bool operator!=(const pool_allocator &) const noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief 内存资源
+ * @link https://zh.cppreference.com/w/cpp/memory/memory_resource
+ * @details 多态的内存来源，由polymorphic_allocator使用，派生类实现do_allocate、do_deallocate和do_is_equal
+ */
+class memory_resource
+{
+public:
+    static constexpr std::size_t max_align = alignof(std::max_align_t);
+
+public:
+    virtual ~memory_resource() = default;
+
+    void * allocate(std::size_t bytes, std::size_t alignment = max_align)
+    {
+        return do_allocate(bytes, alignment);
+    }
+
+    void deallocate(void * ptr, std::size_t bytes, std::size_t alignment = max_align)
+    {
+        do_deallocate(ptr, bytes, alignment);
+    }
+
+    bool is_equal(const memory_resource & other) const noexcept
+    {
+        return do_is_equal(other);
+    }
+
+protected:
+    virtual void * do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+    virtual void do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) = 0;
+
+    virtual bool do_is_equal(const memory_resource & other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource & lhs, const memory_resource & rhs) noexcept
+{
+    return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource & lhs, const memory_resource & rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * @brief 使用operator new和operator delete的内存资源
+ */
+class __new_delete_resource
+    : public memory_resource
+{
+protected:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+#ifdef __cpp_aligned_new
+        if (alignment > max_align) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+#endif
+        (void)alignment;
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        (void)bytes;
+#ifdef __cpp_aligned_new
+        if (alignment > max_align) {
+            ::operator delete(ptr, std::align_val_t(alignment));
+            return;
+        }
+#endif
+        (void)alignment;
+        ::operator delete(ptr);
+    }
+
+    bool do_is_equal(const memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief 任何分配都抛出std::bad_alloc的内存资源
+ * @details 作为上游资源，可以保证只使用初始缓冲区
+ */
+class __null_memory_resource
+    : public memory_resource
+{
+protected:
+    void * do_allocate(std::size_t, std::size_t) override
+    {
+        throw std::bad_alloc();
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override
+    {}
+
+    bool do_is_equal(const memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+inline memory_resource * new_delete_resource() noexcept
+{
+    static __new_delete_resource resource;
+    return &resource;
+}
+
+inline memory_resource * null_memory_resource() noexcept
+{
+    static __null_memory_resource resource;
+    return &resource;
+}
+
+inline std::atomic<memory_resource *> & __default_resource() noexcept
+{
+    static std::atomic<memory_resource *> resource(new_delete_resource());
+    return resource;
+}
+
+/**
+ * @brief 返回默认的内存资源，初始为new_delete_resource()
+ */
+inline memory_resource * get_default_resource() noexcept
+{
+    return __default_resource().load(std::memory_order_acquire);
+}
+
+/**
+ * @brief 设置默认的内存资源
+ * @param resource 为nullptr时恢复为new_delete_resource()
+ * @return 之前的默认资源
+ */
+inline memory_resource * set_default_resource(memory_resource * resource) noexcept
+{
+    if (resource == nullptr) {
+        resource = new_delete_resource();
+    }
+    return __default_resource().exchange(resource, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief 向上对齐
+ */
+inline std::size_t __align_up(std::size_t n, std::size_t alignment) noexcept
+{
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief 单调缓冲区资源
+ * @link https://zh.cppreference.com/w/cpp/memory/monotonic_buffer_resource
+ * @details 从当前块中顺序切分内存，deallocate什么都不做，所有内存在release或析构时一次性归还上游。
+ *          当前块不足时向上游申请一个更大的块，块的大小按几何级数增长。非线程安全
+ */
+class monotonic_buffer_resource
+    : public memory_resource
+{
+protected:
+    /**
+     * @brief 从上游申请的块的头部，串成单链表
+     */
+    class __chunk
+    {
+    public:
+        __chunk * _next;
+        std::size_t _size;
+        std::size_t _alignment;
+    };
+
+    static constexpr std::size_t default_next_size = 1024;
+    static constexpr std::size_t growth_factor = 2;
+
+    memory_resource * _upstream;
+    void * _initial_buffer;
+    std::size_t _initial_size;
+    char * _current;                    // 当前块中下一个可用的位置
+    std::size_t _space;                 // 当前块中剩余的字节数
+    std::size_t _first_size;            // 第一次向上游申请的块的大小
+    std::size_t _next_size;             // 下一次向上游申请的块的大小
+    __chunk * _chunks;                  // 从上游申请的所有块
+
+public:
+    monotonic_buffer_resource()
+        : monotonic_buffer_resource(get_default_resource())
+    {}
+
+    explicit monotonic_buffer_resource(memory_resource * upstream)
+        : _upstream(upstream), _initial_buffer(nullptr), _initial_size(0),
+          _current(nullptr), _space(0), _first_size(default_next_size), _next_size(_first_size), _chunks(nullptr)
+    {}
+
+    explicit monotonic_buffer_resource(std::size_t initial_size, memory_resource * upstream = get_default_resource())
+        : _upstream(upstream), _initial_buffer(nullptr), _initial_size(0),
+          _current(nullptr), _space(0), _first_size(initial_size == 0 ? 1 : initial_size), _next_size(_first_size), _chunks(nullptr)
+    {}
+
+    /**
+     * @brief 首先使用调用者提供的缓冲区
+     */
+    monotonic_buffer_resource(void * buffer, std::size_t size, memory_resource * upstream = get_default_resource())
+        : _upstream(upstream), _initial_buffer(buffer), _initial_size(size),
+          _current(static_cast<char *>(buffer)), _space(size),
+          _first_size(size == 0 ? default_next_size : size * growth_factor), _next_size(_first_size), _chunks(nullptr)
+    {}
+
+    monotonic_buffer_resource(const monotonic_buffer_resource &) = delete;
+
+    monotonic_buffer_resource & operator=(const monotonic_buffer_resource &) = delete;
+
+    ~monotonic_buffer_resource() override
+    {
+        release();
+    }
+
+public:
+    /**
+     * @brief 把所有块归还上游，重新从初始缓冲区开始分配
+     * @details 块大小也恢复到初始值，反复使用同一资源时不会无限增长
+     */
+    void release()
+    {
+        while (_chunks != nullptr) {
+            __chunk * next = _chunks->_next;
+            _upstream->deallocate(_chunks, _chunks->_size, _chunks->_alignment);
+            _chunks = next;
+        }
+        _current = static_cast<char *>(_initial_buffer);
+        _space = _initial_size;
+        _next_size = _first_size;
+    }
+
+    memory_resource * upstream_resource() const noexcept
+    {
+        return _upstream;
+    }
+
+protected:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (bytes == 0) {
+            bytes = 1;
+        }
+        std::size_t padding = __align_up(reinterpret_cast<std::size_t>(_current), alignment) - reinterpret_cast<std::size_t>(_current);
+        if (_current == nullptr || padding + bytes > _space) {
+            _new_chunk(bytes, alignment);
+            padding = __align_up(reinterpret_cast<std::size_t>(_current), alignment) - reinterpret_cast<std::size_t>(_current);
+        }
+        char * result = _current + padding;
+        _current = result + bytes;
+        _space -= padding + bytes;
+        return result;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override
+    {}
+
+    bool do_is_equal(const memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /**
+     * @brief 向上游申请一个至少能放下bytes字节的块
+     */
+    void _new_chunk(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t chunk_alignment = alignment > max_align ? alignment : max_align;
+        std::size_t header = __align_up(sizeof(__chunk), chunk_alignment);
+        std::size_t size = _next_size;
+        while (size < header + bytes) {
+            size *= growth_factor;
+        }
+        __chunk * chunk = static_cast<__chunk *>(_upstream->allocate(size, chunk_alignment));
+        chunk->_next = _chunks;
+        chunk->_size = size;
+        chunk->_alignment = chunk_alignment;
+        _chunks = chunk;
+        _current = reinterpret_cast<char *>(chunk) + header;
+        _space = size - header;
+        _next_size = size * growth_factor;
+    }
+};
+
+/**
+ * @brief 池资源的选项
+ */
+class pool_options
+{
+public:
+    std::size_t max_blocks_per_chunk = 0;           // 每次向上游申请的最多块数，0表示使用默认值
+    std::size_t largest_required_pool_block = 0;    // 由池管理的最大块，更大的分配直接交给上游，0表示使用默认值
+};
+
+/**
+ * @brief 非同步的池资源
+ * @link https://zh.cppreference.com/w/cpp/memory/unsynchronized_pool_resource
+ * @details 按2的幂划分大小类，每个大小类从上游成批申请块并用侵入式空闲链表管理，
+ *          超过最大块的分配直接交给上游，release或析构时把所有内存归还上游。非线程安全
+ */
+class unsynchronized_pool_resource
+    : public memory_resource
+{
+protected:
+    static constexpr std::size_t min_block = 8;
+    static constexpr std::size_t default_largest_block = 4096;
+    static constexpr std::size_t default_max_blocks = 1024;
+    static constexpr std::size_t initial_blocks = 16;
+
+    /**
+     * @brief 从上游申请的内存的头部，串成双向链表，使超大分配也能单独释放
+     */
+    class __chunk
+    {
+    public:
+        __chunk * _prev;
+        __chunk * _next;
+        std::size_t _size;
+    };
+
+    /**
+     * @brief 一个大小类
+     */
+    class __pool
+    {
+    public:
+        __pool_free_node * _free = nullptr;
+        std::size_t _next_blocks = initial_blocks;     // 下一次申请的块数
+    };
+
+    static constexpr std::size_t header_size = (sizeof(__chunk) + max_align - 1) / max_align * max_align;
+
+    memory_resource * _upstream;
+    pool_options _options;
+    std::size_t _pool_count;
+    __pool * _pools;
+    __chunk * _chunks;          // 所有大小类申请的块
+    __chunk * _oversized;       // 超过最大块的分配
+
+public:
+    unsynchronized_pool_resource()
+        : unsynchronized_pool_resource(pool_options(), get_default_resource())
+    {}
+
+    explicit unsynchronized_pool_resource(memory_resource * upstream)
+        : unsynchronized_pool_resource(pool_options(), upstream)
+    {}
+
+    explicit unsynchronized_pool_resource(const pool_options & options, memory_resource * upstream = get_default_resource())
+        : _upstream(upstream), _options(options), _pool_count(0), _pools(nullptr), _chunks(nullptr), _oversized(nullptr)
+    {
+        if (_options.max_blocks_per_chunk == 0) {
+            _options.max_blocks_per_chunk = default_max_blocks;
+        }
+        if (_options.largest_required_pool_block == 0) {
+            _options.largest_required_pool_block = default_largest_block;
+        }
+        std::size_t largest = min_block;
+        _pool_count = 1;
+        while (largest < _options.largest_required_pool_block) {
+            largest <<= 1;
+            ++_pool_count;
+        }
+        _options.largest_required_pool_block = largest;
+        _pools = static_cast<__pool *>(_upstream->allocate(sizeof(__pool) * _pool_count, alignof(__pool)));
+        for (std::size_t i = 0; i < _pool_count; ++i) {
+            ::new(_pools + i) __pool();
+        }
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource &) = delete;
+
+    unsynchronized_pool_resource & operator=(const unsynchronized_pool_resource &) = delete;
+
+    ~unsynchronized_pool_resource() override
+    {
+        release();
+        _upstream->deallocate(_pools, sizeof(__pool) * _pool_count, alignof(__pool));
+    }
+
+public:
+    /**
+     * @brief 把所有内存归还上游
+     */
+    void release()
+    {
+        _release_list(_chunks);
+        _release_list(_oversized);
+        for (std::size_t i = 0; i < _pool_count; ++i) {
+            _pools[i] = __pool();
+        }
+    }
+
+    memory_resource * upstream_resource() const noexcept
+    {
+        return _upstream;
+    }
+
+    pool_options options() const noexcept
+    {
+        return _options;
+    }
+
+protected:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        std::size_t index;
+        if (!_pool_index(bytes, alignment, index)) {
+            return _allocate_oversized(bytes, alignment);
+        }
+        __pool & pool = _pools[index];
+        if (pool._free == nullptr) {
+            _refill(pool, min_block << index);
+        }
+        __pool_free_node * node = pool._free;
+        pool._free = node->_next;
+        return node;
+    }
+
+    void do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        std::size_t index;
+        if (!_pool_index(bytes, alignment, index)) {
+            _deallocate_oversized(ptr, bytes, alignment);
+            return;
+        }
+        __pool_free_node * node = static_cast<__pool_free_node *>(ptr);
+        node->_next = _pools[index]._free;
+        _pools[index]._free = node;
+    }
+
+    bool do_is_equal(const memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /**
+     * @brief 计算分配所属的大小类
+     * @return 由池管理时返回true
+     * @details 块大小取不小于bytes和alignment的2的幂，块在块组中按自身大小对齐，
+     *          所以只要对齐不超过max_align，块的大小就满足对齐要求
+     */
+    bool _pool_index(std::size_t bytes, std::size_t alignment, std::size_t & index) const noexcept
+    {
+        if (alignment > max_align || bytes > _options.largest_required_pool_block) {
+            return false;
+        }
+        std::size_t size = bytes > alignment ? bytes : alignment;
+        std::size_t block = min_block;
+        index = 0;
+        while (block < size) {
+            block <<= 1;
+            ++index;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 为一个大小类申请新的块组，块数按两倍增长直到上限
+     */
+    void _refill(__pool & pool, std::size_t block_size)
+    {
+        std::size_t blocks = pool._next_blocks;
+        std::size_t size = header_size + blocks * block_size;
+        char * memory = static_cast<char *>(_upstream->allocate(size, max_align));
+        _link(_chunks, reinterpret_cast<__chunk *>(memory), size);
+        for (std::size_t i = blocks; i > 0; --i) {
+            __pool_free_node * node = reinterpret_cast<__pool_free_node *>(memory + header_size + (i - 1) * block_size);
+            node->_next = pool._free;
+            pool._free = node;
+        }
+        if (pool._next_blocks * 2 <= _options.max_blocks_per_chunk) {
+            pool._next_blocks *= 2;
+        }
+    }
+
+    void * _allocate_oversized(std::size_t bytes, std::size_t alignment)
+    {
+        if (alignment > max_align) {
+            // 头部无法在不破坏对齐的情况下放在前面，直接交给上游
+            return _upstream->allocate(bytes, alignment);
+        }
+        std::size_t size = header_size + bytes;
+        char * memory = static_cast<char *>(_upstream->allocate(size, max_align));
+        _link(_oversized, reinterpret_cast<__chunk *>(memory), size);
+        return memory + header_size;
+    }
+
+    void _deallocate_oversized(void * ptr, std::size_t bytes, std::size_t alignment)
+    {
+        if (alignment > max_align) {
+            _upstream->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        __chunk * chunk = reinterpret_cast<__chunk *>(static_cast<char *>(ptr) - header_size);
+        if (chunk->_prev != nullptr) {
+            chunk->_prev->_next = chunk->_next;
+        } else {
+            _oversized = chunk->_next;
+        }
+        if (chunk->_next != nullptr) {
+            chunk->_next->_prev = chunk->_prev;
+        }
+        _upstream->deallocate(chunk, chunk->_size, max_align);
+    }
+
+    static void _link(__chunk *& head, __chunk * chunk, std::size_t size) noexcept
+    {
+        chunk->_prev = nullptr;
+        chunk->_next = head;
+        chunk->_size = size;
+        if (head != nullptr) {
+            head->_prev = chunk;
+        }
+        head = chunk;
+    }
+
+    void _release_list(__chunk *& head)
+    {
+        while (head != nullptr) {
+            __chunk * next = head->_next;
+            _upstream->deallocate(head, head->_size, max_align);
+            head = next;
+        }
+    }
+};
+
+/**
+ * @brief 同步的池资源
+ * @link https://zh.cppreference.com/w/cpp/memory/synchronized_pool_resource
+ * @details 用互斥量保护的unsynchronized_pool_resource，可以在多个线程之间共享
+ */
+class synchronized_pool_resource
+    : public memory_resource
+{
+protected:
+    unsynchronized_pool_resource _pool;
+    std::mutex _mutex;
+
+public:
+    synchronized_pool_resource()
+        : _pool()
+    {}
+
+    explicit synchronized_pool_resource(memory_resource * upstream)
+        : _pool(upstream)
+    {}
+
+    explicit synchronized_pool_resource(const pool_options & options, memory_resource * upstream = get_default_resource())
+        : _pool(options, upstream)
+    {}
+
+    synchronized_pool_resource(const synchronized_pool_resource &) = delete;
+
+    synchronized_pool_resource & operator=(const synchronized_pool_resource &) = delete;
+
+public:
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pool.release();
+    }
+
+    memory_resource * upstream_resource() const noexcept
+    {
+        return _pool.upstream_resource();
+    }
+
+    pool_options options() const noexcept
+    {
+        return _pool.options();
+    }
+
+protected:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pool.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pool.deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief 多态分配器
+ * @link https://zh.cppreference.com/w/cpp/memory/polymorphic_allocator
+ * @details 把分配转发给运行时指定的memory_resource，同一容器类型可以使用不同的内存来源。
+ *          两个分配器相等当且仅当它们的资源相等，容器拷贝和移动赋值时不传播分配器
+ */
+template <class T>
+class polymorphic_allocator
+{
+public:
+    // 嵌套类型
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+protected:
+    memory_resource * _resource;
+
+public:
+    polymorphic_allocator() noexcept
+        : _resource(get_default_resource())
+    {}
+
+    polymorphic_allocator(memory_resource * resource) noexcept
+        : _resource(resource)
+    {}
+
+    polymorphic_allocator(const polymorphic_allocator & other) noexcept = default;
+
+    template <typename U>
+    polymorphic_allocator(const polymorphic_allocator<U> & other) noexcept
+        : _resource(other.resource())
+    {}
+
+    polymorphic_allocator & operator=(const polymorphic_allocator &) = default;
+
+    ~polymorphic_allocator() = default;
+
+    template <typename U>
+    class rebind
+    {
+    public:
+        using other = polymorphic_allocator<U>;
+    };
+
+    pointer allocate(size_type n, const void * hint = nullptr)
+    {
+        (void)hint;
+        if (n > max_size())
+            throw std::bad_array_new_length();
+        return n == 0 ? nullptr : static_cast<pointer>(_resource->allocate(n * sizeof(value_type), alignof(value_type)));
+    }
+
+    void deallocate(pointer ptr, size_type n)
+    {
+        if (ptr == nullptr) return;
+        _resource->deallocate(ptr, n * sizeof(value_type), alignof(value_type));
+    }
+
+    template <typename U, typename... Args>
+    pointer construct(U * ptr, Args&&... args)
+    {
+        return static_cast<U *>(::new(ptr) U(std::forward<Args>(args)...));
+    }
+
+    template <typename U>
+    void destroy(U * ptr)
+    {
+        ptr->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<std::size_t>::max() / sizeof(value_type);
+    }
+
+    pointer address(reference r) const noexcept
+    {
+        return &r;
+    }
+
+    const_pointer address(const_reference r) const noexcept
+    {
+        return &r;
+    }
+
+    memory_resource * resource() const noexcept
+    {
+        return _resource;
+    }
+
+    /**
+     * @brief 拷贝构造容器时不传播资源，使用默认资源
+     */
+    polymorphic_allocator select_on_container_copy_construction() const
+    {
+        return polymorphic_allocator();
+    }
+
+    template <typename U>
+    bool operator==(const polymorphic_allocator<U> & other) const noexcept
+    {
+        return *_resource == *other.resource();
+    }
+
+    template <typename U>
+    bool operator!=(const polymorphic_allocator<U> & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief allocate_at_least的返回值
+ * @link https://zh.cppreference.com/w/cpp/memory/allocation_result
+ */
+template <class Pointer>
+class allocation_result
+{
+public:
+    Pointer ptr;            // 分配的内存
+    std::size_t count;      // 实际可用的元素个数，不小于请求的个数
+};
+
+/**
+ * @brief 使用malloc和free的分配器
+ * @details 额外提供reallocate，容器扩容时可以用realloc原地扩展或由系统重新映射大块内存，
+ *          只有可平凡重定位的元素才能这样搬移
+ */
+template <class T>
+class malloc_allocator
+{
+public:
+    // 嵌套类型
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+public:
+    malloc_allocator() noexcept = default;
+
+    malloc_allocator(const malloc_allocator & other) noexcept = default;
+
+    template <typename U>
+    malloc_allocator(const malloc_allocator<U> & other) noexcept
+    {}
+
+    ~malloc_allocator() = default;
+
+    template <typename U>
+    class rebind
+    {
+    public:
+        using other = malloc_allocator<U>;
+    };
+
+    pointer allocate(size_type n, const void * hint = nullptr)
+    {
+        (void)hint;
+        if (n > max_size())
+            throw std::bad_array_new_length();
+        if (n == 0) return nullptr;
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc_allocator does not support over-aligned types");
+        void * ptr = std::malloc(n * sizeof(value_type));
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return static_cast<pointer>(ptr);
+    }
+
+    void deallocate(pointer ptr, size_type n = 0)
+    {
+        (void)n;
+        std::free(ptr);
+    }
+
+    /**
+     * @brief 把已分配的内存调整为new_n个元素，原有的字节被保留
+     * @param ptr 由allocate或reallocate返回的指针
+     * @param old_n 原有的元素个数，忽略
+     * @details 失败时抛出std::bad_alloc，原内存保持不变
+     */
+    pointer reallocate(pointer ptr, size_type old_n, size_type new_n)
+    {
+        (void)old_n;
+        if (new_n > max_size())
+            throw std::bad_array_new_length();
+        if (new_n == 0) {
+            std::free(ptr);
+            return nullptr;
+        }
+        void * result = std::realloc(static_cast<void *>(ptr), new_n * sizeof(value_type));
+        if (result == nullptr)
+            throw std::bad_alloc();
+        return static_cast<pointer>(result);
+    }
+
+    /**
+     * @brief 分配至少n个元素的内存，返回实际可用的元素个数
+     * @details 使用malloc_usable_size得到分配器尺寸类别中的真实大小，
+     *          链接jemalloc等提供同名函数的分配器时同样有效
+     */
+    allocation_result<pointer> allocate_at_least(size_type n)
+    {
+        pointer ptr = allocate(n);
+        return {ptr, _usable_count(ptr, n)};
+    }
+
+    /**
+     * @brief 把已分配的内存调整为至少new_n个元素，返回实际可用的元素个数
+     */
+    allocation_result<pointer> reallocate_at_least(pointer ptr, size_type old_n, size_type new_n)
+    {
+        pointer result = reallocate(ptr, old_n, new_n);
+        return {result, _usable_count(result, new_n)};
+    }
+
+protected:
+    static size_type _usable_count(pointer ptr, size_type n) noexcept
+    {
+#ifdef __GLIBC__
+        if (ptr != nullptr) {
+            size_type usable = ::malloc_usable_size(static_cast<void *>(ptr)) / sizeof(value_type);
+            return usable > n ? usable : n;
+        }
+#endif
+        (void)ptr;
+        return n;
+    }
+
+public:
+
+    template <typename U, typename... Args>
+    pointer construct(U * ptr, Args&&... args)
+    {
+        return static_cast<U *>(::new(ptr) U(std::forward<Args>(args)...));
+    }
+
+    template <typename U>
+    void destroy(U * ptr)
+    {
+        ptr->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<std::size_t>::max() / sizeof(value_type);
+    }
+
+    pointer address(reference r) const noexcept
+    {
+        return &r;
+    }
+
+    const_pointer address(const_reference r) const noexcept
+    {
+        return &r;
+    }
+
+    template <typename U>
+    bool operator==(const malloc_allocator<U> &) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const malloc_allocator<U> &) const noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief NUMA内存策略
+ * @details 对应mbind的模式，节点由节点掩码给出
+ */
+enum class numa_policy
+{
+    local,          // 不设置策略，由内核在首次访问的线程所在节点分配
+    bind,           // 只在掩码中的节点上分配
+    preferred,      // 优先在掩码中的第一个节点上分配
+    interleave      // 在掩码中的节点上按页交错分配
+};
+
+/**
+ * @brief 大页分配器
+ * @details 不小于阈值的分配直接使用按2MB对齐的匿名mmap，并用madvise(MADV_HUGEPAGE)请求透明大页，
+ *          可选地用mbind设置NUMA策略；小分配仍然使用operator new。
+ *          mbind失败(单节点机器、节点不存在、内核不支持)时忽略，分配照常成功。
+ *          deallocate必须传入与分配时相同的元素个数，用来区分两种来源
+ */
+template <class T>
+class huge_page_allocator
+{
+public:
+    // 嵌套类型
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+protected:
+    std::size_t _threshold;         // 使用mmap的最小字节数
+    numa_policy _policy;            // NUMA策略
+    unsigned long _node_mask;       // 策略使用的节点掩码，第i位表示节点i
+
+public:
+    huge_page_allocator() noexcept
+        : _threshold(huge_page_size), _policy(numa_policy::local), _node_mask(0)
+    {}
+
+    explicit huge_page_allocator(numa_policy policy, unsigned long node_mask = 1, std::size_t threshold = huge_page_size) noexcept
+        : _threshold(threshold), _policy(policy), _node_mask(node_mask)
+    {}
+
+    huge_page_allocator(const huge_page_allocator & other) noexcept = default;
+
+    template <typename U>
+    huge_page_allocator(const huge_page_allocator<U> & other) noexcept
+        : _threshold(other.threshold()), _policy(other.policy()), _node_mask(other.node_mask())
+    {}
+
+    ~huge_page_allocator() = default;
+
+    template <typename U>
+    class rebind
+    {
+    public:
+        using other = huge_page_allocator<U>;
+    };
+
+    pointer allocate(size_type n, const void * hint = nullptr)
+    {
+        (void)hint;
+        return allocate_at_least(n).ptr;
+    }
+
+    /**
+     * @brief 分配至少n个元素的内存
+     * @details 大分配按大页取整，多出的部分作为可用元素返回
+     */
+    allocation_result<pointer> allocate_at_least(size_type n)
+    {
+        if (n > max_size())
+            throw std::bad_array_new_length();
+        if (n == 0)
+            return {nullptr, 0};
+        std::size_t bytes = n * sizeof(value_type);
+        if (!_use_map(bytes)) {
+            return {static_cast<pointer>(::operator new(bytes)), n};
+        }
+        std::size_t length = _map_length(bytes);
+        return {static_cast<pointer>(_map(length)), length / sizeof(value_type)};
+    }
+
+    void deallocate(pointer ptr, size_type n)
+    {
+        if (ptr == nullptr) return;
+        std::size_t bytes = n * sizeof(value_type);
+        if (!_use_map(bytes)) {
+            ::operator delete(ptr);
+            return;
+        }
+        _unmap(ptr, _map_length(bytes));
+    }
+
+    template <typename U, typename... Args>
+    pointer construct(U * ptr, Args&&... args)
+    {
+        return static_cast<U *>(::new(ptr) U(std::forward<Args>(args)...));
+    }
+
+    template <typename U>
+    void destroy(U * ptr)
+    {
+        ptr->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<std::size_t>::max() / 2 / sizeof(value_type);
+    }
+
+    std::size_t threshold() const noexcept
+    {
+        return _threshold;
+    }
+
+    numa_policy policy() const noexcept
+    {
+        return _policy;
+    }
+
+    unsigned long node_mask() const noexcept
+    {
+        return _node_mask;
+    }
+
+    template <typename U>
+    bool operator==(const huge_page_allocator<U> & other) const noexcept
+    {
+        return _threshold == other.threshold() && _policy == other.policy() && _node_mask == other.node_mask();
+    }
+
+    template <typename U>
+    bool operator!=(const huge_page_allocator<U> & other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+protected:
+    bool _use_map(std::size_t bytes) const noexcept
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "huge_page_allocator does not support over-aligned types");
+        return bytes >= _threshold;
+    }
+
+    static std::size_t _map_length(std::size_t bytes) noexcept
+    {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+#ifdef __linux__
+    /**
+     * @brief 映射length字节按大页对齐的匿名内存
+     * @details 多映射一个大页，再把首尾多余的部分解除映射
+     */
+    void * _map(std::size_t length) const
+    {
+        void * raw = ::mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            throw std::bad_alloc();
+        std::size_t address = reinterpret_cast<std::size_t>(raw);
+        std::size_t aligned = (address + huge_page_size - 1) & ~(huge_page_size - 1);
+        if (aligned != address) {
+            ::munmap(raw, aligned - address);
+        }
+        std::size_t tail = address + length + huge_page_size - (aligned + length);
+        if (tail != 0) {
+            ::munmap(reinterpret_cast<void *>(aligned + length), tail);
+        }
+        void * ptr = reinterpret_cast<void *>(aligned);
+#ifdef MADV_HUGEPAGE
+        ::madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+        _bind(ptr, length);
+        return ptr;
+    }
+
+    static void _unmap(void * ptr, std::size_t length) noexcept
+    {
+        ::munmap(ptr, length);
+    }
+
+    /**
+     * @brief 设置NUMA策略，在页面被首次访问之前调用才有效
+     */
+    void _bind(void * ptr, std::size_t length) const noexcept
+    {
+#ifdef SYS_mbind
+        if (_policy == numa_policy::local || _node_mask == 0) {
+            return;
+        }
+        int mode = _policy == numa_policy::bind ? 2 : _policy == numa_policy::preferred ? 1 : 3;   // MPOL_BIND、MPOL_PREFERRED、MPOL_INTERLEAVE
+        unsigned long mask = _node_mask;
+        ::syscall(SYS_mbind, ptr, length, mode, &mask, sizeof(mask) * 8 + 1, 0);
+#else
+        (void)ptr;
+        (void)length;
+#endif
+    }
+#else
+    void * _map(std::size_t length) const
+    {
+        return ::operator new(length);
+    }
+
+    static void _unmap(void * ptr, std::size_t) noexcept
+    {
+        ::operator delete(ptr);
+    }
+#endif
+};
+
+/**
+ * @brief 按Alignment字节对齐的分配器
+ * @details 使用对齐版本的operator new（C++17之前退而多申请内存再对齐），返回的地址都是Alignment的整数倍，
+ *          SIMD循环可以直接使用对齐加载而不需要处理开头未对齐的部分
+ */
+template <class T, std::size_t Alignment = 64>
+class aligned_allocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "alignment must not be weaker than alignof(T)");
+
+public:
+    // 嵌套类型
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment = Alignment;
+
+public:
+    aligned_allocator() noexcept = default;
+
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept
+    {}
+
+    template <class U>
+    class rebind
+    {
+    public:
+        // 元素类型要求更严格的对齐时取两者中较大的
+        using other = aligned_allocator<U, (Alignment > alignof(U) ? Alignment : alignof(U))>;
+    };
+
+    pointer allocate(size_type n, const void * hint = nullptr)
+    {
+        (void)hint;
+        if (n > max_size())
+            throw std::bad_array_new_length();
+        return n == 0 ? nullptr : static_cast<pointer>(_aligned_new(n * sizeof(value_type)));
+    }
+
+    void deallocate(pointer ptr, size_type n = 0)
+    {
+        (void)n;
+        if (ptr == nullptr) return;
+        _aligned_delete(static_cast<void *>(ptr));
+    }
+
+    template <class U, class... Args>
+    U * construct(U * ptr, Args&&... args)
+    {
+        return static_cast<U *>(::new(ptr) U(std::forward<Args>(args)...));
+    }
+
+    template <class U>
+    void destroy(U * ptr)
+    {
+        ptr->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<std::size_t>::max() / sizeof(value_type);
+    }
+
+    bool operator==(const aligned_allocator &) const noexcept
+    {
+        return true;
+    }
+
+    bool operator!=(const aligned_allocator &) const noexcept
+    {
+        return false;
+    }
+
+private:
+#ifdef __cpp_aligned_new
+    static void * _aligned_new(std::size_t bytes)
+    {
+        return ::operator new(bytes, std::align_val_t(Alignment));
+    }
+
+    static void _aligned_delete(void * ptr)
+    {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+#else
+    /**
+     * @brief 没有对齐版本的operator new时多申请一些内存，在其中取对齐的地址
+     * @details 对齐地址之前保存operator new返回的原始地址，释放时取回
+     */
+    static void * _aligned_new(std::size_t bytes)
+    {
+        const std::size_t extra = Alignment - 1 + sizeof(void *);
+        if (bytes > std::numeric_limits<std::size_t>::max() - extra)
+            throw std::bad_alloc();
+        void * raw = ::operator new(bytes + extra);
+        std::size_t address = reinterpret_cast<std::size_t>(raw) + sizeof(void *);
+        void * aligned = reinterpret_cast<void *>((address + Alignment - 1) & ~(Alignment - 1));
+        std::memcpy(static_cast<char *>(aligned) - sizeof(void *), &raw, sizeof(void *));
+        return aligned;
+    }
+
+    static void _aligned_delete(void * ptr)
+    {
+        void * raw;
+        std::memcpy(&raw, static_cast<char *>(ptr) - sizeof(void *), sizeof(void *));
+        ::operator delete(raw);
+    }
+#endif
+};
+
+/**
+ * @brief 告诉编译器ptr按N字节对齐
+ * @link https://zh.cppreference.com/w/cpp/memory/assume_aligned
+ * @details 调用者保证对齐，否则行为未定义
+ */
+template <std::size_t N, class T>
+inline T * assume_aligned(T * ptr) noexcept
+{
+    static_assert((N & (N - 1)) == 0, "alignment must be a power of two");
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T *>(__builtin_assume_aligned(ptr, N));
+#else
+    return ptr;
+#endif
+}
+
+/**
+ * @brief 分配器保证的对齐字节数
+ * @details 分配器声明了alignment时取该值，否则只保证alignof(value_type)
+ */
+template <class Alloc, class = void>
+class __allocator_alignment
+    : public std::integral_constant<std::size_t, alignof(typename Alloc::value_type)>
+{};
+
+template <class Alloc>
+class __allocator_alignment<Alloc, decltype((void)Alloc::alignment)>
+    : public std::integral_constant<std::size_t, Alloc::alignment>
+{};
+
+/**
+ * @brief 判断分配器是否提供reallocate(ptr, old_n, new_n)
+ */
+template <class Alloc, class = void>
+class __has_reallocate
+    : public std::false_type
+{};
+
+template <class Alloc>
+class __has_reallocate<Alloc, decltype((void)std::declval<Alloc &>().reallocate(
+    std::declval<typename Alloc::pointer>(), std::size_t(), std::size_t()))>
+    : public std::true_type
+{};
+
+template <class Alloc, class = void>
+class __has_allocate_at_least
+    : public std::false_type
+{};
+
+template <class Alloc>
+class __has_allocate_at_least<Alloc, decltype((void)std::declval<Alloc &>().allocate_at_least(std::size_t()))>
+    : public std::true_type
+{};
+
+template <class Alloc, class = void>
+class __has_reallocate_at_least
+    : public std::false_type
+{};
+
+template <class Alloc>
+class __has_reallocate_at_least<Alloc, decltype((void)std::declval<Alloc &>().reallocate_at_least(
+    std::declval<typename Alloc::pointer>(), std::size_t(), std::size_t()))>
+    : public std::true_type
+{};
+
+/**
+ * @brief 分配至少n个元素的内存
+ * @details 分配器提供allocate_at_least时返回实际可用的元素个数，否则就是n。
+ *          之后必须用返回的个数释放这块内存
+ */
+template <class Alloc>
+allocation_result<typename Alloc::pointer> __allocate_at_least(Alloc & alloc, std::size_t n, std::true_type)
+{
+    return alloc.allocate_at_least(n);
+}
+
+template <class Alloc>
+allocation_result<typename Alloc::pointer> __allocate_at_least(Alloc & alloc, std::size_t n, std::false_type)
+{
+    return {alloc.allocate(n), n};
+}
+
+template <class Alloc>
+allocation_result<typename Alloc::pointer> __allocate_at_least(Alloc & alloc, std::size_t n)
+{
+    return __allocate_at_least(alloc, n, __has_allocate_at_least<Alloc>());
+}
+
+/**
+ * @brief 把已分配的内存调整为至少new_n个元素，分配器需要提供reallocate
+ */
+template <class Alloc>
+allocation_result<typename Alloc::pointer> __reallocate_at_least(Alloc & alloc, typename Alloc::pointer ptr,
+                                                                 std::size_t old_n, std::size_t new_n, std::true_type)
+{
+    return alloc.reallocate_at_least(ptr, old_n, new_n);
+}
+
+template <class Alloc>
+allocation_result<typename Alloc::pointer> __reallocate_at_least(Alloc & alloc, typename Alloc::pointer ptr,
+                                                                 std::size_t old_n, std::size_t new_n, std::false_type)
+{
+    return {alloc.reallocate(ptr, old_n, new_n), new_n};
+}
+
+template <class Alloc>
+allocation_result<typename Alloc::pointer> __reallocate_at_least(Alloc & alloc, typename Alloc::pointer ptr,
+                                                                 std::size_t old_n, std::size_t new_n)
+{
+    return __reallocate_at_least(alloc, ptr, old_n, new_n, __has_reallocate_at_least<Alloc>());
+}
+
+template <class Alloc, class = void>
+class __has_select_on_copy
+    : public std::false_type
+{};
+
+template <class Alloc>
+class __has_select_on_copy<Alloc, decltype((void)std::declval<const Alloc &>().select_on_container_copy_construction())>
+    : public std::true_type
+{};
+
+/**
+ * @brief 拷贝构造容器时使用的分配器
+ * @details 分配器提供select_on_container_copy_construction时由它决定，否则直接拷贝
+ */
+template <class Alloc>
+Alloc __select_on_container_copy_construction(const Alloc & alloc, std::true_type)
+{
+    return alloc.select_on_container_copy_construction();
+}
+
+template <class Alloc>
+Alloc __select_on_container_copy_construction(const Alloc & alloc, std::false_type)
+{
+    return alloc;
+}
+
+template <class Alloc>
+Alloc __select_on_container_copy_construction(const Alloc & alloc)
+{
+    return __select_on_container_copy_construction(alloc, __has_select_on_copy<Alloc>());
+}
+
+/**
+ * @brief 判断类型是否可平凡重定位
+ * @details 可平凡重定位的对象可以用memcpy搬到新地址，并且不再对旧地址调用析构函数。
+ *          可平凡拷贝的类型都满足，其他类型可以特化本模板，或者声明嵌套类型
+ *          is_trivially_relocatable = std::true_type。
+ *          注意libstdc++的std::string和std::list持有指向自身的指针，不能平凡重定位
+ */
+template <class T, class = void>
+class is_trivially_relocatable
+    : public std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{};
+
+template <class T>
+class is_trivially_relocatable<T, typename std::enable_if<T::is_trivially_relocatable::value>::type>
+    : public std::true_type
+{};
+
+template <class T, class Deleter>
+class is_trivially_relocatable<std::unique_ptr<T, Deleter>>
+    : public is_trivially_relocatable<Deleter>
+{};
+
+template <class T>
+class is_trivially_relocatable<std::shared_ptr<T>>
+    : public std::true_type
+{};
+
+template <class T>
+class is_trivially_relocatable<std::weak_ptr<T>>
+    : public std::true_type
+{};
+
+/**
+ * @brief 在未初始化的[first, first + n)上默认初始化n个元素
+ * @details 平凡类型不写入内存；构造中途抛出异常会销毁已经构造的元素
+ */
+template <class T>
+T * __uninitialized_default_construct_n(T * first, std::size_t n)
+{
+    T * current = first;
+    try {
+        for (; n > 0; --n, ++current) {
+            ::new(static_cast<void *>(current)) T;
+        }
+    } catch (...) {
+        for (; first != current; ++first) {
+            first->~T();
+        }
+        throw;
+    }
+    return current;
+}
+
+/**
+ * @brief 把[first, last)的元素移动构造到未初始化的dest
+ * @details 移动构造可能抛出异常且可以拷贝时退而拷贝，保证失败时原元素不变；
+ *          构造中途抛出异常会销毁已经构造的元素
+ */
+template <class T>
+T * __uninitialized_move_if_noexcept(T * first, T * last, T * dest)
+{
+    T * current = dest;
+    try {
+        for (; first != last; ++first, ++current) {
+            ::new(static_cast<void *>(current)) T(std::move_if_noexcept(*first));
+        }
+    } catch (...) {
+        for (; dest != current; ++dest) {
+            dest->~T();
+        }
+        throw;
+    }
+    return current;
+}
+
+/**
+ * @brief 把[first, last)的元素重定位到未初始化的dest，之后原位置不再持有对象
+ * @details 可平凡重定位的类型只做一次memcpy，其他类型逐个移动后销毁原元素
+ */
+template <class T>
+T * __relocate(T * first, T * last, T * dest)
+{
+    if (is_trivially_relocatable<T>::value) {
+        if (first != last) {
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+        }
+        return dest + (last - first);
+    }
+    T * result = __uninitialized_move_if_noexcept(first, last, dest);
+    for (; first != last; ++first) {
+        first->~T();
+    }
+    return result;
+}
+
 /**
  * @brief allocator萃取机
  * @link https://zh.cppreference.com/w/cpp/memory/allocator_traits
@@ -0,0 +1,471 @@
+#ifndef __MMAP_VECTOR_H__
+#define __MMAP_VECTOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stl
+{
+
+/**
+ * @brief 文件映射方式
+ */
+enum class mmap_mode
+{
+    shared,         // MAP_SHARED，修改和扩容写回文件，文件不存在时创建
+    private_copy    // MAP_PRIVATE，写时复制，修改和扩容都不影响文件，文件必须存在
+};
+
+/**
+ * @brief 映射文件的头部
+ * @details 元素个数保存在映射内存中，重新打开时直接读取，不需要扫描或反序列化
+ */
+class __mmap_vector_header
+{
+public:
+    char magic[8];                  // "STLMMVEC"
+    std::uint64_t element_size;     // sizeof(T)，打开时校验
+    std::uint64_t size;             // 元素个数
+};
+
+/**
+ * @brief 以文件为存储的vector
+ * @details 文件由64字节的头部和紧随其后的元素组成，文件长度决定容量。
+ *          打开已有文件只需要一次mmap，元素在首次访问时才由缺页读入；
+ *          扩容时用ftruncate加长文件，再用mremap扩大映射，映射的地址可能改变。
+ *          元素必须可平凡拷贝，不调用构造和析构函数
+ */
+template <class T>
+class mmap_vector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector requires trivially copyable elements");
+    static_assert(alignof(T) <= 64, "mmap_vector elements must not be aligned beyond 64 bytes");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    static constexpr std::size_t header_size = 64;
+
+protected:
+    int _fd;                            // 文件描述符，未打开时为-1
+    mmap_mode _mode;                    // 映射方式
+    void * _map;                        // 映射的起始地址，包括头部
+    std::size_t _map_length;            // 映射的字节数
+    bool _anonymous;                    // 私有映射扩容后改用匿名内存，不再对应文件
+
+public:
+    mmap_vector() noexcept
+        : _fd(-1), _mode(mmap_mode::shared), _map(nullptr), _map_length(0), _anonymous(false)
+    {}
+
+    explicit mmap_vector(const std::string & path, mmap_mode mode = mmap_mode::shared)
+        : mmap_vector()
+    {
+        open(path, mode);
+    }
+
+    mmap_vector(const mmap_vector &) = delete;
+
+    mmap_vector & operator=(const mmap_vector &) = delete;
+
+    mmap_vector(mmap_vector && other) noexcept
+        : _fd(other._fd), _mode(other._mode), _map(other._map), _map_length(other._map_length), _anonymous(other._anonymous)
+    {
+        other._fd = -1;
+        other._map = nullptr;
+        other._map_length = 0;
+    }
+
+    mmap_vector & operator=(mmap_vector && other) noexcept
+    {
+        if (this != &other) {
+            close();
+            std::swap(_fd, other._fd);
+            std::swap(_mode, other._mode);
+            std::swap(_map, other._map);
+            std::swap(_map_length, other._map_length);
+            std::swap(_anonymous, other._anonymous);
+        }
+        return *this;
+    }
+
+    ~mmap_vector()
+    {
+        close();
+    }
+
+public:
+    // 文件
+
+    /**
+     * @brief 打开或创建文件并映射
+     * @details 已有文件的头部必须有效且元素大小一致，否则抛出std::runtime_error
+     */
+    void open(const std::string & path, mmap_mode mode = mmap_mode::shared)
+    {
+        close();
+        _mode = mode;
+        _fd = ::open(path.c_str(), mode == mmap_mode::shared ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+        if (_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "mmap_vector: open " + path);
+        }
+        struct stat st;
+        if (::fstat(_fd, &st) != 0) {
+            _fail("fstat");
+        }
+        std::size_t length = static_cast<std::size_t>(st.st_size);
+        bool fresh = length == 0;
+        if (fresh) {
+            if (mode != mmap_mode::shared) {
+                _close_fd();
+                throw std::runtime_error("mmap_vector: " + path + " is empty");
+            }
+            length = header_size;
+            if (::ftruncate(_fd, static_cast<off_t>(length)) != 0) {
+                _fail("ftruncate");
+            }
+        }
+        if (length < header_size) {
+            _close_fd();
+            throw std::runtime_error("mmap_vector: " + path + " is not an mmap_vector file");
+        }
+        int flags = mode == mmap_mode::shared ? MAP_SHARED : MAP_PRIVATE;
+        void * map = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, _fd, 0);
+        if (map == MAP_FAILED) {
+            _fail("mmap");
+        }
+        _map = map;
+        _map_length = length;
+        _anonymous = false;
+        if (fresh) {
+            std::memcpy(_header()->magic, "STLMMVEC", 8);
+            _header()->element_size = sizeof(value_type);
+            _header()->size = 0;
+        } else if (std::memcmp(_header()->magic, "STLMMVEC", 8) != 0 || _header()->element_size != sizeof(value_type)
+                   || _header()->size > capacity()) {
+            close();
+            throw std::runtime_error("mmap_vector: " + path + " does not hold this element type");
+        }
+    }
+
+    /**
+     * @brief 解除映射并关闭文件
+     */
+    void close() noexcept
+    {
+        if (_map != nullptr) {
+            ::munmap(_map, _map_length);
+            _map = nullptr;
+            _map_length = 0;
+        }
+        _close_fd();
+        _anonymous = false;
+    }
+
+    bool is_open() const noexcept
+    {
+        return _map != nullptr;
+    }
+
+    /**
+     * @brief 把修改同步写回文件
+     */
+    void sync()
+    {
+        if (_map != nullptr && _mode == mmap_mode::shared && ::msync(_map, _map_length, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "mmap_vector: msync");
+        }
+    }
+
+    // 元素访问
+
+    reference at(size_type pos)
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("mmap_vector out of range");
+        }
+        return data()[pos];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("mmap_vector out of range");
+        }
+        return data()[pos];
+    }
+
+    reference operator[](size_type pos)
+    {
+        return data()[pos];
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return data()[pos];
+    }
+
+    reference front()
+    {
+        return data()[0];
+    }
+
+    const_reference front() const
+    {
+        return data()[0];
+    }
+
+    reference back()
+    {
+        return data()[size() - 1];
+    }
+
+    const_reference back() const
+    {
+        return data()[size() - 1];
+    }
+
+    pointer data() noexcept
+    {
+        return _map == nullptr ? nullptr : reinterpret_cast<pointer>(static_cast<char *>(_map) + header_size);
+    }
+
+    const_pointer data() const noexcept
+    {
+        return _map == nullptr ? nullptr : reinterpret_cast<const_pointer>(static_cast<const char *>(_map) + header_size);
+    }
+
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return data();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data();
+    }
+
+    iterator end() noexcept
+    {
+        return data() + size();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data() + size();
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _map == nullptr ? 0 : static_cast<size_type>(_header()->size);
+    }
+
+    size_type capacity() const noexcept
+    {
+        return _map == nullptr ? 0 : (_map_length - header_size) / sizeof(value_type);
+    }
+
+    void reserve(size_type new_cap)
+    {
+        if (new_cap > capacity()) {
+            _remap(new_cap);
+        }
+    }
+
+    /**
+     * @brief 把文件截短到元素实际占用的长度
+     */
+    void shrink_to_fit()
+    {
+        if (capacity() > size()) {
+            _remap(size());
+        }
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        if (_map != nullptr) {
+            _header()->size = 0;
+        }
+    }
+
+    void push_back(const value_type & value)
+    {
+        if (size() == capacity()) {
+            // value可能引用即将被重新映射的元素
+            value_type copy = value;
+            _grow(1);
+            data()[size()] = copy;
+        } else {
+            data()[size()] = value;
+        }
+        ++_header()->size;
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        push_back(value);
+        return back();
+    }
+
+    void pop_back()
+    {
+        _check_open();
+        --_header()->size;
+    }
+
+    /**
+     * @brief 修改元素个数，新元素清零
+     */
+    void resize(size_type count)
+    {
+        _check_open();
+        if (count > capacity()) {
+            _remap(count);
+        }
+        if (count > size()) {
+            std::memset(static_cast<void *>(data() + size()), 0, (count - size()) * sizeof(value_type));
+        }
+        _header()->size = count;
+    }
+
+    /**
+     * @brief 在尾部追加[first, last)的元素，最多扩容一次
+     */
+    void append(const_pointer first, const_pointer last)
+    {
+        _check_open();
+        size_type n = last - first;
+        if (n == 0) {
+            return;
+        }
+        if (size() + n > capacity()) {
+            // [first, last)可能在容器内部，重新映射后按偏移重新定位
+            const_pointer old_data = data();
+            bool inside = first >= old_data && first < old_data + size();
+            size_type offset = inside ? static_cast<size_type>(first - old_data) : 0;
+            _grow(n);
+            if (inside) {
+                first = data() + offset;
+            }
+        }
+        std::memcpy(static_cast<void *>(data() + size()), first, n * sizeof(value_type));
+        _header()->size += n;
+    }
+
+protected:
+    // 内部函数
+
+    __mmap_vector_header * _header() noexcept
+    {
+        return static_cast<__mmap_vector_header *>(_map);
+    }
+
+    const __mmap_vector_header * _header() const noexcept
+    {
+        return static_cast<const __mmap_vector_header *>(_map);
+    }
+
+    void _close_fd() noexcept
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    [[noreturn]] void _fail(const char * what)
+    {
+        int error = errno;
+        close();
+        throw std::system_error(error, std::generic_category(), std::string("mmap_vector: ") + what);
+    }
+
+    void _check_open() const
+    {
+        if (_map == nullptr) {
+            throw std::logic_error("mmap_vector is not open");
+        }
+    }
+
+    /**
+     * @brief 容纳extra个新元素，容量至少翻倍，最小一页
+     */
+    void _grow(size_type extra)
+    {
+        size_type cap = capacity() * 2;
+        size_type minimum = 4096 / sizeof(value_type) + 1;
+        if (cap < minimum) cap = minimum;
+        if (cap < size() + extra) cap = size() + extra;
+        _remap(cap);
+    }
+
+    /**
+     * @brief 把容量调整为new_cap
+     * @details 共享映射先调整文件长度再mremap；私有映射不能越过文件末尾，
+     *          第一次调整时把内容拷贝到匿名内存，之后对匿名内存mremap
+     */
+    void _remap(size_type new_cap)
+    {
+        _check_open();
+        std::size_t length = header_size + new_cap * sizeof(value_type);
+        if (_mode == mmap_mode::shared) {
+            if (::ftruncate(_fd, static_cast<off_t>(length)) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mmap_vector: ftruncate");
+            }
+        } else if (!_anonymous) {
+            void * map = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (map == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            std::memcpy(map, _map, header_size + size() * sizeof(value_type));
+            ::munmap(_map, _map_length);
+            _map = map;
+            _map_length = length;
+            _anonymous = true;
+            return;
+        }
+        void * map = ::mremap(_map, _map_length, length, MREMAP_MAYMOVE);
+        if (map == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap_vector: mremap");
+        }
+        _map = map;
+        _map_length = length;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,656 @@
+#ifndef __SEGMENTED_VECTOR_H__
+#define __SEGMENTED_VECTOR_H__
+
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+#include "memory.h"
+
+namespace stl
+{
+
+/**
+ * @brief 计算默认的分段大小
+ * @details 每段为2的幂个元素，大约占4KB，至少16个元素
+ */
+constexpr std::size_t __segmented_vector_shift(std::size_t element_size)
+{
+    std::size_t shift = 4;
+    while ((static_cast<std::size_t>(2) << shift) * element_size <= 4096) {
+        ++shift;
+    }
+    return shift;
+}
+
+/**
+ * @brief 分段存储的vector
+ * @details 和deque一样由中控器和固定大小的缓冲区组成，但只在尾部增长，且第一个元素总在第一段的开头，
+ *          因此下标访问只需要一次移位和一次按位与。增长时只申请新的段，已有元素从不移动，
+ *          指向元素的指针和引用在元素被删除之前一直有效；中控器重新分配时迭代器失效
+ * @param SegmentShift 每段有2^SegmentShift个元素
+ */
+template <class T, class Alloc = allocator<T>, std::size_t SegmentShift = __segmented_vector_shift(sizeof(T))>
+class segmented_vector
+{
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using map_pointer = value_type**;
+    using map_allocator_type = typename allocator_type::template rebind<pointer>::other;
+
+    static constexpr size_type segment_shift = SegmentShift;
+    static constexpr size_type segment_size = static_cast<size_type>(1) << SegmentShift;
+    static constexpr size_type segment_mask = segment_size - 1;
+
+    /**
+     * @brief 分段vector的迭代器
+     * @details 结束位置落在尚未申请的段上时，_first和_cur都是空指针
+     */
+    template <class Ref, class Ptr>
+    class __segmented_iterator
+    {
+    public:
+        using value_type = T;
+        using reference = Ref;
+        using pointer = Ptr;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+    protected:
+        Ptr _cur;               // 当前指向的元素
+        Ptr _first;             // 当前段的第一个元素
+        map_pointer _node;      // 当前段在中控器中的位置
+
+        using self = __segmented_iterator;
+        friend class segmented_vector;
+        template <class, class> friend class __segmented_iterator;
+
+    public:
+        __segmented_iterator() noexcept
+            : _cur(nullptr), _first(nullptr), _node(nullptr)
+        {}
+
+        __segmented_iterator(map_pointer node, size_type offset) noexcept
+            : _cur(nullptr), _first(nullptr), _node(node)
+        {
+            if (_node != nullptr) {
+                _first = *_node;
+                _cur = _first + offset;
+            }
+        }
+
+        /**
+         * @brief iterator转换为const_iterator
+         */
+        template <class OtherRef, class OtherPtr,
+                  class = typename std::enable_if<std::is_convertible<OtherPtr, Ptr>::value>::type>
+        __segmented_iterator(const __segmented_iterator<OtherRef, OtherPtr> & other) noexcept
+            : _cur(other._cur), _first(other._first), _node(other._node)
+        {}
+
+        reference operator*() const
+        {
+            return *_cur;
+        }
+
+        pointer operator->() const
+        {
+            return _cur;
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        self & operator++()
+        {
+            ++_cur;
+            if (static_cast<size_type>(_cur - _first) == segment_size) {
+                // 到达段的末尾，移动到下一段
+                _set_node(_node + 1);
+            }
+            return *this;
+        }
+
+        self operator++(int)
+        {
+            self temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        self & operator--()
+        {
+            if (_cur == _first) {
+                // 位于段的开头，移动到上一段的末尾
+                _set_node(_node - 1);
+                _cur = _first + segment_size;
+            }
+            --_cur;
+            return *this;
+        }
+
+        self operator--(int)
+        {
+            self temp = *this;
+            --*this;
+            return temp;
+        }
+
+        self & operator+=(difference_type n)
+        {
+            if (n == 0) {
+                // 空容器的迭代器没有可以读取的中控器
+                return *this;
+            }
+            // 段的大小是2的幂，算术右移对负偏移同样向下取整
+            difference_type offset = (_cur - _first) + n;
+            _set_node(_node + (offset >> segment_shift));
+            _cur = _first + (offset & static_cast<difference_type>(segment_mask));
+            return *this;
+        }
+
+        self & operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        self operator+(difference_type n) const
+        {
+            self temp = *this;
+            return temp += n;
+        }
+
+        friend self operator+(difference_type n, const self & it)
+        {
+            return it + n;
+        }
+
+        self operator-(difference_type n) const
+        {
+            self temp = *this;
+            return temp -= n;
+        }
+
+        template <class OtherRef, class OtherPtr>
+        difference_type operator-(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return (_node - other._node) * static_cast<difference_type>(segment_size) + (_cur - _first) - (other._cur - other._first);
+        }
+
+        template <class OtherRef, class OtherPtr>
+        bool operator==(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return _node == other._node && _cur == other._cur;
+        }
+
+        template <class OtherRef, class OtherPtr>
+        bool operator!=(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return !(*this == other);
+        }
+
+        template <class OtherRef, class OtherPtr>
+        bool operator<(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return _node == other._node ? _cur < other._cur : _node < other._node;
+        }
+
+        template <class OtherRef, class OtherPtr>
+        bool operator>(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return other < *this;
+        }
+
+        template <class OtherRef, class OtherPtr>
+        bool operator<=(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return !(other < *this);
+        }
+
+        template <class OtherRef, class OtherPtr>
+        bool operator>=(const __segmented_iterator<OtherRef, OtherPtr> & other) const
+        {
+            return !(*this < other);
+        }
+
+    protected:
+        void _set_node(map_pointer node) noexcept
+        {
+            _node = node;
+            _first = *node;
+            _cur = _first;
+        }
+    };
+
+    using iterator = __segmented_iterator<reference, pointer>;
+    using const_iterator = __segmented_iterator<const_reference, const_pointer>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+protected:
+    map_pointer _map;                   // 中控器，[_segments, _map_size)始终为空指针
+    size_type _map_size;                // 中控器大小
+    size_type _segments;                // 已经申请的段数
+    size_type _size;                    // 元素个数
+
+    allocator_type allocator;           // 元素分配器
+    map_allocator_type map_allocator;   // 中控器分配器
+
+public:
+    // 构造函数
+
+    segmented_vector()
+        : _map(nullptr), _map_size(0), _segments(0), _size(0)
+    {}
+
+    explicit segmented_vector(const allocator_type & alloc)
+        : _map(nullptr), _map_size(0), _segments(0), _size(0), allocator(alloc), map_allocator(alloc)
+    {}
+
+    explicit segmented_vector(size_type count, const value_type & value = value_type(), const allocator_type & alloc = allocator_type())
+        : segmented_vector(alloc)
+    {
+        resize(count, value);
+    }
+
+    segmented_vector(std::initializer_list<value_type> ilist, const allocator_type & alloc = allocator_type())
+        : segmented_vector(alloc)
+    {
+        reserve(ilist.size());
+        for (const value_type & value : ilist) {
+            push_back(value);
+        }
+    }
+
+    segmented_vector(const segmented_vector & other)
+        : segmented_vector(other.allocator)
+    {
+        reserve(other.size());
+        for (const value_type & value : other) {
+            push_back(value);
+        }
+    }
+
+    segmented_vector(segmented_vector && other) noexcept
+        : segmented_vector(other.allocator)
+    {
+        swap(other);
+    }
+
+    ~segmented_vector()
+    {
+        clear();
+        __release_segments(0);
+        __deallocate_map();
+    }
+
+    segmented_vector & operator=(const segmented_vector & other)
+    {
+        if (this != &other) {
+            segmented_vector temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    segmented_vector & operator=(segmented_vector && other) noexcept
+    {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+public:
+    // 小工具
+
+    allocator_type get_allocator() const
+    {
+        return allocator;
+    }
+
+    // 元素访问
+
+    reference at(size_type pos)
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("segmented_vector out of range");
+        }
+        return (*this)[pos];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("segmented_vector out of range");
+        }
+        return (*this)[pos];
+    }
+
+    reference operator[](size_type pos)
+    {
+        return _map[pos >> segment_shift][pos & segment_mask];
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return _map[pos >> segment_shift][pos & segment_mask];
+    }
+
+    reference front()
+    {
+        return _map[0][0];
+    }
+
+    const_reference front() const
+    {
+        return _map[0][0];
+    }
+
+    reference back()
+    {
+        return (*this)[_size - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[_size - 1];
+    }
+
+    /**
+     * @brief 第n段的起始地址，每段有segment_size个连续元素
+     */
+    pointer segment_data(size_type n) noexcept
+    {
+        return _map[n];
+    }
+
+    const_pointer segment_data(size_type n) const noexcept
+    {
+        return _map[n];
+    }
+
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return iterator(_map, 0);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_map, 0);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return _map == nullptr ? iterator() : iterator(_map + (_size >> segment_shift), _size & segment_mask);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _map == nullptr ? const_iterator() : const_iterator(_map + (_size >> segment_shift), _size & segment_mask);
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+    }
+
+    size_type capacity() const noexcept
+    {
+        return _segments << segment_shift;
+    }
+
+    /**
+     * @brief 已经申请的段数
+     */
+    size_type segment_count() const noexcept
+    {
+        return _segments;
+    }
+
+    /**
+     * @brief 预留空间，只申请新的段，不移动已有元素
+     */
+    void reserve(size_type new_cap)
+    {
+        if (new_cap > max_size()) {
+            throw std::length_error("segmented_vector reserve too large");
+        }
+        size_type need = (new_cap + segment_mask) >> segment_shift;
+        while (_segments < need) {
+            __add_segment();
+        }
+    }
+
+    /**
+     * @brief 逐段释放没有元素的段
+     */
+    void shrink_to_fit()
+    {
+        __release_segments((_size + segment_mask) >> segment_shift);
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        while (_size != 0) {
+            pop_back();
+        }
+    }
+
+    void push_back(const value_type & value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(value_type && value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (_size == capacity()) {
+            // 旧元素不会移动，args引用容器内的元素也是安全的
+            __add_segment();
+        }
+        pointer p = _map[_size >> segment_shift] + (_size & segment_mask);
+        allocator.construct(p, std::forward<Args>(args)...);
+        ++_size;
+        return *p;
+    }
+
+    void pop_back()
+    {
+        --_size;
+        allocator.destroy(_map[_size >> segment_shift] + (_size & segment_mask));
+    }
+
+    void resize(size_type count)
+    {
+        __resize(count);
+    }
+
+    void resize(size_type count, const value_type & value)
+    {
+        __resize(count, value);
+    }
+
+    void swap(segmented_vector & other) noexcept
+    {
+        std::swap(_map, other._map);
+        std::swap(_map_size, other._map_size);
+        std::swap(_segments, other._segments);
+        std::swap(_size, other._size);
+        std::swap(allocator, other.allocator);
+        std::swap(map_allocator, other.map_allocator);
+    }
+
+protected:
+    // 内部函数
+
+    /**
+     * @brief 申请一个段的内存
+     */
+    pointer __allocate_node()
+    {
+        return allocator.allocate(segment_size);
+    }
+
+    /**
+     * @brief 释放一个段的内存
+     */
+    void __deallocate_node(pointer p)
+    {
+        allocator.deallocate(p, segment_size);
+    }
+
+    /**
+     * @brief 释放中控器内存
+     */
+    void __deallocate_map()
+    {
+        if (_map != nullptr) {
+            map_allocator.deallocate(_map, _map_size);
+            _map = nullptr;
+            _map_size = 0;
+        }
+    }
+
+    /**
+     * @brief 在尾部追加一个段
+     */
+    void __add_segment()
+    {
+        __reserve_map_at_back();
+        _map[_segments] = __allocate_node();
+        ++_segments;
+    }
+
+    /**
+     * @brief 保证中控器在已有的段之后至少还有n + 1个位置
+     * @details 多出的一个位置始终为空指针，结束迭代器落在未申请的段上时需要读取它。
+     *          重新分配中控器只拷贝段指针，元素不移动
+     */
+    void __reserve_map_at_back(size_type n = 1)
+    {
+        if (_segments + n + 1 <= _map_size) {
+            return;
+        }
+        size_type new_map_size = std::max(_map_size * 2, _segments + n + 1);
+        new_map_size = std::max(new_map_size, static_cast<size_type>(8));
+        map_pointer new_map = map_allocator.allocate(new_map_size);
+        if (_map != nullptr) {
+            std::copy(_map, _map + _segments, new_map);
+        }
+        std::fill(new_map + _segments, new_map + new_map_size, nullptr);
+        __deallocate_map();
+        _map = new_map;
+        _map_size = new_map_size;
+    }
+
+    /**
+     * @brief 释放第keep段之后的所有段，这些段中不能有元素
+     */
+    void __release_segments(size_type keep)
+    {
+        while (_segments > keep) {
+            --_segments;
+            __deallocate_node(_map[_segments]);
+            _map[_segments] = nullptr;
+        }
+    }
+
+    template <class... Args>
+    void __resize(size_type count, const Args&... args)
+    {
+        if (count < _size) {
+            while (_size != count) {
+                pop_back();
+            }
+            return;
+        }
+        reserve(count);
+        while (_size != count) {
+            emplace_back(args...);
+        }
+    }
+};
+
+template <class T, class Alloc, std::size_t SegmentShift>
+bool operator==(const segmented_vector<T, Alloc, SegmentShift> & lhs, const segmented_vector<T, Alloc, SegmentShift> & rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc, std::size_t SegmentShift>
+bool operator!=(const segmented_vector<T, Alloc, SegmentShift> & lhs, const segmented_vector<T, Alloc, SegmentShift> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc, std::size_t SegmentShift>
+void swap(segmented_vector<T, Alloc, SegmentShift> & lhs, segmented_vector<T, Alloc, SegmentShift> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+}
+
+#endif
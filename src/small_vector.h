@@ -0,0 +1,300 @@
+#ifndef __SMALL_VECTOR_H__
+#define __SMALL_VECTOR_H__
+
+#include "vector.h"
+
+namespace stl
+{
+
+/**
+ * @brief 自带N个元素内联空间的分配器
+ * @details 请求不超过N个元素且内联空间空闲时返回内联空间，否则交给Alloc。
+ *          内联空间属于分配器对象本身，拷贝得到的分配器拥有自己的空内联空间
+ */
+template <class T, std::size_t N, class Alloc = stl::allocator<T>>
+class __small_vector_allocator
+{
+public:
+    // 嵌套类型
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+    using heap_allocator = typename Alloc::template rebind<T>::other;
+
+protected:
+    alignas(T) unsigned char _buffer[N * sizeof(T)];     // 内联空间
+    bool _inline_used;                                  // 内联空间是否已经交出
+    heap_allocator _heap;                               // 超出内联空间时使用的分配器
+
+public:
+    __small_vector_allocator() noexcept
+        : _inline_used(false), _heap()
+    {}
+
+    __small_vector_allocator(const __small_vector_allocator & other) noexcept
+        : _inline_used(false), _heap(other._heap)
+    {}
+
+    template <class U, std::size_t M, class OtherAlloc>
+    __small_vector_allocator(const __small_vector_allocator<U, M, OtherAlloc> & other) noexcept
+        : _inline_used(false), _heap(other.heap())
+    {}
+
+    /**
+     * @brief 内联空间不随赋值转移
+     */
+    __small_vector_allocator & operator=(const __small_vector_allocator &) noexcept
+    {
+        return *this;
+    }
+
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = __small_vector_allocator<U, N, typename Alloc::template rebind<U>::other>;
+    };
+
+    pointer allocate(size_type n, const void * hint = nullptr)
+    {
+        if (n != 0 && n <= N && !_inline_used) {
+            _inline_used = true;
+            return inline_data();
+        }
+        return _heap.allocate(n, hint);
+    }
+
+    void deallocate(pointer ptr, size_type n = 0)
+    {
+        if (ptr == inline_data()) {
+            _inline_used = false;
+            return;
+        }
+        _heap.deallocate(ptr, n);
+    }
+
+    template <typename U, typename... Args>
+    pointer construct(U * ptr, Args&&... args)
+    {
+        return static_cast<U *>(::new(ptr) U(std::forward<Args>(args)...));
+    }
+
+    template <typename U>
+    void destroy(U * ptr)
+    {
+        ptr->~U();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return _heap.max_size();
+    }
+
+    pointer inline_data() noexcept
+    {
+        return reinterpret_cast<pointer>(_buffer);
+    }
+
+    const_pointer inline_data() const noexcept
+    {
+        return reinterpret_cast<const_pointer>(_buffer);
+    }
+
+    const heap_allocator & heap() const noexcept
+    {
+        return _heap;
+    }
+
+    bool operator==(const __small_vector_allocator & other) const noexcept
+    {
+        return this == &other;
+    }
+
+    bool operator!=(const __small_vector_allocator & other) const noexcept
+    {
+        return this != &other;
+    }
+};
+
+/**
+ * @brief 带内联空间的vector
+ * @details 接口和迭代器与vector相同，最多N个元素存放在对象内部，
+ *          超过N个元素才向Alloc申请堆内存。元素在内联空间中时，移动和交换需要逐个搬移元素
+ */
+template <class T, std::size_t N, class Alloc = stl::allocator<T>>
+class small_vector
+    : public stl::vector<T, __small_vector_allocator<T, N, Alloc>>
+{
+    static_assert(N > 0, "small_vector needs at least one inline element");
+
+public:
+    using base = stl::vector<T, __small_vector_allocator<T, N, Alloc>>;
+    using value_type = typename base::value_type;
+    using size_type = typename base::size_type;
+    using pointer = typename base::pointer;
+    using iterator = typename base::iterator;
+    using const_iterator = typename base::const_iterator;
+    using allocator_type = typename base::allocator_type;
+
+    static constexpr size_type inline_capacity = N;
+
+protected:
+    using base::start;
+    using base::finish;
+    using base::end_of_storage;
+    using base::allocator;
+
+public:
+    small_vector()
+        : base()
+    {
+        _use_inline();
+    }
+
+    small_vector(std::initializer_list<value_type> ilist)
+        : base()
+    {
+        _use_inline();
+        base::insert(base::end(), ilist);
+    }
+
+    small_vector(const small_vector & other)
+        : base()
+    {
+        _use_inline();
+        base::insert(base::end(), other.begin(), other.end());
+    }
+
+    small_vector(small_vector && other)
+        : base()
+    {
+        _use_inline();
+        _take(other);
+    }
+
+    ~small_vector() = default;
+
+    small_vector & operator=(const small_vector & other)
+    {
+        if (this != &other) {
+            base::clear();
+            base::insert(base::end(), other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    small_vector & operator=(small_vector && other)
+    {
+        if (this != &other) {
+            _release();
+            _use_inline();
+            _take(other);
+        }
+        return *this;
+    }
+
+public:
+    /**
+     * @brief 元素是否存放在内联空间
+     */
+    bool is_inline() const noexcept
+    {
+        return start == allocator.inline_data();
+    }
+
+    /**
+     * @brief 释放不使用的空间
+     * @details 元素放得下时搬回内联空间
+     */
+    void shrink_to_fit()
+    {
+        if (is_inline() || base::size() == base::capacity()) {
+            return;
+        }
+        if (base::size() > N) {
+            base::shrink_to_fit();
+            return;
+        }
+        pointer old_start = start;
+        size_type old_size = base::size();
+        size_type old_cap = base::capacity();
+        pointer inline_start = allocator.allocate(N);
+        stl::__relocate(old_start, finish, inline_start);
+        allocator.deallocate(old_start, old_cap);
+        start = inline_start;
+        finish = inline_start + old_size;
+        end_of_storage = inline_start + N;
+    }
+
+    void swap(small_vector & other)
+    {
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(start, other.start);
+            std::swap(finish, other.finish);
+            std::swap(end_of_storage, other.end_of_storage);
+            return;
+        }
+        small_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+protected:
+    // 内部函数
+
+    /**
+     * @brief 空vector以内联空间作为初始容量
+     */
+    void _use_inline()
+    {
+        base::reserve(N);
+    }
+
+    /**
+     * @brief 销毁所有元素并归还空间
+     */
+    void _release()
+    {
+        base::clear();
+        allocator.deallocate(start, base::capacity());
+        start = finish = end_of_storage = nullptr;
+    }
+
+    /**
+     * @brief 接管other的元素，调用前本对象为空
+     * @details other在堆上时直接接管指针，在内联空间时逐个搬移元素
+     */
+    void _take(small_vector & other)
+    {
+        if (!other.is_inline() && other.start != nullptr) {
+            _release();
+            start = other.start;
+            finish = other.finish;
+            end_of_storage = other.end_of_storage;
+            other.start = other.finish = other.end_of_storage = nullptr;
+            other._use_inline();
+            return;
+        }
+        // 本对象为空，容量至少为N，放得下other的所有元素
+        finish = stl::__relocate(other.start, other.finish, start);
+        other.finish = other.start;
+    }
+};
+
+template <class T, std::size_t N, class Alloc>
+void swap(small_vector<T, N, Alloc> & lhs, small_vector<T, N, Alloc> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+}
+
+#endif
@@ -0,0 +1,664 @@
+#ifndef __SOA_VECTOR_H__
+#define __SOA_VECTOR_H__
+
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+#include <memory>
+#include "memory.h"
+#include "vector.h"
+
+namespace stl
+{
+
+/**
+ * @brief 结构数组（SoA）形式的vector
+ * @details 每个字段存放在各自连续的数组中，所有数组位于同一块内存，起始地址按64字节对齐，
+ *          只扫描少数字段时不会把其他字段读入缓存。下标访问和迭代器返回由各字段引用组成的std::tuple，
+ *          可以用std::get或结构化绑定取出字段；data<I>()返回第I个字段的数组，适合向量化的循环。
+ *          容量增长使用vector的增长策略
+ */
+template <class... Ts>
+class soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one field");
+
+public:
+    using value_type = std::tuple<Ts...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+    using growth_policy = stl::double_growth_policy;
+
+    template <std::size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+
+    static constexpr std::size_t field_count = sizeof...(Ts);
+    static constexpr std::size_t alignment = std::max({static_cast<std::size_t>(64), alignof(Ts)...});
+
+    /**
+     * @brief 同时遍历所有字段的迭代器
+     * @details 解引用得到由字段引用组成的代理对象，不能取得指向整个元素的指针
+     */
+    template <bool Const>
+    class __soa_iterator
+    {
+    public:
+        using value_type = std::tuple<Ts...>;
+        using reference = typename std::conditional<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>::type;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+        using owner_pointer = typename std::conditional<Const, const soa_vector *, soa_vector *>::type;
+
+    protected:
+        owner_pointer _owner;       // 所属的容器
+        difference_type _index;     // 元素下标
+
+        using self = __soa_iterator;
+        friend class soa_vector;
+        friend class __soa_iterator<!Const>;
+
+    public:
+        __soa_iterator() noexcept
+            : _owner(nullptr), _index(0)
+        {}
+
+        __soa_iterator(owner_pointer owner, difference_type index) noexcept
+            : _owner(owner), _index(index)
+        {}
+
+        /**
+         * @brief iterator转换为const_iterator
+         */
+        template <bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+        __soa_iterator(const __soa_iterator<OtherConst> & other) noexcept
+            : _owner(other._owner), _index(other._index)
+        {}
+
+        reference operator*() const
+        {
+            return (*_owner)[static_cast<size_type>(_index)];
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return (*_owner)[static_cast<size_type>(_index + n)];
+        }
+
+        self & operator++() noexcept
+        {
+            ++_index;
+            return *this;
+        }
+
+        self operator++(int) noexcept
+        {
+            self temp = *this;
+            ++_index;
+            return temp;
+        }
+
+        self & operator--() noexcept
+        {
+            --_index;
+            return *this;
+        }
+
+        self operator--(int) noexcept
+        {
+            self temp = *this;
+            --_index;
+            return temp;
+        }
+
+        self & operator+=(difference_type n) noexcept
+        {
+            _index += n;
+            return *this;
+        }
+
+        self & operator-=(difference_type n) noexcept
+        {
+            _index -= n;
+            return *this;
+        }
+
+        self operator+(difference_type n) const noexcept
+        {
+            return self(_owner, _index + n);
+        }
+
+        friend self operator+(difference_type n, const self & it) noexcept
+        {
+            return it + n;
+        }
+
+        self operator-(difference_type n) const noexcept
+        {
+            return self(_owner, _index - n);
+        }
+
+        template <bool OtherConst>
+        difference_type operator-(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index - other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator==(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index == other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator!=(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index != other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator<(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index < other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator>(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index > other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator<=(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index <= other._index;
+        }
+
+        template <bool OtherConst>
+        bool operator>=(const __soa_iterator<OtherConst> & other) const noexcept
+        {
+            return _index >= other._index;
+        }
+    };
+
+    using iterator = __soa_iterator<false>;
+    using const_iterator = __soa_iterator<true>;
+
+protected:
+    using field_pointers = std::tuple<Ts*...>;
+    using indices = std::index_sequence_for<Ts...>;
+
+    field_pointers _fields;     // 各字段数组的起始地址，第0个字段位于内存块的开头
+    size_type _size;            // 元素个数
+    size_type _capacity;        // 每个字段数组的容量
+
+public:
+    // 构造函数
+
+    soa_vector() noexcept
+        : _fields(), _size(0), _capacity(0)
+    {}
+
+    soa_vector(std::initializer_list<value_type> ilist)
+        : soa_vector()
+    {
+        reserve(ilist.size());
+        for (const value_type & value : ilist) {
+            push_back(value);
+        }
+    }
+
+    soa_vector(const soa_vector & other)
+        : soa_vector()
+    {
+        reserve(other.size());
+        for (size_type i = 0; i < other.size(); ++i) {
+            _emplace_tuple(other[i], indices());
+        }
+    }
+
+    soa_vector(soa_vector && other) noexcept
+        : soa_vector()
+    {
+        swap(other);
+    }
+
+    ~soa_vector()
+    {
+        clear();
+        _deallocate(_fields);
+    }
+
+    soa_vector & operator=(const soa_vector & other)
+    {
+        if (this != &other) {
+            soa_vector temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    soa_vector & operator=(soa_vector && other) noexcept
+    {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+public:
+    // 元素访问
+
+    reference at(size_type pos)
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("soa_vector out of range");
+        }
+        return (*this)[pos];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("soa_vector out of range");
+        }
+        return (*this)[pos];
+    }
+
+    reference operator[](size_type pos)
+    {
+        return _element<reference>(_fields, pos, indices());
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return _element<const_reference>(_fields, pos, indices());
+    }
+
+    reference front()
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        return (*this)[_size - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[_size - 1];
+    }
+
+    /**
+     * @brief 第I个字段的连续数组，起始地址按alignment对齐
+     */
+    template <std::size_t I>
+    field_type<I> * data() noexcept
+    {
+        return std::get<I>(_fields);
+    }
+
+    template <std::size_t I>
+    const field_type<I> * data() const noexcept
+    {
+        return std::get<I>(_fields);
+    }
+
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, static_cast<difference_type>(_size));
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, static_cast<difference_type>(_size));
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return (std::numeric_limits<difference_type>::max() - field_count * alignment) / _element_bytes();
+    }
+
+    void reserve(size_type new_cap)
+    {
+        if (new_cap > max_size()) {
+            throw std::length_error("soa_vector reserve too large");
+        }
+        if (new_cap > _capacity) {
+            _reallocate(new_cap, 0, [](const field_pointers &) {});
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        if (_capacity > _size) {
+            _reallocate(_size, 0, [](const field_pointers &) {});
+        }
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        _destroy(_fields, 0, _size);
+        _size = 0;
+    }
+
+    void push_back(const value_type & value)
+    {
+        _emplace_tuple(value, indices());
+    }
+
+    void push_back(value_type && value)
+    {
+        _emplace_tuple(std::move(value), indices());
+    }
+
+    /**
+     * @brief 在尾部构造元素，每个参数构造一个字段
+     */
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == field_count, "soa_vector::emplace_back takes one argument per field");
+        if (_size == _capacity) {
+            // 参数可能引用容器内的元素，先在新空间中构造新元素，再搬移旧元素
+            _reallocate(_grow_capacity(1), 1, [&](const field_pointers & fields) {
+                _construct<0>(fields, _size, std::forward<Args>(args)...);
+            });
+        } else {
+            _construct<0>(_fields, _size, std::forward<Args>(args)...);
+        }
+        ++_size;
+        return back();
+    }
+
+    void pop_back()
+    {
+        --_size;
+        _destroy(_fields, _size, _size + 1);
+    }
+
+    /**
+     * @brief 修改元素个数，新元素的各字段值初始化
+     */
+    void resize(size_type count)
+    {
+        if (count < _size) {
+            _destroy(_fields, count, _size);
+            _size = count;
+            return;
+        }
+        reserve(count);
+        while (_size < count) {
+            emplace_back(Ts()...);
+        }
+    }
+
+    void swap(soa_vector & other) noexcept
+    {
+        std::swap(_fields, other._fields);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+protected:
+    // 内部函数
+
+    /**
+     * @brief 对每个字段调用一次f，参数是字段下标的std::integral_constant
+     */
+    template <class F, std::size_t... Is>
+    static void _for_each_field(F && f, std::index_sequence<Is...>)
+    {
+        (f(std::integral_constant<std::size_t, Is>()), ...);
+    }
+
+    template <class F>
+    static void _for_each_field(F && f)
+    {
+        _for_each_field(std::forward<F>(f), indices());
+    }
+
+    template <class Reference, std::size_t... Is>
+    static Reference _element(const field_pointers & fields, size_type pos, std::index_sequence<Is...>)
+    {
+        return Reference(std::get<Is>(fields)[pos]...);
+    }
+
+    template <class Tuple, std::size_t... Is>
+    void _emplace_tuple(Tuple && value, std::index_sequence<Is...>)
+    {
+        emplace_back(std::get<Is>(std::forward<Tuple>(value))...);
+    }
+
+    /**
+     * @brief 一个元素所有字段的字节数之和
+     */
+    static constexpr size_type _element_bytes() noexcept
+    {
+        return (sizeof(Ts) + ...);
+    }
+
+    /**
+     * @brief 每个字段数组按alignment对齐后依次排列，计算容量为cap时的字段地址和总字节数
+     */
+    static size_type _layout(unsigned char * block, size_type cap, field_pointers & fields) noexcept
+    {
+        size_type offset = 0;
+        _for_each_field([&](auto index) {
+            constexpr std::size_t I = decltype(index)::value;
+            std::get<I>(fields) = block == nullptr ? nullptr : reinterpret_cast<field_type<I> *>(block + offset);
+            offset = stl::__align_up(offset + cap * sizeof(field_type<I>), alignment);
+        });
+        return offset;
+    }
+
+    static field_pointers _allocate(size_type cap)
+    {
+        field_pointers fields;
+        if (cap == 0) {
+            _layout(nullptr, 0, fields);
+            return fields;
+        }
+        size_type bytes = _layout(nullptr, cap, fields);
+        auto block = static_cast<unsigned char *>(::operator new(bytes, std::align_val_t(alignment)));
+        _layout(block, cap, fields);
+        return fields;
+    }
+
+    static void _deallocate(const field_pointers & fields) noexcept
+    {
+        if (std::get<0>(fields) != nullptr) {
+            ::operator delete(static_cast<void *>(std::get<0>(fields)), std::align_val_t(alignment));
+        }
+    }
+
+    /**
+     * @brief 在pos处依次构造各字段，某个字段构造失败时销毁已经构造的字段
+     */
+    template <std::size_t I, class Arg, class... Rest>
+    static void _construct(const field_pointers & fields, size_type pos, Arg && arg, Rest&&... rest)
+    {
+        field_type<I> * p = std::get<I>(fields) + pos;
+        ::new(static_cast<void *>(p)) field_type<I>(std::forward<Arg>(arg));
+        try {
+            _construct<I + 1>(fields, pos, std::forward<Rest>(rest)...);
+        } catch (...) {
+            std::destroy_at(p);
+            throw;
+        }
+    }
+
+    template <std::size_t I>
+    static void _construct(const field_pointers &, size_type) noexcept
+    {}
+
+    /**
+     * @brief 销毁[first, last)范围内元素的所有字段
+     */
+    static void _destroy(const field_pointers & fields, size_type first, size_type last) noexcept
+    {
+        _for_each_field([&](auto index) {
+            constexpr std::size_t I = decltype(index)::value;
+            if constexpr (!std::is_trivially_destructible<field_type<I>>::value) {
+                std::destroy(std::get<I>(fields) + first, std::get<I>(fields) + last);
+            }
+        });
+    }
+
+    /**
+     * @brief 字段搬移时是否不会抛出异常
+     */
+    template <class U>
+    class _nothrow_relocatable
+        : public std::integral_constant<bool, is_trivially_relocatable<U>::value || std::is_nothrow_move_constructible<U>::value>
+    {};
+
+    size_type _grow_capacity(size_type extra) const
+    {
+        size_type required = _size + extra;
+        size_type cap = growth_policy()(_capacity, required);
+        return cap < required ? required : cap;
+    }
+
+    /**
+     * @brief 把所有字段搬到容量为new_cap的新内存中
+     * @param extra construct在新内存中构造的元素个数
+     * @param construct 在搬移旧元素之前于新内存中构造下标从size()开始的extra个新元素，失败时新内存被释放
+     * @details 先拷贝搬移时可能抛出异常的字段，全部成功后再重定位不会抛出异常的字段，
+     *          这样任何一步失败时原有元素都保持不变
+     */
+    template <class Construct>
+    void _reallocate(size_type new_cap, size_type extra, Construct && construct)
+    {
+        field_pointers fields = _allocate(new_cap);
+        try {
+            construct(fields);
+        } catch (...) {
+            _deallocate(fields);
+            throw;
+        }
+
+        std::size_t done = 0;   // 已经拷贝完的字段下标上界
+        try {
+            _for_each_field([&](auto index) {
+                constexpr std::size_t I = decltype(index)::value;
+                if constexpr (!_nothrow_relocatable<field_type<I>>::value) {
+                    stl::__uninitialized_move_if_noexcept(std::get<I>(_fields), std::get<I>(_fields) + _size, std::get<I>(fields));
+                    done = I + 1;
+                }
+            });
+        } catch (...) {
+            _for_each_field([&](auto index) {
+                constexpr std::size_t I = decltype(index)::value;
+                if constexpr (!_nothrow_relocatable<field_type<I>>::value) {
+                    if (I < done) {
+                        std::destroy(std::get<I>(fields), std::get<I>(fields) + _size);
+                    }
+                }
+            });
+            _destroy(fields, _size, _size + extra);
+            _deallocate(fields);
+            throw;
+        }
+
+        _for_each_field([&](auto index) {
+            constexpr std::size_t I = decltype(index)::value;
+            if constexpr (_nothrow_relocatable<field_type<I>>::value) {
+                stl::__relocate(std::get<I>(_fields), std::get<I>(_fields) + _size, std::get<I>(fields));
+            } else {
+                std::destroy(std::get<I>(_fields), std::get<I>(_fields) + _size);
+            }
+        });
+        _deallocate(_fields);
+        _fields = fields;
+        _capacity = new_cap;
+    }
+};
+
+// 非成员函数
+
+template <class... Ts>
+bool operator==(const soa_vector<Ts...> & lhs, const soa_vector<Ts...> & rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class... Ts>
+bool operator!=(const soa_vector<Ts...> & lhs, const soa_vector<Ts...> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class... Ts>
+void swap(soa_vector<Ts...> & lhs, soa_vector<Ts...> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+}
+
+#endif
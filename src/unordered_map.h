@@ -36,6 +36,9 @@ public:
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
 protected:
+    template <class K>
+    using _transparent_key = typename hashtable_type::template _transparent_key<K>;
+
     hashtable_type _ht;    // 哈希表
 
 public:
@@ -45,6 +48,10 @@ public:
         : _ht(50, hasher(), key_equal())
     {}
 
+    explicit unordered_map(const allocator_type & alloc)
+        : _ht(50, hasher(), key_equal(), alloc)
+    {}
+
 public:
     // 迭代器
 
@@ -85,6 +92,38 @@ public:
         _ht.clear();
     }
 
+    /**
+     * @brief 插入元素
+     */
+    stl::pair<iterator, bool> insert(const value_type& value)
+    {
+        return _ht.insert_unique(value);
+    }
+
+    /**
+     * @brief 删除指定位置的元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _ht.erase(pos);
+    }
+
+    /**
+     * @brief 删除指定范围的元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _ht.erase(first, last);
+    }
+
+    /**
+     * @brief 删除指定key的元素
+     */
+    size_type erase(const key_type& key)
+    {
+        return _ht.erase(key);
+    }
+
     void swap(unordered_map& other) noexcept
     {
         _ht.swap(other._ht);
@@ -141,6 +180,46 @@ public:
         return _ht[key];
     }
 
+    /**
+     * @brief 带越界检查访问与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    mapped_type& at(const K& key)
+    {
+        iterator it = _ht.find(key);
+        if (it == _ht.end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief 带越界检查访问与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    const mapped_type& at(const K& key) const
+    {
+        const_iterator it = _ht.find(key);
+        if (it == _ht.end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief 访问或插入与key等价的元素
+     * @details 只有在key不存在、需要插入时才构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    mapped_type& operator[](const K& key)
+    {
+        iterator it = _ht.find(key);
+        if (it != _ht.end()) {
+            return it->second;
+        }
+        return _ht.insert_unique(value_type(key_type(key), mapped_type())).first->second;
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -181,6 +260,52 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回与key等价的元素数量
+     * @details 哈希函数和比较函数都声明了is_transparent时可用，查找时不构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K& key) const
+    {
+        return _ht.count(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    iterator find(const K& key)
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K& key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     /**
@@ -324,6 +449,28 @@ public:
     }
 };
 
+// 非成员函数
+
+/**
+ * @brief 删除所有满足pred的元素
+ * @details 一次遍历整个表，删除时直接取得下一个元素，复杂度O(n)
+ * @return 删除的元素个数
+ */
+template <class Key, class T, class Hash, class KeyEqual, class Allocator, class Pred>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type erase_if(unordered_map<Key, T, Hash, KeyEqual, Allocator> & c, Pred pred)
+{
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type count = 0;
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+            ++count;
+        } else {
+            ++it;
+        }
+    }
+    return count;
+}
+
 } // namespace stl
 
 #endif
\ No newline at end of file
@@ -35,15 +35,22 @@ public:
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
 protected:
+    template <class K>
+    using _transparent_key = typename hashtable_type::template _transparent_key<K>;
+
     hashtable_type _ht;    // 哈希表
 
 public:
     // 构造函数
 
-    unordered_map()
+    unordered_multimap()
         : _ht(50, hasher(), key_equal())
     {}
 
+    explicit unordered_multimap(const allocator_type & alloc)
+        : _ht(50, hasher(), key_equal(), alloc)
+    {}
+
 public:
     // 迭代器
 
@@ -84,7 +91,7 @@ public:
         _ht.clear();
     }
 
-    void swap(unordered_map& other) noexcept
+    void swap(unordered_multimap& other) noexcept
     {
         _ht.swap(other._ht);
     }
@@ -148,6 +155,52 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回与key等价的元素数量
+     * @details 哈希函数和比较函数都声明了is_transparent时可用，查找时不构造key_type
+     */
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K& key) const
+    {
+        return _ht.count(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    iterator find(const K& key)
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素
+     */
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K& key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return _ht.equal_range(key);
+    }
+
+    /**
+     * @brief 返回与key等价的元素范围
+     */
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     /**
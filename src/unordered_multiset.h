@@ -33,13 +33,20 @@ public:
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
 protected:
+    template <class K>
+    using _transparent_key = typename hashtable_type::template _transparent_key<K>;
+
     hashtable_type _ht;     // 哈希表
 
 public:
-    unordered_set()
+    unordered_multiset()
         : _ht(50, hasher(), key_equal())
     {}
 
+    explicit unordered_multiset(const allocator_type & alloc)
+        : _ht(50, hasher(), key_equal(), alloc)
+    {}
+
 public:
     // 迭代器
 
@@ -117,6 +124,38 @@ public:
         return _ht.equal_range(key);
     }
 
+    // 哈希函数和比较函数都声明了is_transparent时，可以不构造key_type直接查找
+
+    template <class K, class = _transparent_key<K>>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    stl::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _ht.equal_range(key);
+    }
+
+    template <class K, class = _transparent_key<K>>
+    stl::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     local_iterator begin(size_type n)
@@ -6,12 +6,38 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include "memory.h"
+#include "iterator.h"
+#include "bit.h"
 
 namespace stl
 {
 
-template <typename T, typename Alloc = stl::allocator<T>>
+/**
+ * @brief 按固定倍数增长的容量策略
+ * @details 增长策略是无状态的函数对象，接受当前容量和所需的最小容量，返回新的容量。
+ *          返回值小于所需容量时vector会使用所需容量
+ */
+template <std::size_t Num, std::size_t Den>
+class factor_growth_policy
+{
+    static_assert(Num > Den, "growth factor must be greater than 1");
+
+public:
+    std::size_t operator()(std::size_t capacity, std::size_t required) const noexcept
+    {
+        std::size_t grown = capacity == 0 ? 1 : capacity / Den * Num + capacity % Den * Num / Den;
+        return grown < required ? required : grown;
+    }
+};
+
+using double_growth_policy = factor_growth_policy<2, 1>;            // 2倍增长，扩容次数少
+using one_and_half_growth_policy = factor_growth_policy<3, 2>;      // 1.5倍增长，释放的旧空间之后可以被复用
+
+template <typename T, typename Alloc = stl::allocator<T>, typename GrowthPolicy = stl::double_growth_policy>
 class vector
 {
 public:
@@ -177,6 +203,12 @@ public:
     using const_pointer = const value_type*;
     using iterator = __vector_iterator;
     using const_iterator = const iterator;
+    using growth_policy = GrowthPolicy;
+
+    /**
+     * @brief 底层数组起始地址保证的对齐字节数，由分配器决定
+     */
+    static constexpr std::size_t data_alignment = stl::__allocator_alignment<Alloc>::value;
 
 protected:
     pointer start;              // 起始元素指针
@@ -190,6 +222,10 @@ public:
         : start(nullptr), finish(nullptr), end_of_storage(nullptr)
     {}
 
+    explicit vector(const allocator_type & alloc)
+        : start(nullptr), finish(nullptr), end_of_storage(nullptr), allocator(alloc)
+    {}
+
     ~vector()
     {
         clear();
@@ -296,6 +332,20 @@ public:
         return start;
     }
 
+    /**
+     * @brief 带对齐假设的底层数据指针
+     * @details 编译器据此省去向量化循环开头的对齐处理，配合aligned_allocator使用
+     */
+    pointer aligned_data() noexcept
+    {
+        return stl::assume_aligned<data_alignment>(start);
+    }
+
+    const_pointer aligned_data() const noexcept
+    {
+        return stl::assume_aligned<data_alignment>(start);
+    }
+
     // 迭代器
 
     iterator begin()
@@ -399,69 +449,51 @@ public:
     /**
      * @brief 在指定位置插入元素
      */
-    iterator insert(iterator pos, const value_type & value)
+    iterator insert(const_iterator pos, const value_type & value)
     {
-        if (size() == capacity()) {
-            reserve(capacity() == 0 ? 1 : capacity() * 2);
-        }
-
-        // std::memmove(pos._ptr + 1, pos._ptr, (finish - pos._ptr) * sizeof(value_type));
-        std::move(pos._ptr, finish, pos._ptr + 1);
-        *pos._ptr = value;
-        ++finish;
-        return pos;
+        return emplace(pos, value);
     }
 
     /**
      * @brief 在指定位置插入元素
      */
-    iterator insert(iterator pos, value_type && value)
+    iterator insert(const_iterator pos, value_type && value)
     {
-        if (size() == capacity()) {
-            reserve(capacity() == 0 ? 1 : capacity() * 2);
-        }
-
-        // std::memmove(pos._ptr + 1, pos._ptr, (finish - pos._ptr) * sizeof(value_type));
-        std::move(pos._ptr, finish, pos._ptr + 1);
-        *pos._ptr = std::move(value);
-        ++finish;
-        return pos;
+        return emplace(pos, std::move(value));
     }
 
     /**
      * @brief 在指定位置插入n个元素
      */
-    iterator insert(iterator pos, size_type count, const value_type & value)
+    iterator insert(const_iterator pos, size_type count, const value_type & value)
     {
-        if (size() + count > capacity()) {
-            reserve(size() + count);
+        size_type index = pos._ptr - start;
+        if (_in_storage(std::addressof(value)) && size() + count <= capacity()) {
+            // value是本vector的元素，腾出空间时会被移动，先拷贝一份
+            value_type copy(value);
+            return _insert_n(index, count, [&](pointer dest) {
+                std::uninitialized_fill_n(dest, count, copy);
+            });
         }
-
-        // std::memmove(pos._ptr + count, pos._ptr, (finish - pos._ptr) * sizeof(value_type));
-        std::move(pos._ptr, finish, pos._ptr + count);
-        std::uninitialized_fill_n(pos._ptr, count, value);
-        finish += count;
-        return pos;
+        return _insert_n(index, count, [&](pointer dest) {
+            std::uninitialized_fill_n(dest, count, value);
+        });
     }
 
     /**
      * @brief 在指定位置插入迭代器范围的元素
+     * @details 前向迭代器只计算一次距离、最多重新分配一次
      */
-    template <class InputIterator>
-    iterator insert(iterator pos, InputIterator first, InputIterator last)
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert(const_iterator pos, InputIterator first, InputIterator last)
     {
-        InputIterator it = first;
-        while (it != last) {
-            pos = insert(pos, *it);
-            ++it;
-        }
-        return pos;
+        return _insert_range(pos._ptr - start, first, last, typename std::iterator_traits<InputIterator>::iterator_category());
     }
 
     /**
      * @brief 在指定位置插入initializer_list
      */
-    iterator insert(iterator pos, std::initializer_list<value_type> ilist)
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
     {
         return insert(pos, ilist.begin(), ilist.end());
     }
@@ -470,17 +502,25 @@ public:
      * @brief 在指定位置构造元素
      */
     template <class... Args>
-    iterator emplace(iterator pos, Args &&... args)
+    iterator emplace(const_iterator pos, Args &&... args)
     {
+        size_type index = pos._ptr - start;
         if (size() == capacity()) {
-            reserve(capacity() == 0 ? 1 : capacity() * 2);
+            // 新元素在搬移旧元素之前构造，参数引用本vector的元素也是安全的
+            return _insert_n(index, 1, [&](pointer dest) {
+                allocator.construct(dest, std::forward<Args>(args)...);
+            });
         }
-
-        // std::memmove(pos._ptr + 1, pos._ptr, (finish - pos._ptr) * sizeof(value_type));
-        std::move(pos._ptr, finish, pos._ptr + 1);
-        allocator.construct(pos._ptr, std::forward<Args>(args)...);
-        ++finish;
-        return pos;
+        if (index == size()) {
+            allocator.construct(finish, std::forward<Args>(args)...);
+            ++finish;
+            return iterator(finish - 1);
+        }
+        // 参数可能引用即将被移动的元素，先构造出来
+        value_type tmp(std::forward<Args>(args)...);
+        return _insert_n(index, 1, [&](pointer dest) {
+            allocator.construct(dest, std::move(tmp));
+        });
     }
 
     /**
@@ -489,8 +529,8 @@ public:
     iterator erase(const_iterator pos)
     {
         pointer target = pos._ptr;
-        std::move(target + 1, finish, target);
-        allocator.destroy(--finish);    // 销毁最后一个元素，因为它不再有效
+        allocator.destroy(target);
+        _close_gap(target, 1);
         return iterator(target);
     }
 
@@ -502,24 +542,34 @@ public:
         if (first == last)
             return iterator(last._ptr);
 
-        std::move(last._ptr, finish, first._ptr);
         for (pointer it = first._ptr; it != last._ptr; ++it) {
             allocator.destroy(it);
         }
-        finish = finish - (last._ptr - first._ptr);
+        _close_gap(first._ptr, last._ptr - first._ptr);
         return iterator(first._ptr);
     }
 
+    /**
+     * @brief 用尾部元素替换指定位置的元素，不保持元素顺序
+     * @details 只移动一个元素，复杂度O(1)
+     * @return 指向pos的迭代器，该位置现在是原来的尾部元素
+     */
+    iterator unordered_erase(const_iterator pos)
+    {
+        pointer target = pos._ptr;
+        if (target != finish - 1) {
+            *target = std::move(*(finish - 1));
+        }
+        pop_back();
+        return iterator(target);
+    }
+
     /**
      * @brief 在尾部插入元素
      */
     void push_back(const value_type & value)
     {
-        if (size() == capacity()) {
-            reserve(capacity() == 0 ? 1 : capacity() * 2);
-        }
-        allocator.construct(finish, value);
-        ++finish;
+        emplace_back(value);
     }
 
     /**
@@ -534,7 +584,10 @@ public:
     void emplace_back(Args&&... args)
     {
         if (size() == capacity()) {
-            reserve(capacity() == 0 ? 1 : capacity() * 2);
+            _insert_n(size(), 1, [&](pointer dest) {
+                allocator.construct(dest, std::forward<Args>(args)...);
+            });
+            return;
         }
         allocator.construct(finish, std::forward<Args>(args)...);
         ++finish;
@@ -573,6 +626,93 @@ public:
         }
     }
 
+    /**
+     * @brief 修改vector的大小，新元素默认初始化
+     * @details 平凡类型的新元素不会被写入，适合随后整体覆盖的缓冲区，
+     *          省去一次清零的内存带宽，页面也只在真正写入时才被访问
+     */
+    void resize_default_init(size_type count)
+    {
+        if (count < size()) {
+            erase(begin() + count, end());
+            return;
+        }
+        size_type n = count - size();
+        pointer dest = append_uninitialized(n);
+        stl::__uninitialized_default_construct_n(dest, n);
+        commit_append(n);
+    }
+
+    /**
+     * @brief 同resize_default_init
+     */
+    void resize_for_overwrite(size_type count)
+    {
+        resize_default_init(count);
+    }
+
+    /**
+     * @brief 确保尾部有n个元素的空间，返回其中第一个未初始化的位置
+     * @details 调用者在其中构造元素后调用commit_append，在此之前不能修改vector
+     */
+    pointer append_uninitialized(size_type n)
+    {
+        reserve_back(n);
+        return finish;
+    }
+
+    /**
+     * @brief 把append_uninitialized给出的空间中前n个已构造的元素加入vector
+     */
+    void commit_append(size_type n)
+    {
+        finish += n;
+    }
+
+    /**
+     * @brief 确保尾部还能放下n个元素，容量按增长策略扩展
+     */
+    void reserve_back(size_type n)
+    {
+        if (size_type(end_of_storage - finish) < n) {
+            _reallocate(_grow_capacity(n));
+        }
+    }
+
+    /**
+     * @brief 在尾部构造元素，不检查容量
+     * @details 调用者需要先用reserve_back预留空间
+     */
+    template <typename... Args>
+    void unchecked_emplace_back(Args&&... args)
+    {
+        allocator.construct(finish, std::forward<Args>(args)...);
+        ++finish;
+    }
+
+    /**
+     * @brief 在尾部追加迭代器范围的元素
+     * @details 前向迭代器只扩容一次，随后整体构造，不再逐个检查容量
+     */
+    template <class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void append_range(InputIterator first, InputIterator last)
+    {
+        _append_range(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    /**
+     * @brief 在尾部追加n个由gen()生成的元素
+     * @details 只扩容一次；gen抛出异常时已追加的元素保留
+     */
+    template <class Generator>
+    void append(size_type n, Generator gen)
+    {
+        reserve_back(n);
+        for (pointer last = finish + n; finish != last; ++finish) {
+            allocator.construct(finish, gen());
+        }
+    }
+
     /**
      * @brief 交换vector
      * @details 交换两个vector
@@ -582,21 +722,217 @@ public:
         std::swap(start, other.start);
         std::swap(finish, other.finish);
         std::swap(end_of_storage, other.end_of_storage);
+        std::swap(allocator, other.allocator);
     }
 
 protected:
     // 内部函数
 
+    /**
+     * @brief 指针是否指向本vector的元素
+     */
+    bool _in_storage(const value_type * ptr) const
+    {
+        return !std::less<const value_type *>()(ptr, start) && std::less<const value_type *>()(ptr, finish);
+    }
+
+    /**
+     * @brief 把[pos, finish)向后搬移n个位置，空出未初始化的[pos, pos + n)
+     * @details 调用者保证容量足够，可平凡重定位的元素只做一次memmove
+     */
+    void _open_gap(pointer pos, size_type n)
+    {
+        if (stl::is_trivially_relocatable<value_type>::value) {
+            std::memmove(static_cast<void *>(pos + n), static_cast<const void *>(pos), (finish - pos) * sizeof(value_type));
+        } else {
+            for (pointer it = finish; it != pos; ) {
+                --it;
+                allocator.construct(it + n, std::move(*it));
+                allocator.destroy(it);
+            }
+        }
+        finish += n;
+    }
+
+    /**
+     * @brief 把[pos + n, finish)向前搬移n个位置，覆盖未初始化的[pos, pos + n)
+     */
+    void _close_gap(pointer pos, size_type n)
+    {
+        if (stl::is_trivially_relocatable<value_type>::value) {
+            std::memmove(static_cast<void *>(pos), static_cast<const void *>(pos + n), (finish - pos - n) * sizeof(value_type));
+        } else {
+            for (pointer it = pos; it + n != finish; ++it) {
+                allocator.construct(it, std::move(*(it + n)));
+                allocator.destroy(it + n);
+            }
+        }
+        finish -= n;
+    }
+
+    /**
+     * @brief 容纳extra个新元素需要的容量，由增长策略决定
+     */
+    size_type _grow_capacity(size_type extra) const
+    {
+        size_type required = size() + extra;
+        size_type cap = growth_policy()(capacity(), required);
+        return cap < required ? required : cap;
+    }
+
+    /**
+     * @brief 在index处插入n个元素
+     * @param construct 在未初始化的dest处构造n个元素，失败时需要销毁已经构造的元素
+     * @details 容量不足时先在新空间中构造新元素，再把两侧的旧元素重定位过去；
+     *          容量足够时先腾出空间再构造，构造失败会把空间合上
+     */
+    template <class Construct>
+    iterator _insert_n(size_type index, size_type n, Construct && construct)
+    {
+        if (n == 0) {
+            return iterator(start + index);
+        }
+        if (size() + n > capacity()) {
+            size_type old_size = size();
+            auto allocation = stl::__allocate_at_least(allocator, _grow_capacity(n));
+            pointer new_start = allocation.ptr;
+            size_type new_cap = allocation.count;
+            try {
+                construct(new_start + index);
+            } catch (...) {
+                allocator.deallocate(new_start, new_cap);
+                throw;
+            }
+            _relocate_around(index, n, new_start, new_cap);
+            allocator.deallocate(start, capacity());
+            start = new_start;
+            finish = new_start + old_size + n;
+            end_of_storage = new_start + new_cap;
+        } else {
+            pointer pos = start + index;
+            _open_gap(pos, n);
+            try {
+                construct(pos);
+            } catch (...) {
+                _close_gap(pos, n);
+                throw;
+            }
+        }
+        return iterator(start + index);
+    }
+
+    /**
+     * @brief 把[start, start + index)和[start + index, finish)分别搬到新空间中插入的n个元素两侧
+     * @details 两段都成功后才销毁旧元素；任何一段失败时销毁已经构造的元素（包括插入的n个）并释放新空间，
+     *          旧元素保持不变
+     */
+    void _relocate_around(size_type index, size_type n, pointer new_start, size_type new_cap)
+    {
+        if (stl::is_trivially_relocatable<value_type>::value) {
+            stl::__relocate(start, start + index, new_start);
+            stl::__relocate(start + index, finish, new_start + index + n);
+            return;
+        }
+        try {
+            stl::__uninitialized_move_if_noexcept(start, start + index, new_start);
+            try {
+                stl::__uninitialized_move_if_noexcept(start + index, finish, new_start + index + n);
+            } catch (...) {
+                _destroy_range(new_start, new_start + index);
+                throw;
+            }
+        } catch (...) {
+            _destroy_range(new_start + index, new_start + index + n);
+            allocator.deallocate(new_start, new_cap);
+            throw;
+        }
+        _destroy_range(start, finish);
+    }
+
+    /**
+     * @brief 通过分配器销毁[first, last)的元素
+     */
+    void _destroy_range(pointer first, pointer last)
+    {
+        for (; first != last; ++first) {
+            allocator.destroy(first);
+        }
+    }
+
+    template <class ForwardIterator>
+    iterator _insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+    {
+        size_type n = std::distance(first, last);
+        return _insert_n(index, n, [&](pointer dest) {
+            std::uninitialized_copy(first, last, dest);
+        });
+    }
+
+    /**
+     * @brief 输入迭代器只能遍历一次，先追加到尾部再旋转到插入位置
+     */
+    template <class InputIterator>
+    iterator _insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag)
+    {
+        size_type old_size = size();
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(start + index, start + old_size, finish);
+        return iterator(start + index);
+    }
+
+    template <class ForwardIterator>
+    void _append_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+    {
+        size_type n = std::distance(first, last);
+        pointer dest = append_uninitialized(n);
+        std::uninitialized_copy(first, last, dest);
+        commit_append(n);
+    }
+
+    template <class InputIterator>
+    void _append_range(InputIterator first, InputIterator last, std::input_iterator_tag)
+    {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    /**
+     * @brief 把容量调整为至少new_cap，new_cap不能小于size()
+     * @details 可平凡重定位的元素用一次memcpy搬移，分配器提供reallocate时直接调整原内存；
+     *          其他元素逐个移动，移动可能抛出异常时退而拷贝。
+     *          分配器提供allocate_at_least时，容量是分配器实际给出的大小
+     */
     void _reallocate(size_type new_cap)
+    {
+        _reallocate(new_cap, std::integral_constant<bool,
+            stl::is_trivially_relocatable<value_type>::value && stl::__has_reallocate<Alloc>::value>());
+    }
+
+    void _reallocate(size_type new_cap, std::true_type)
+    {
+        size_type old_size = size();
+        auto allocation = stl::__reallocate_at_least(allocator, start, capacity(), new_cap);
+        start = allocation.ptr;
+        finish = start + old_size;
+        end_of_storage = start + allocation.count;
+    }
+
+    void _reallocate(size_type new_cap, std::false_type)
     {
         size_type old_size = size();
         // 分配新空间
-        pointer new_start = allocator.allocate(new_cap);
-        // 将旧数据拷贝到新空间，这里需要重写这个函数
-        std::uninitialized_copy(start, finish, new_start);
-        // 销毁旧元素
-        for (pointer it = start; it != finish; ++it) {
-            it->~value_type();
+        auto allocation = stl::__allocate_at_least(allocator, new_cap);
+        pointer new_start = allocation.ptr;
+        new_cap = allocation.count;
+        // 将旧元素重定位到新空间，失败时释放新空间，旧元素保持不变
+        try {
+            stl::__relocate(start, finish, new_start);
+        } catch (...) {
+            allocator.deallocate(new_start, new_cap);
+            throw;
         }
         // 释放旧空间
         allocator.deallocate(start, capacity());
@@ -610,48 +946,523 @@ protected:
 
 // 非成员函数
 
-template <class T, class Alloc>
-bool operator==(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs)
+/**
+ * @brief vector只持有指向堆内存的指针，分配器可平凡重定位时vector也可以
+ */
+template <class T, class Alloc, class GrowthPolicy>
+class is_trivially_relocatable<vector<T, Alloc, GrowthPolicy>>
+    : public is_trivially_relocatable<Alloc>
+{};
+
+template <class T, class Alloc, class GrowthPolicy>
+bool operator==(const vector<T, Alloc, GrowthPolicy> & lhs, const vector<T, Alloc, GrowthPolicy> & rhs)
 {
     return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Alloc>
-bool operator!=(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs)
+template <class T, class Alloc, class GrowthPolicy>
+bool operator!=(const vector<T, Alloc, GrowthPolicy> & lhs, const vector<T, Alloc, GrowthPolicy> & rhs)
 {
     return !(lhs == rhs);
 }
 
-template <class T, class Alloc>
-bool operator<(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs)
+template <class T, class Alloc, class GrowthPolicy>
+bool operator<(const vector<T, Alloc, GrowthPolicy> & lhs, const vector<T, Alloc, GrowthPolicy> & rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Alloc>
-bool operator>(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs)
+template <class T, class Alloc, class GrowthPolicy>
+bool operator>(const vector<T, Alloc, GrowthPolicy> & lhs, const vector<T, Alloc, GrowthPolicy> & rhs)
 {
     return rhs < lhs;
 }
 
-template <class T, class Alloc>
-bool operator<=(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs)
+template <class T, class Alloc, class GrowthPolicy>
+bool operator<=(const vector<T, Alloc, GrowthPolicy> & lhs, const vector<T, Alloc, GrowthPolicy> & rhs)
 {
     return !(rhs < lhs);
 }
 
-template <class T, class Alloc>
-bool operator>=(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs)
+template <class T, class Alloc, class GrowthPolicy>
+bool operator>=(const vector<T, Alloc, GrowthPolicy> & lhs, const vector<T, Alloc, GrowthPolicy> & rhs)
 {
     return !(lhs < rhs);
 }
 
-template <class T, class Alloc>
-void swap(vector<T, Alloc> & lhs, vector<T, Alloc> & rhs)
+template <class T, class Alloc, class GrowthPolicy>
+void swap(vector<T, Alloc, GrowthPolicy> & lhs, vector<T, Alloc, GrowthPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief 删除所有满足pred的元素
+ * @details 一次遍历把保留的元素依次移到前面，最后一次性销毁尾部，复杂度O(n)
+ * @return 删除的元素个数
+ */
+template <class T, class Alloc, class GrowthPolicy, class Pred>
+typename vector<T, Alloc, GrowthPolicy>::size_type erase_if(vector<T, Alloc, GrowthPolicy> & c, Pred pred)
+{
+    auto it = std::remove_if(c.begin(), c.end(), pred);
+    auto count = c.end() - it;
+    c.erase(it, c.end());
+    return count;
+}
+
+/**
+ * @brief 删除所有等于value的元素
+ * @return 删除的元素个数
+ */
+template <class T, class Alloc, class GrowthPolicy, class U>
+typename vector<T, Alloc, GrowthPolicy>::size_type erase(vector<T, Alloc, GrowthPolicy> & c, const U & value)
+{
+    return stl::erase_if(c, [&](const T & element) { return element == value; });
+}
+
+/**
+ * @brief 按位存储的vector<bool>
+ * @link https://zh.cppreference.com/w/cpp/container/vector_bool
+ * @details 每个元素占1位，按64位字存储，下标访问和迭代器返回位代理引用。
+ *          容量按字增长，使用与vector相同的增长策略；最后一个字中超出size的位始终为0
+ */
+template <typename Alloc, typename GrowthPolicy>
+class vector<bool, Alloc, GrowthPolicy>
+{
+public:
+    using value_type = bool;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = stl::__bit_reference;
+    using const_reference = bool;
+    using iterator = stl::__bit_iterator<false>;
+    using const_iterator = stl::__bit_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using growth_policy = GrowthPolicy;
+    using word_type = stl::__bit_word;
+    using word_allocator_type = typename Alloc::template rebind<word_type>::other;
+
+protected:
+    word_type * _words;                 // 存放位的字数组
+    size_type _size;                    // 位数
+    size_type _word_capacity;           // 字数组的容量
+    word_allocator_type allocator;      // 字分配器
+
+public:
+    vector()
+        : _words(nullptr), _size(0), _word_capacity(0)
+    {}
+
+    explicit vector(const allocator_type & alloc)
+        : _words(nullptr), _size(0), _word_capacity(0), allocator(alloc)
+    {}
+
+    explicit vector(size_type count, bool value = false, const allocator_type & alloc = allocator_type())
+        : vector(alloc)
+    {
+        resize(count, value);
+    }
+
+    vector(std::initializer_list<bool> ilist)
+        : vector()
+    {
+        reserve(ilist.size());
+        for (bool value : ilist) {
+            push_back(value);
+        }
+    }
+
+    vector(const vector & other)
+        : vector(other.allocator)
+    {
+        _assign_words(other);
+    }
+
+    vector(vector && other) noexcept
+        : vector(other.allocator)
+    {
+        swap(other);
+    }
+
+    ~vector()
+    {
+        if (_words != nullptr) {
+            allocator.deallocate(_words, _word_capacity);
+        }
+    }
+
+    vector & operator=(const vector & other)
+    {
+        if (this != &other) {
+            _size = 0;
+            _assign_words(other);
+        }
+        return *this;
+    }
+
+    vector & operator=(vector && other) noexcept
+    {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+public:
+    allocator_type get_allocator() const
+    {
+        return allocator_type(allocator);
+    }
+
+    // 元素访问
+
+    reference at(size_type pos)
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("vector out of range");
+        }
+        return (*this)[pos];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= _size) {
+            throw std::out_of_range("vector out of range");
+        }
+        return (*this)[pos];
+    }
+
+    reference operator[](size_type pos)
+    {
+        return reference(_words + pos / stl::__bits_per_word, stl::__bit_mask(pos));
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return (_words[pos / stl::__bits_per_word] & stl::__bit_mask(pos)) != 0;
+    }
+
+    reference front()
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        return (*this)[_size - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[_size - 1];
+    }
+
+    /**
+     * @brief 底层的字数组，第i位位于第i / 64个字的第i % 64位
+     */
+    word_type * data() noexcept
+    {
+        return _words;
+    }
+
+    const word_type * data() const noexcept
+    {
+        return _words;
+    }
+
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return iterator(_words, 0);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_words, 0);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(_words, _size);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(_words, _size);
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * @brief 最大位数，字数先限制在不会使位数溢出的范围内
+     */
+    size_type max_size() const noexcept
+    {
+        size_type words = std::min(allocator.max_size(), std::numeric_limits<size_type>::max() / stl::__bits_per_word);
+        return words * stl::__bits_per_word;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return _word_capacity * stl::__bits_per_word;
+    }
+
+    void reserve(size_type new_cap)
+    {
+        if (new_cap > max_size()) {
+            throw std::length_error("vector reserve too large");
+        }
+        if (new_cap > capacity()) {
+            _reallocate(stl::__bit_words(new_cap));
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        if (stl::__bit_words(_size) < _word_capacity) {
+            _reallocate(stl::__bit_words(_size));
+        }
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        if (_words != nullptr) {
+            std::memset(static_cast<void *>(_words), 0, stl::__bit_words(_size) * sizeof(word_type));
+        }
+        _size = 0;
+    }
+
+    void push_back(bool value)
+    {
+        if (_size == capacity()) {
+            _reallocate(_grow_words(1));
+        }
+        if (value) {
+            _words[_size / stl::__bits_per_word] |= stl::__bit_mask(_size);
+        }
+        ++_size;
+    }
+
+    reference emplace_back(bool value)
+    {
+        push_back(value);
+        return back();
+    }
+
+    void pop_back()
+    {
+        --_size;
+        _words[_size / stl::__bits_per_word] &= ~stl::__bit_mask(_size);
+    }
+
+    /**
+     * @brief 在pos处插入count个value
+     * @details 先把后面的位整体后移，再用__fill_bits按字填充
+     */
+    iterator insert(const_iterator pos, size_type count, bool value)
+    {
+        size_type index = static_cast<size_type>(pos - cbegin());
+        if (count == 0) {
+            return begin() + index;
+        }
+        if (_size + count > capacity()) {
+            _reallocate(_grow_words(count));
+        }
+        size_type old_size = _size;
+        _size += count;
+        std::copy_backward(begin() + index, begin() + old_size, end());
+        stl::__fill_bits(_words, index, index + count, value);
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator pos, bool value)
+    {
+        return insert(pos, 1, value);
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        size_type index = static_cast<size_type>(first - cbegin());
+        size_type count = static_cast<size_type>(last - first);
+        std::copy(begin() + index + count, end(), begin() + index);
+        _shrink_to(_size - count);
+        return begin() + index;
+    }
+
+    void resize(size_type count, bool value = false)
+    {
+        if (count <= _size) {
+            _shrink_to(count);
+            return;
+        }
+        if (count > capacity()) {
+            size_type words = stl::__bit_words(count);
+            size_type grown = growth_policy()(_word_capacity, words);
+            _reallocate(grown < words ? words : grown);
+        }
+        size_type old_size = _size;
+        _size = count;
+        if (value) {
+            stl::__fill_bits(_words, old_size, count, true);
+        }
+    }
+
+    /**
+     * @brief 翻转所有位
+     */
+    void flip() noexcept
+    {
+        size_type words = stl::__bit_words(_size);
+        for (size_type i = 0; i < words; ++i) {
+            _words[i] = ~_words[i];
+        }
+        stl::__clear_tail_bits(_words, _size);
+    }
+
+    /**
+     * @brief 为true的元素个数
+     */
+    size_type count() const noexcept
+    {
+        return stl::__count_bits(_words, stl::__bit_words(_size));
+    }
+
+    void swap(vector & other) noexcept
+    {
+        std::swap(_words, other._words);
+        std::swap(_size, other._size);
+        std::swap(_word_capacity, other._word_capacity);
+        std::swap(allocator, other.allocator);
+    }
+
+    static void swap(reference lhs, reference rhs) noexcept
+    {
+        bool temp = lhs;
+        lhs = static_cast<bool>(rhs);
+        rhs = temp;
+    }
+
+protected:
+    // 内部函数
+
+    size_type _grow_words(size_type extra) const
+    {
+        size_type required = stl::__bit_words(_size + extra);
+        size_type cap = growth_policy()(_word_capacity, required);
+        return cap < required ? required : cap;
+    }
+
+    /**
+     * @brief 把字数组的容量调整为new_words，新增的字清零
+     */
+    void _reallocate(size_type new_words)
+    {
+        word_type * words = new_words == 0 ? nullptr : allocator.allocate(new_words);
+        size_type used = stl::__bit_words(_size);
+        if (used != 0) {
+            std::memcpy(static_cast<void *>(words), static_cast<const void *>(_words), used * sizeof(word_type));
+        }
+        if (new_words > used) {
+            std::memset(static_cast<void *>(words + used), 0, (new_words - used) * sizeof(word_type));
+        }
+        if (_words != nullptr) {
+            allocator.deallocate(_words, _word_capacity);
+        }
+        _words = words;
+        _word_capacity = new_words;
+    }
+
+    /**
+     * @brief 把位数减少到count，清零被删除的位
+     */
+    void _shrink_to(size_type count) noexcept
+    {
+        if (count < _size) {
+            stl::__fill_bits(_words, count, _size, false);
+            _size = count;
+        }
+    }
+
+    /**
+     * @brief 拷贝other的所有位，调用前本对象为空
+     */
+    void _assign_words(const vector & other)
+    {
+        size_type words = stl::__bit_words(other._size);
+        if (words > _word_capacity) {
+            _reallocate(words);
+        } else if (_words != nullptr) {
+            std::memset(static_cast<void *>(_words), 0, _word_capacity * sizeof(word_type));
+        }
+        if (words != 0) {
+            std::memcpy(static_cast<void *>(_words), static_cast<const void *>(other._words), words * sizeof(word_type));
+        }
+        _size = other._size;
+    }
+};
+
+template <class Alloc, class GrowthPolicy>
+bool operator==(const vector<bool, Alloc, GrowthPolicy> & lhs, const vector<bool, Alloc, GrowthPolicy> & rhs)
+{
+    return lhs.size() == rhs.size()
+        && (lhs.empty() || std::memcmp(lhs.data(), rhs.data(), stl::__bit_words(lhs.size()) * sizeof(stl::__bit_word)) == 0);
+}
+
 }
 
 #endif
\ No newline at end of file
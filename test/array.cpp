@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <numeric>
 #include <stdexcept>
+#include <cassert>
+#include <cstdint>
 #include "../src/array.h"
 
 int main() {
@@ -100,6 +102,13 @@ int main() {
     }
     std::cout << "\n";
 
+    // 测试对齐的数组
+    stl::array<float, 16, 64> aligned = {1.0f, 2.0f, 3.0f};
+    stl::array<float, 16, 64> aligned_copy = aligned;
+    static_assert(alignof(stl::array<float, 16, 64>) == 64, "array alignment");
+    assert(reinterpret_cast<std::uintptr_t>(aligned.aligned_data()) % 64 == 0);
+    assert(aligned == aligned_copy && stl::get<2>(aligned) == 3.0f && aligned[15] == 0.0f);
+
     std::cout << "All tests passed!" << std::endl;
 
     return 0;
@@ -0,0 +1,220 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include "../src/concurrent_vector.h"
+
+void test_basic() {
+    stl::concurrent_vector<int> vec;
+    assert(vec.empty() && vec.capacity() == 0 && vec.begin() == vec.end());
+    std::vector<int *> addresses;
+    for (int i = 0; i < 5000; ++i) {
+        auto it = vec.push_back(i);
+        assert(*it == i);
+        addresses.push_back(&*it);
+    }
+    // 增长时不移动已有元素
+    for (int i = 0; i < 5000; ++i) {
+        assert(&vec[i] == addresses[i] && vec[i] == i);
+    }
+    assert(vec.size() == 5000 && vec.front() == 0 && vec.back() == 4999 && vec.at(1234) == 1234);
+    assert(vec.capacity() >= 5000 && vec.capacity() < 2 * 5000 + vec.first_segment_size);
+
+    // 段的大小按2倍增长，段内连续
+    assert(vec.segment_data(0) == &vec[0]);
+    assert(vec.segment_data(1) == &vec[vec.first_segment_size]);
+    assert(vec.segment_capacity(2) == 4 * vec.first_segment_size);
+    assert(vec.segment_data(2) + vec.segment_capacity(2) - 1 == &vec[7 * vec.first_segment_size - 1]);
+
+    bool thrown = false;
+    try {
+        vec.at(5000);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    auto first = vec.grow_by(3, -7);
+    assert(first - vec.begin() == 5000 && vec.size() == 5003 && vec[5002] == -7);
+    std::vector<int> tail = {1, 2, 3, 4};
+    first = vec.grow_by(tail.begin(), tail.end());
+    assert(*first == 1 && vec.back() == 4 && vec.size() == 5007);
+    vec.grow_by(0);
+    assert(vec.size() == 5007);
+
+    stl::concurrent_vector<int> copy(vec);
+    assert(copy == vec && std::count(copy.begin(), copy.end(), -7) == 3);
+    stl::concurrent_vector<int> moved(std::move(copy));
+    assert(moved == vec && copy.empty());
+    copy = moved;
+    assert(copy == vec);
+
+    std::size_t capacity = vec.capacity();
+    vec.clear();
+    assert(vec.empty() && vec.capacity() == capacity);
+    vec.reserve(100000);
+    assert(vec.capacity() >= 100000);
+
+    stl::concurrent_vector<std::string> strings = {"a", "b"};
+    strings.emplace_back(3, 'c');
+    assert(strings.size() == 3 && strings[2] == "ccc");
+    std::cout << "Basic operations passed." << std::endl;
+}
+
+void test_concurrent_append() {
+    const int threads = 8;
+    const int per_thread = 20000;
+    stl::concurrent_vector<std::pair<int, int>> vec;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&vec, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                if (i % 100 == 0) {
+                    auto first = vec.grow_by(3, std::make_pair(t, -1));
+                    // 自己追加的元素返回后即可读取
+                    assert(first->first == t && first[2].second == -1);
+                } else {
+                    auto it = vec.emplace_back(t, i);
+                    assert(it->second == i);
+                }
+            }
+        });
+    }
+    for (auto & worker : workers) {
+        worker.join();
+    }
+
+    // 每个线程追加的元素都恰好出现一次，且保持各自的先后顺序
+    std::size_t expected = threads * (per_thread + per_thread / 100 * 2);
+    assert(vec.size() == expected);
+    std::vector<int> last(threads, -1);
+    std::vector<std::size_t> counts(threads, 0);
+    for (auto & item : vec) {
+        ++counts[item.first];
+        if (item.second >= 0) {
+            assert(item.second > last[item.first]);
+            last[item.first] = item.second;
+        }
+    }
+    for (int t = 0; t < threads; ++t) {
+        assert(counts[t] == expected / threads && last[t] == per_thread - 1);
+    }
+    std::cout << "Concurrent append passed." << std::endl;
+}
+
+/**
+ * @brief 构造时可能抛出异常的类型
+ */
+class fragile
+{
+public:
+    int value;
+
+    fragile() noexcept : value(0) {}
+    explicit fragile(int v) : value(v)
+    {
+        if (v < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+};
+
+void test_exception() {
+    stl::concurrent_vector<fragile> vec;
+    vec.emplace_back(1);
+    bool thrown = false;
+    try {
+        vec.emplace_back(-1);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    // 失败的位置保留值初始化的元素
+    assert(thrown && vec.size() == 2 && vec[1].value == 0);
+
+    std::vector<int> values = {5, 6, -7, 8};
+    thrown = false;
+    try {
+        vec.grow_by(values.begin(), values.end());
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown && vec.size() == 6 && vec[3].value == 6 && vec[4].value == 0 && vec[5].value == 0);
+    vec.emplace_back(9);
+    assert(vec.back().value == 9);
+    std::cout << "Exception safety passed." << std::endl;
+}
+
+/**
+ * @brief 超过64个元素的申请都失败的分配器
+ */
+template <class T>
+class limited_allocator : public stl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = limited_allocator<U>;
+    };
+
+    limited_allocator() noexcept = default;
+
+    template <class U>
+    limited_allocator(const limited_allocator<U> &) noexcept
+    {}
+
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        if (n > 64) {
+            throw std::bad_alloc();
+        }
+        return stl::allocator<T>::allocate(n, hint);
+    }
+};
+
+void test_failed_segment() {
+    stl::concurrent_vector<int, limited_allocator<int>> vec;
+    // 前两段共48个元素，第三段有64个元素可以申请，第四段申请失败
+    for (int i = 0; i < 112; ++i) {
+        vec.push_back(i);
+    }
+    bool thrown = false;
+    try {
+        vec.push_back(112);
+    } catch (const std::bad_alloc &) {
+        thrown = true;
+    }
+    assert(thrown && vec.size() == 113 && vec.segment_data(3) == nullptr);
+
+    // at()和迭代器解引用检查失败的段
+    thrown = false;
+    try {
+        vec.at(112);
+    } catch (const std::bad_alloc &) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    long sum = 0;
+    try {
+        for (int value : vec) {
+            sum += value;
+        }
+    } catch (const std::bad_alloc &) {
+        thrown = true;
+    }
+    assert(thrown && sum == 111 * 112 / 2 && vec.at(111) == 111);
+    std::cout << "Failed segment passed." << std::endl;
+}
+
+int main() {
+    test_basic();
+    test_concurrent_append();
+    test_exception();
+    test_failed_segment();
+    return 0;
+}
@@ -1,6 +1,285 @@
 #include <iostream>
 #include <deque>
 #include "../src/deque.h"
+#include <string>
+#include <cstring>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+void test_default_init() {
+    stl::deque<unsigned char> buffer;
+    buffer.resize_default_init(1000);
+    assert(buffer.size() == 1000);
+    for (auto it = buffer.begin(); it != buffer.end(); ++it) {
+        *it = 7;
+    }
+    buffer.resize_for_overwrite(10);
+    assert(buffer.size() == 10 && buffer[9] == 7);
+
+    // 逐段写入，每段不超过当前缓冲区剩余的空间
+    std::size_t written = 0;
+    while (written < 5000) {
+        auto space = buffer.append_uninitialized(5000 - written);
+        assert(space.second > 0);
+        std::memset(space.first, static_cast<int>(written % 251), space.second);
+        buffer.commit_append(space.second);
+        written += space.second;
+    }
+    assert(buffer.size() == 5010 && buffer[9] == 7);
+
+    // 部分提交
+    auto space = buffer.append_uninitialized(3);
+    space.first[0] = 1;
+    buffer.commit_append(1);
+    assert(buffer.size() == 5011 && buffer.back() == 1);
+
+    stl::deque<std::string> strings;
+    strings.push_back("a");
+    strings.resize_default_init(300);
+    assert(strings.size() == 300 && strings.front() == "a" && strings.back().empty());
+    strings.push_back("b");
+    assert(strings.back() == "b" && strings.size() == 301);
+    std::cout << "Default init passed." << std::endl;
+}
+
+void test_bulk_append() {
+    stl::deque<int> deq;
+    deq.push_back(0);
+    std::vector<int> source(1000);
+    for (int i = 0; i < 1000; ++i) {
+        source[i] = i + 1;
+    }
+    deq.append_range(source.begin(), source.end());
+    int next = 1001;
+    deq.append(2000, [&]() { return next++; });
+    std::copy(source.begin(), source.end(), stl::unchecked_back_inserter(deq, source.size()));
+    assert(deq.size() == 4001);
+    for (int i = 0; i <= 3000; ++i) {
+        assert(deq[i] == i);
+    }
+    assert(deq[3001] == 1 && deq.back() == 1000);
+    deq.push_back(-1);
+    deq.push_front(-2);
+    assert(deq.back() == -1 && deq.front() == -2 && deq.size() == 4003);
+
+    // 每个缓冲区恰好写满的边界
+    stl::deque<std::string> strings;
+    for (int n = 0; n < 20; ++n) {
+        strings.append(n, [&]() { return std::to_string(strings.size()); });
+    }
+    assert(strings.size() == 190);
+    std::vector<std::string> words(7, "word");
+    strings.append_range(words.begin(), words.end());
+    assert(strings.size() == 197 && strings.back() == "word" && strings[189] == "189");
+    std::cout << "Bulk append passed." << std::endl;
+}
+
+void test_erase_if() {
+    // 删除各种比例的元素，覆盖移动前面和后面两种情况
+    for (int step = 1; step <= 7; ++step) {
+        stl::deque<std::string> deq;
+        for (int i = 0; i < 500; ++i) {
+            deq.push_back(std::to_string(i));
+        }
+        for (int i = 1; i <= 100; ++i) {
+            deq.push_front(std::to_string(-i));
+        }
+        auto removed = stl::erase_if(deq, [&](const std::string & s) { return std::stoi(s) % step != 0; });
+        std::size_t expected = 0;
+        for (int i = -100; i < 500; ++i) {
+            if (i % step == 0) {
+                assert(deq[expected++] == std::to_string(i));
+            }
+        }
+        assert(deq.size() == expected && removed == 600 - expected);
+        deq.push_back("x");
+        deq.push_front("y");
+        assert(deq.back() == "x" && deq.front() == "y");
+    }
+
+    // 删除头部的一段
+    stl::deque<int> numbers;
+    for (int i = 0; i < 300; ++i) {
+        numbers.push_back(i);
+    }
+    numbers.erase(numbers.begin(), numbers.begin() + 250);
+    assert(numbers.size() == 50 && numbers.front() == 250 && numbers.back() == 299);
+    assert(stl::erase(numbers, 260) == 1 && numbers.size() == 49);
+
+    auto it = numbers.unordered_erase(numbers.begin());
+    assert(*it == 299 && numbers.size() == 48 && numbers.back() == 298);
+    std::cout << "Erase if passed." << std::endl;
+}
+
+void test_aligned_buffers() {
+    stl::deque<int, stl::aligned_allocator<int, 64>> deq;
+    static_assert(decltype(deq)::buffer_alignment == 64, "deque alignment");
+    for (int i = 0; i < 1000; ++i) {
+        deq.push_back(i);
+        deq.push_front(-i);
+    }
+    // 地址不连续的位置是新缓冲区的开头，必须对齐
+    std::size_t buffers = 0;
+    for (std::size_t i = 1; i < deq.size(); ++i) {
+        if (&deq[i] != &deq[i - 1] + 1) {
+            assert(reinterpret_cast<std::uintptr_t>(&deq[i]) % 64 == 0);
+            ++buffers;
+        }
+    }
+    assert(buffers > 1 && deq.front() == -999 && deq.back() == 999);
+    std::cout << "Aligned buffers passed." << std::endl;
+}
+
+void test_buffer_policy() {
+    // 缓冲区大小是2的幂个元素，不超过字节预算，至少16个
+    static_assert(stl::deque<char>::buffer_size == 512, "char buffer");
+    static_assert(stl::deque<int>::buffer_size == 128, "int buffer");
+    static_assert(stl::deque<std::array<char, 200>>::buffer_size == 16, "large element buffer");
+    static_assert(stl::deque<int, stl::allocator<int>, stl::page_deque_buffer_policy>::buffer_size == 1024, "page buffer");
+    static_assert(stl::deque<std::array<char, 24>, stl::allocator<std::array<char, 24>>, stl::page_deque_buffer_policy>::buffer_size == 128, "rounded down");
+
+    // 最小的缓冲区，便于覆盖跨缓冲区的迭代器运算
+    stl::deque<int, stl::allocator<int>, stl::deque_buffer_policy<1>> deq;
+    std::deque<int> expected;
+    for (int i = 0; i < 300; ++i) {
+        deq.push_back(i);
+        expected.push_back(i);
+        deq.push_front(-i);
+        expected.push_front(-i);
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        assert(deq[i] == expected[i]);
+    }
+    const auto & cdeq = deq;
+    auto first = deq.begin();
+    auto last = deq.end();
+    assert(static_cast<std::size_t>(last - first) == expected.size() && cdeq[599] == expected[599]);
+    for (std::ptrdiff_t i = 0; i < 600; i += 7) {
+        for (std::ptrdiff_t j = -i; i + j < 600; j += 13) {
+            auto it = first + i;
+            it += j;
+            assert(*it == expected[i + j] && it - first == i + j);
+            it -= j;
+            assert(*it == expected[i] && (last - (600 - i)) == it);
+        }
+    }
+    std::cout << "Buffer policy passed." << std::endl;
+}
+
+/**
+ * @brief 统计缓冲区申请次数的分配器
+ */
+template <class T>
+class counting_allocator : public stl::allocator<T>
+{
+public:
+    static std::size_t allocations;
+
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = counting_allocator<U>;
+    };
+
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) noexcept
+    {}
+
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        ++allocations;
+        return stl::allocator<T>::allocate(n, hint);
+    }
+};
+
+template <class T>
+std::size_t counting_allocator<T>::allocations = 0;
+
+/**
+ * @brief 统计存活对象个数的类型
+ */
+class tracked
+{
+public:
+    static int alive;
+    int value;
+
+    tracked(int v = 0) : value(v) { ++alive; }
+    tracked(const tracked & other) : value(other.value) { ++alive; }
+    tracked & operator=(const tracked &) = default;
+    ~tracked() { --alive; }
+
+    bool operator==(const tracked & other) const { return value == other.value; }
+};
+
+int tracked::alive = 0;
+
+void test_spare_buffers() {
+    using deque_type = stl::deque<int, counting_allocator<int>>;
+    {
+        deque_type deq;
+        for (int i = 0; i < 1000; ++i) {
+            deq.push_back(i);
+        }
+        // 先转一轮，缓冲区个数稳定下来
+        for (int i = 1000; i < 2000; ++i) {
+            deq.pop_front();
+            deq.push_back(i);
+        }
+        // 队列式的一端进一端出，缓冲区全部来自缓存，不再申请内存
+        std::size_t before = counting_allocator<int>::allocations;
+        std::size_t map_before = counting_allocator<int *>::allocations;
+        for (int i = 2000; i < 200000; ++i) {
+            assert(deq.front() == i - 1000);
+            deq.pop_front();
+            deq.push_back(i);
+        }
+        assert(counting_allocator<int>::allocations == before);
+        assert(counting_allocator<int *>::allocations == map_before);
+        assert(deq.size() == 1000 && deq.back() == 199999);
+
+        // 从头部反向流动同样复用缓冲区
+        for (int i = 0; i < 50000; ++i) {
+            deq.pop_back();
+            deq.push_front(-i);
+        }
+        assert(counting_allocator<int>::allocations == before && deq.front() == -49999);
+
+        deq.clear();
+        assert(deq.empty());
+        deq.push_back(1);
+        deq.push_front(0);
+        assert(deq[0] == 0 && deq[1] == 1 && counting_allocator<int>::allocations == before);
+        deq.shrink_to_fit();
+    }
+
+    // 析构、清空、拷贝和移动之后所有元素都被析构
+    {
+        stl::deque<tracked> deq;
+        for (int i = 0; i < 1000; ++i) {
+            deq.push_back(tracked(i));
+            deq.push_front(tracked(-i));
+        }
+        assert(tracked::alive == 2000);
+        stl::deque<tracked> copy(deq);
+        assert(tracked::alive == 4000 && copy == deq);
+        stl::deque<tracked> moved(std::move(copy));
+        assert(tracked::alive == 4000 && copy.empty() && moved.size() == 2000 && moved[0].value == -999);
+        copy = moved;
+        assert(tracked::alive == 6000 && copy.back().value == 999);
+        moved.clear();
+        assert(tracked::alive == 4000 && moved.empty());
+        deq.erase(deq.begin() + 100, deq.end() - 100);
+        assert(tracked::alive == 2200 && deq.size() == 200);
+    }
+    assert(tracked::alive == 0);
+    std::cout << "Spare buffers passed." << std::endl;
+}
 
 int main()
 {
@@ -72,5 +351,12 @@ int main()
     }
     std::cout << std::endl;
 
+    test_default_init();
+    test_bulk_append();
+    test_erase_if();
+    test_aligned_buffers();
+    test_buffer_policy();
+    test_spare_buffers();
+
     return 0;
-}
\ No newline at end of file
+}
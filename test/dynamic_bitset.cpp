@@ -0,0 +1,120 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <cassert>
+#include "../src/dynamic_bitset.h"
+
+void test_kernel(const char * name)
+{
+    // 每种计数内核都必须得到相同的结果
+    std::mt19937_64 rng(1);
+    for (std::size_t size : {0, 1, 63, 64, 65, 255, 256, 257, 1000, 4099}) {
+        stl::dynamic_bitset<> bits(size);
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (rng() % 3 == 0) {
+                bits.set(i);
+                ++expected;
+            }
+        }
+        assert(bits.count() == expected);
+    }
+    std::cout << name << " kernel passed." << std::endl;
+}
+
+void test_basic()
+{
+    stl::dynamic_bitset<> bits(200);
+    assert(bits.size() == 200 && bits.num_words() == 4 && bits.none());
+    bits.set(3).set(64).set(199);
+    assert(bits.test(3) && bits[64] && bits[199] && !bits[4] && bits.count() == 3);
+    bits.reset(64).flip(5);
+    assert(!bits[64] && bits[5] && bits.count() == 3);
+    bits[6] = true;
+    assert(bits.count() == 4 && bits.any());
+
+    // 查找
+    std::vector<std::size_t> found;
+    for (std::size_t pos = bits.find_first(); pos != bits.npos; pos = bits.find_next(pos)) {
+        found.push_back(pos);
+    }
+    assert((found == std::vector<std::size_t>{3, 5, 6, 199}));
+    assert(stl::dynamic_bitset<>(100).find_first() == stl::dynamic_bitset<>::npos);
+
+    // 区间赋值
+    stl::dynamic_bitset<> range(500);
+    range.set_range(10, 300);
+    assert(range.count() == 290 && !range[9] && range[10] && range[299] && !range[300]);
+    range.reset_range(60, 70);
+    assert(range.count() == 280 && !range[60] && range[70]);
+    range.set_range(3, 5);
+    assert(range.count() == 282);
+    range.set();
+    assert(range.all() && range.count() == 500);
+    range.flip();
+    assert(range.none());
+    range.flip();
+    range.resize(700);
+    assert(range.count() == 500 && !range.all());
+    range.resize(900, true);
+    assert(range.count() == 700);
+    range.resize(10);
+    assert(range.count() == 10 && range.all());
+
+    bool thrown = false;
+    try {
+        bits.test(200);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Basic passed." << std::endl;
+}
+
+void test_operators()
+{
+    stl::dynamic_bitset<> a(130), b(130);
+    for (std::size_t i = 0; i < 130; ++i) {
+        a[i] = i % 2 == 0;
+        b[i] = i % 3 == 0;
+    }
+    assert((a & b).count() == 22);
+    assert((a | b).count() == 65 + 44 - 22);
+    assert((a ^ b).count() == 65 + 44 - 44);
+    assert((a - b).count() == 65 - 22);
+    assert((~a).count() == 65 && (~a).find_first() == 1);
+
+    stl::dynamic_bitset<> c(a);
+    assert(c == a);
+    c |= b;
+    assert(c != a);
+    c = std::move(a);
+    assert(c.count() == 65 && c.find_first() == 0);
+
+    bool thrown = false;
+    try {
+        c &= stl::dynamic_bitset<>(10);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Operators passed." << std::endl;
+}
+
+int main()
+{
+    if (stl::set_bit_popcount_kernel(stl::popcount_kernel::portable)) {
+        test_kernel("portable");
+    }
+    if (stl::set_bit_popcount_kernel(stl::popcount_kernel::popcnt)) {
+        test_kernel("popcnt");
+    }
+    if (stl::set_bit_popcount_kernel(stl::popcount_kernel::avx2)) {
+        test_kernel("avx2");
+    }
+    test_basic();
+    test_operators();
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <cassert>
+#include <stdexcept>
+#include "../src/flat_hash_map.h"
+#include "../src/flat_hash_set.h"
+
+void test_kernel(const char * name)
+{
+    // 每种探测内核都必须得到相同的结果
+    stl::flat_hash_set<long> set;
+    for (long i = 0; i < 5000; ++i) {
+        set.insert(i * 64);
+    }
+    for (long i = 0; i < 5000; i += 3) {
+        set.erase(i * 64);
+    }
+    std::size_t found = 0;
+    for (long i = 0; i < 5000 * 64; ++i) {
+        found += set.count(i);
+    }
+    assert(found == set.size());
+    std::cout << name << " kernel found: " << found << std::endl;
+}
+
+/**
+ * @brief 拷贝到第countdown次时抛出异常的类型
+ */
+class throwing_copy
+{
+public:
+    std::string value;
+    static int countdown;
+    static int alive;
+
+    throwing_copy(int v) : value(std::string(20, 'v') + std::to_string(v)) { ++alive; }
+    throwing_copy(const throwing_copy & other) : value(other.value)
+    {
+        if (countdown > 0 && --countdown == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        ++alive;
+    }
+    ~throwing_copy() { --alive; }
+};
+
+int throwing_copy::countdown = 0;
+int throwing_copy::alive = 0;
+
+void test_copy_exception()
+{
+    {
+        stl::flat_hash_map<int, throwing_copy> map;
+        for (int i = 0; i < 100; ++i) {
+            map.try_emplace(i, i);
+        }
+        // 拷贝中途失败时已经拷贝的元素都被销毁
+        throwing_copy::countdown = 50;
+        bool thrown = false;
+        try {
+            stl::flat_hash_map<int, throwing_copy> copy(map);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        throwing_copy::countdown = 0;
+        assert(thrown && throwing_copy::alive == 100 && map.size() == 100);
+    }
+    assert(throwing_copy::alive == 0);
+    std::cout << "Copy exception passed." << std::endl;
+}
+
+int main()
+{
+    if (stl::set_flat_hash_group_kernel(stl::flat_group_kernel::portable)) {
+        test_kernel("portable");
+    }
+    if (stl::set_flat_hash_group_kernel(stl::flat_group_kernel::sse2)) {
+        test_kernel("sse2");
+    }
+    if (stl::set_flat_hash_group_kernel(stl::flat_group_kernel::avx2)) {
+        test_kernel("avx2");
+    }
+    test_copy_exception();
+
+    stl::flat_hash_map<int, std::string> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = std::string("test") + std::to_string(i);
+    }
+    std::cout << "size: " << map.size() << ", bucket_count: " << map.bucket_count() << std::endl;
+    assert(map.size() == 1000);
+    assert(map.at(7) == "test7");
+    assert(map.count(1000) == 0);
+
+    // 重复插入失败
+    auto result = map.insert(stl::pair<const int, std::string>(7, "seven"));
+    assert(!result.second && result.first->second == "test7");
+
+    // 键存在时try_emplace不移动参数
+    std::string value = "seven";
+    result = map.try_emplace(7, std::move(value));
+    assert(!result.second && result.first->second == "test7" && value == "seven");
+    result = map.try_emplace(1000, std::move(value));
+    assert(result.second && map.at(1000) == "seven" && map.erase(1000) == 1);
+
+    // 删除偶数key
+    for (int i = 0; i < 1000; i += 2) {
+        assert(map.erase(i) == 1);
+    }
+    assert(map.size() == 500);
+    for (int i = 0; i < 1000; ++i) {
+        assert((map.find(i) != map.end()) == (i % 2 == 1));
+    }
+
+    // 通过迭代器遍历并删除
+    std::size_t visited = 0;
+    for (auto it = map.begin(); it != map.end();) {
+        ++visited;
+        if (it->first % 3 == 0) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    assert(visited == 500);
+    std::cout << "size after erase: " << map.size() << std::endl;
+
+    // 一次遍历删除
+    std::size_t before = map.size();
+    std::size_t removed = stl::erase_if(map, [](const stl::pair<const int, std::string> & p) { return p.first % 5 == 0; });
+    assert(removed > 0 && map.size() == before - removed && map.count(5) == 0 && map.count(7) == 1);
+
+    // 拷贝和移动
+    stl::flat_hash_map<int, std::string> copy(map);
+    assert(copy.size() == map.size() && copy.at(1) == "test1");
+    stl::flat_hash_map<int, std::string> moved(std::move(copy));
+    assert(moved.size() == map.size() && copy.empty());
+
+    map.clear();
+    assert(map.empty() && map.begin() == map.end());
+
+    stl::flat_hash_set<int> set;
+    for (int i = 0; i < 100; ++i) {
+        set.insert(i * 64);
+    }
+    assert(set.size() == 100 && set.contains(64 * 99) && !set.contains(1));
+    assert(stl::erase_if(set, [](int x) { return x >= 64 * 50; }) == 50 && set.size() == 50 && !set.contains(64 * 50));
+    std::cout << "set size: " << set.size() << ", load factor: " << set.load_factor() << std::endl;
+
+    // 充分混合的哈希函数直接使用，不再做额外的混合
+    stl::flat_hash_set<unsigned long, stl::mixed_hash<unsigned long>> mixed;
+    for (unsigned long i = 0; i < 1000; ++i) {
+        mixed.insert(i * 64);
+    }
+    assert(mixed.size() == 1000 && mixed.contains(64 * 999) && !mixed.contains(1));
+
+    // 异构查找
+    stl::flat_hash_map<std::string, int, stl::string_hash, stl::equal_to<>> routes;
+    routes["/index"] = 1;
+    routes[std::string_view("/login")] = 2;
+    assert(routes.count("/index") == 1 && routes.find(std::string_view("/login"))->second == 2);
+    assert(routes.at("/login") == 2 && !routes.contains("/logout"));
+    stl::flat_hash_set<std::string, stl::string_hash, stl::equal_to<>> names;
+    names.insert("alice");
+    assert(names.contains("alice") && names.count(std::string_view("bob")) == 0);
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
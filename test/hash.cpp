@@ -1,6 +1,28 @@
 #include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
 #include "../src/hash.h"
 
+/**
+ * @brief 统计哈希值低bits位落入的不同桶数
+ */
+template <class Hash, class Key>
+std::size_t low_bits_buckets(const Hash & h, Key (*make)(std::size_t), unsigned bits)
+{
+    std::size_t n = std::size_t(1) << bits;
+    bool * used = new bool[n]();
+    std::size_t buckets = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t index = h(make(i)) & (n - 1);
+        if (!used[index]) {
+            used[index] = true;
+            ++buckets;
+        }
+    }
+    delete[] used;
+    return buckets;
+}
 
 int main()
 {
@@ -12,5 +34,60 @@ int main()
     std::cout << h2(true) << std::endl;
     std::cout << h2(false) << std::endl;
 
+    // 步长为64的key和按16字节对齐的指针，恒等哈希在低位上只能落入极少数桶
+    auto stride = [](std::size_t i) { return static_cast<unsigned long>(i * 64); };
+    auto aligned = [](std::size_t i) { return reinterpret_cast<int *>(0x10000 + i * 16); };
+    const unsigned bits = 12;
+
+    std::size_t identity_buckets = low_bits_buckets(stl::hash<unsigned long>(), +stride, bits);
+    std::size_t fmix_buckets = low_bits_buckets(stl::mixed_hash<unsigned long>(), +stride, bits);
+    std::size_t wyhash_buckets = low_bits_buckets(stl::mixed_hash<unsigned long, stl::wyhash_mixer>(), +stride, bits);
+    std::size_t pointer_buckets = low_bits_buckets(stl::mixed_hash<int *>(), +aligned, bits);
+    std::cout << "stride 64 buckets: identity " << identity_buckets << ", fmix64 " << fmix_buckets
+              << ", wyhash " << wyhash_buckets << ", aligned pointer " << pointer_buckets << std::endl;
+    assert(identity_buckets == 64);
+    // 随机哈希落入4096个桶的期望约为2589个
+    assert(fmix_buckets > 2400 && wyhash_buckets > 2400 && pointer_buckets > 2400);
+
+    static_assert(!stl::hash_is_avalanching<stl::hash<int>>::value, "identity hash is not avalanching");
+    static_assert(stl::hash_is_avalanching<stl::mixed_hash<int>>::value, "mixed hash is avalanching");
+    static_assert(stl::hash_is_avalanching<stl::mixed_hash<int *>>::value, "mixed hash is avalanching");
+    static_assert(!stl::hash_is_avalanching<stl::mixed_hash<int, stl::identity_mixer>>::value, "identity mixer is not avalanching");
+
+    // 字符串和字节序列
+    std::string s1 = "hello world";
+    std::string s2 = "hello world";
+    std::string_view sv = s1;
+    assert(stl::hash<std::string>()(s1) == stl::hash<std::string>()(s2));
+    assert(stl::hash<std::string>()(s1) == stl::hash<std::string_view>()(sv));
+    assert(stl::hash<std::string>()(s1) == stl::hash<stl::byte_span>()(stl::byte_span(s1.data(), s1.size())));
+    assert(stl::hash<std::string>()(s1) != stl::hash<std::string>()("hello worle"));
+    assert(stl::hash_bytes(s1.data(), s1.size(), 1) != stl::hash_bytes(s1.data(), s1.size(), 2));
+    static_assert(stl::hash_is_avalanching<stl::hash<std::string>>::value, "string hash is avalanching");
+
+    // 每个长度的输入都与其他长度不同，且改变任意一个字节都会改变哈希值
+    std::vector<unsigned char> bytes(5000);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 131 + 7);
+    }
+    for (std::size_t len = 0; len <= 600; ++len) {
+        std::size_t h = stl::hash_bytes(bytes.data(), len);
+        assert(h != stl::hash_bytes(bytes.data(), len + 1));
+        if (len > 0) {
+            bytes[len / 2] ^= 1;
+            assert(h != stl::hash_bytes(bytes.data(), len));
+            bytes[len / 2] ^= 1;
+        }
+    }
+
+    // AVX2和可移植实现的结果必须完全相同
+    if (stl::cpu_has_avx2()) {
+        for (std::size_t len = 241; len <= bytes.size(); len += 37) {
+            assert(stl::__hash_bytes_long(bytes.data(), len, 0, false) == stl::__hash_bytes_long(bytes.data(), len, 0, true));
+        }
+        std::cout << "avx2 long hash matches portable" << std::endl;
+    }
+
+    std::cout << "All tests passed!" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
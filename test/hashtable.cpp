@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cassert>
 #include "../src/functional.h"
 #include "../src/hashtable.h"
 
@@ -15,8 +16,87 @@ public:
     }
 };
 
+template <class RangePolicy>
+void test_range_policy(const char * name)
+{
+    // 每种桶索引策略都必须能找到所有插入的key，并在重建后保持不变
+    stl::hashtable<long, long, stl::hash<long>, stl::equal_to<long>, keyExtractor<stl::pair<const long, long>>, stl::allocator<long>, RangePolicy> h(50, stl::hash<long>(), stl::equal_to<long>());
+    for (long i = 0; i < 10000; ++i) {
+        h.insert_unique(stl::pair<const long, long>(i * 64, i));
+    }
+    for (long i = 0; i < 10000; ++i) {
+        assert(h.find(i * 64) != h.end() && h.find(i * 64)->second == i);
+        assert(h.bucket(i * 64) < h.bucket_count());
+        assert(h.count(i * 64 + 1) == 0);
+    }
+    std::size_t visited = 0;
+    for (auto it = h.begin(); it != h.end(); ++it) {
+        ++visited;
+    }
+    assert(visited == h.size());
+    std::cout << name << " bucket_count: " << h.bucket_count() << std::endl;
+}
+
+void test_incremental_rehash()
+{
+    // 渐进式重建期间，新旧两个桶数组中的元素都必须能被找到、遍历和删除
+    stl::hashtable<long, long, stl::hash<long>, stl::equal_to<long>, keyExtractor<stl::pair<const long, long>>, stl::allocator<long>> h(50, stl::hash<long>(), stl::equal_to<long>());
+    h.incremental_rehash(true);
+    std::size_t rehashing_inserts = 0;
+    for (long i = 0; i < 20000; ++i) {
+        h.insert_unique(stl::pair<const long, long>(i, i));
+        if (h.rehashing()) {
+            ++rehashing_inserts;
+            if (i % 97 == 0) {
+                for (long j = 0; j <= i; ++j) {
+                    assert(h.count(j) == 1);
+                }
+                std::size_t visited = 0;
+                for (auto it = h.begin(); it != h.end(); ++it) {
+                    ++visited;
+                }
+                assert(visited == h.size());
+            }
+        }
+    }
+    assert(rehashing_inserts > 0);
+
+    // 重建期间删除和可重复插入
+    while (!h.rehashing()) {
+        h.insert_unique(stl::pair<const long, long>(static_cast<long>(h.size()), 0));
+    }
+    long n = static_cast<long>(h.size());
+    for (long i = 0; i < n; i += 2) {
+        assert(h.erase(i) == 1);
+    }
+    h.insert_equal(stl::pair<const long, long>(1, 100));
+    assert(h.count(1) == 2);
+    for (auto it = h.begin(); it != h.end();) {
+        if (it->first % 3 == 0) {
+            it = h.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    while (h.rehash_step(4)) {
+    }
+    for (long i = 0; i < n; ++i) {
+        assert(h.count(i) == (i % 2 == 1 && i % 3 != 0 ? (i == 1 ? 2u : 1u) : 0u));
+    }
+    std::cout << "incremental rehash size: " << h.size() << ", bucket_count: " << h.bucket_count()
+              << ", inserts during rehash: " << rehashing_inserts << std::endl;
+}
+
 int main()
 {
+    test_incremental_rehash();
+
+    test_range_policy<stl::mod_range_policy>("mod");
+    test_range_policy<stl::pow2_range_policy>("pow2");
+    test_range_policy<stl::fastrange_policy>("fastrange");
+    test_range_policy<stl::prime_range_policy>("prime");
+
+
     stl::hashtable<int, int, stl::hash<int>, stl::equal_to<int>, keyExtractor<stl::pair<const int, int>>, stl::allocator<int>> h1(50, stl::hash<int>(), stl::equal_to<int>());
     std::cout << h1.bucket_count() << std::endl;
 
@@ -67,6 +67,14 @@ int main() {
     std::cout << "my_list size: " << my_list.size() << std::endl;
     print(my_list);
     std::cout << "my_list is empty: " << my_list.empty() << std::endl;
+
+    stl::list<int> numbers;
+    for (int i = 0; i < 10; ++i) {
+        numbers.push_back(i % 4);
+    }
+    assert(stl::erase_if(numbers, [](int x) { return x == 1; }) == 3);
+    assert(stl::erase(numbers, 0) == 3 && numbers.size() == 4);
+    print(numbers);
     
     return 0;
 }
@@ -3,6 +3,13 @@
 #include "../src/memory.h"
 #include <string>
 #include <vector>
+#include <thread>
+#include <cassert>
+#include <cstdint>
+#include "../src/list.h"
+#include "../src/unordered_map.h"
+#include "../src/vector.h"
+#include "../src/deque.h"
 
 void test_simple_alloc() {
     // 定义分配器
@@ -62,7 +69,330 @@ void test_simple_alloc() {
     std::cout << "Size of int_vector after clear: " << int_vector.size() << std::endl;
 }
 
+void test_pool_alloc() {
+    // 单个节点来自节点池，释放后会被复用
+    stl::pool_allocator<long> alloc;
+    long * a = alloc.allocate(1);
+    alloc.deallocate(a, 1);
+    long * b = alloc.allocate(1);
+    assert(a == b);
+    alloc.deallocate(b, 1);
+
+    // 多个元素退回到operator new
+    long * array = alloc.allocate(100);
+    array[99] = 1;
+    alloc.deallocate(array, 100);
+
+    // rebind之后的分配器相等
+    using string_alloc = stl::pool_allocator<long>::rebind<std::string>::other;
+    assert(string_alloc() == string_alloc(alloc));
+
+    // 节点容器
+    stl::list<int, stl::pool_allocator<int>> pool_list;
+    for (int i = 0; i < 10000; ++i) {
+        pool_list.push_back(i);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        pool_list.pop_front();
+    }
+    assert(pool_list.size() == 5000 && pool_list.front() == 5000);
+    std::cout << "Pool list size: " << pool_list.size() << std::endl;
+
+    stl::unordered_map<int, std::string, stl::hash<int>, stl::equal_to<int>,
+                       stl::pool_allocator<stl::pair<const int, std::string>>> pool_map;
+    for (int i = 0; i < 1000; ++i) {
+        pool_map[i] = std::to_string(i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        pool_map.erase(i);
+    }
+    assert(pool_map.size() == 500 && pool_map.at(999) == "999");
+    std::cout << "Pool map size: " << pool_map.size() << std::endl;
+
+    // 线程缓存，一个线程分配、另一个线程释放
+    std::vector<long *> pointers(10000);
+    std::thread producer([&]() {
+        stl::pool_allocator<long, true> cached;
+        for (std::size_t i = 0; i < pointers.size(); ++i) {
+            pointers[i] = cached.allocate(1);
+            *pointers[i] = static_cast<long>(i);
+        }
+    });
+    producer.join();
+    std::vector<std::thread> consumers;
+    for (int t = 0; t < 4; ++t) {
+        consumers.emplace_back([&, t]() {
+            stl::pool_allocator<long, true> cached;
+            for (std::size_t i = t; i < pointers.size(); i += 4) {
+                assert(*pointers[i] == static_cast<long>(i));
+                cached.deallocate(pointers[i], 1);
+            }
+            stl::list<int, stl::pool_allocator<int, true>> local;
+            for (int i = 0; i < 1000; ++i) {
+                local.push_back(i);
+            }
+        });
+    }
+    for (auto & consumer : consumers) {
+        consumer.join();
+    }
+    std::cout << "Thread cached pool passed." << std::endl;
+}
+
+/**
+ * @brief 统计未归还字节数的上游资源
+ */
+class counting_resource
+    : public stl::memory_resource
+{
+public:
+    std::size_t outstanding = 0;
+    std::size_t allocations = 0;
+
+protected:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        outstanding += bytes;
+        ++allocations;
+        return stl::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        outstanding -= bytes;
+        stl::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const stl::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+void test_memory_resource() {
+    counting_resource upstream;
+
+    // 单调缓冲区：先用初始缓冲区，用尽后向上游申请，release一次性归还
+    {
+        alignas(std::max_align_t) char buffer[256];
+        stl::monotonic_buffer_resource arena(buffer, sizeof(buffer), &upstream);
+        void * first = arena.allocate(100, 8);
+        assert(first == buffer);
+        void * aligned = arena.allocate(8, 64);
+        assert(reinterpret_cast<std::size_t>(aligned) % 64 == 0);
+        arena.deallocate(first, 100, 8);
+        for (int i = 0; i < 100; ++i) {
+            arena.allocate(100, 16);
+        }
+        assert(upstream.outstanding > 0);
+        arena.release();
+        assert(upstream.outstanding == 0);
+        assert(arena.allocate(16, 8) == buffer);
+    }
+    assert(upstream.outstanding == 0);
+
+    // 空资源总是抛出异常
+    bool thrown = false;
+    try {
+        stl::null_memory_resource()->allocate(1);
+    } catch (const std::bad_alloc &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 池资源：释放的块被同一大小类复用，超大分配直接来自上游
+    {
+        stl::pool_options options;
+        options.largest_required_pool_block = 1000;
+        stl::unsynchronized_pool_resource pool(options, &upstream);
+        assert(pool.options().largest_required_pool_block == 1024);
+        void * a = pool.allocate(24, 8);
+        pool.deallocate(a, 24, 8);
+        void * b = pool.allocate(32, 8);
+        assert(a == b);
+        std::size_t before = upstream.outstanding;
+        void * big = pool.allocate(5000, 8);
+        assert(upstream.outstanding > before);
+        pool.deallocate(big, 5000, 8);
+        assert(upstream.outstanding == before);
+        void * wide = pool.allocate(64, 128);
+        assert(reinterpret_cast<std::size_t>(wide) % 128 == 0);
+        pool.deallocate(wide, 64, 128);
+        pool.allocate(5000, 8);
+        pool.release();
+        assert(upstream.outstanding > 0);   // 大小类数组在析构时才归还
+    }
+    assert(upstream.outstanding == 0);
+
+    // 默认资源
+    stl::memory_resource * previous = stl::set_default_resource(&upstream);
+    assert(previous == stl::new_delete_resource());
+    assert(stl::polymorphic_allocator<int>().resource() == &upstream);
+    stl::set_default_resource(nullptr);
+    assert(stl::get_default_resource() == stl::new_delete_resource());
+
+    // 多态分配器在各容器中使用
+    {
+        stl::monotonic_buffer_resource arena(&upstream);
+        stl::polymorphic_allocator<int> alloc(&arena);
+        assert(alloc == stl::polymorphic_allocator<double>(&arena));
+        assert(alloc != stl::polymorphic_allocator<int>());
+
+        stl::vector<int, stl::polymorphic_allocator<int>> vec(alloc);
+        for (int i = 0; i < 1000; ++i) {
+            vec.push_back(i);
+        }
+        assert(vec.size() == 1000 && vec[999] == 999);
+        assert(vec.get_allocator().resource() == &arena);
+
+        stl::deque<int, stl::polymorphic_allocator<int>> deq(alloc);
+        for (int i = 0; i < 1000; ++i) {
+            deq.push_back(i);
+            deq.push_front(-i);
+        }
+        assert(deq.size() == 2000 && deq.front() == -999 && deq.back() == 999);
+
+        stl::list<std::string, stl::polymorphic_allocator<std::string>> lst(alloc);
+        for (int i = 0; i < 100; ++i) {
+            lst.push_back(std::to_string(i));
+        }
+        assert(lst.size() == 100 && lst.back() == "99");
+        assert(upstream.allocations > 0);
+    }
+    assert(upstream.outstanding == 0);
+
+    // 不同资源的容器之间赋值、交换，元素始终由持有它们的资源释放
+    {
+        stl::unsynchronized_pool_resource pool_a(&upstream);
+        stl::deque<std::string, stl::polymorphic_allocator<std::string>> a(&pool_a);
+        a.push_back("a");
+        {
+            stl::unsynchronized_pool_resource pool_b(&upstream);
+            stl::deque<std::string, stl::polymorphic_allocator<std::string>> b(&pool_b);
+            for (int i = 0; i < 1000; ++i) {
+                b.push_back(std::to_string(i));
+            }
+            a = b;
+            assert(a.size() == 1000 && a.get_allocator().resource() == &pool_a);
+
+            // 拷贝构造不传播资源
+            stl::deque<std::string, stl::polymorphic_allocator<std::string>> copy(b);
+            assert(copy == b && copy.get_allocator().resource() == stl::get_default_resource());
+
+            stl::deque<std::string, stl::polymorphic_allocator<std::string>> c(&pool_b);
+            c.push_back("c");
+            c.swap(a);
+            assert(c.size() == 1000 && c.get_allocator().resource() == &pool_a);
+            assert(a.back() == "c" && a.get_allocator().resource() == &pool_b);
+            a.swap(c);
+        }
+        a.clear();
+        a.push_back("b");
+        assert(a.size() == 1 && a.get_allocator().resource() == &pool_a);
+    }
+    assert(upstream.outstanding == 0);
+
+    {
+        stl::synchronized_pool_resource pool(&upstream);
+        using map_alloc = stl::polymorphic_allocator<stl::pair<const int, std::string>>;
+        stl::unordered_map<int, std::string, stl::hash<int>, stl::equal_to<int>, map_alloc> map{map_alloc(&pool)};
+        for (int i = 0; i < 10000; ++i) {
+            map[i] = std::to_string(i);
+        }
+        for (int i = 0; i < 10000; i += 2) {
+            map.erase(i);
+        }
+        assert(map.size() == 5000 && map.at(9999) == "9999");
+
+        // 多个线程共享同一个同步池
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&pool]() {
+                stl::list<int, stl::polymorphic_allocator<int>> local(&pool);
+                for (int i = 0; i < 1000; ++i) {
+                    local.push_back(i);
+                }
+                assert(local.size() == 1000);
+            });
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+    assert(upstream.outstanding == 0);
+    std::cout << "Memory resources passed." << std::endl;
+}
+
+void test_huge_page_alloc() {
+    stl::huge_page_allocator<long> alloc;
+
+    // 小分配来自operator new
+    long * small = alloc.allocate(10);
+    small[9] = 9;
+    alloc.deallocate(small, 10);
+
+    // 大分配按大页对齐并取整
+    auto large = alloc.allocate_at_least(300000);
+    assert(large.count * sizeof(long) % stl::huge_page_allocator<long>::huge_page_size == 0);
+    assert(large.count >= 300000);
+    assert(reinterpret_cast<std::size_t>(large.ptr) % stl::huge_page_allocator<long>::huge_page_size == 0);
+    large.ptr[0] = 1;
+    large.ptr[large.count - 1] = 2;
+    alloc.deallocate(large.ptr, large.count);
+
+    // NUMA策略在单节点机器和不存在的节点上都不影响分配
+    for (unsigned long mask : {1ul, 1ul << 63}) {
+        stl::huge_page_allocator<int> bound(stl::numa_policy::bind, mask);
+        stl::vector<int, stl::huge_page_allocator<int>> vec(bound);
+        for (int i = 0; i < 2000000; ++i) {
+            vec.push_back(i);
+        }
+        assert(vec[1999999] == 1999999 && vec.get_allocator() == bound);
+    }
+    stl::huge_page_allocator<char> interleaved(stl::numa_policy::interleave, 3);
+    assert(interleaved != stl::huge_page_allocator<char>());
+    char * bytes = interleaved.allocate(4 << 20);
+    bytes[(4 << 20) - 1] = 1;
+    interleaved.deallocate(bytes, 4 << 20);
+
+    stl::deque<int, stl::huge_page_allocator<int>> deq;
+    for (int i = 0; i < 10000; ++i) {
+        deq.push_back(i);
+    }
+    assert(deq.back() == 9999);
+    std::cout << "Huge page allocator passed." << std::endl;
+}
+
+void test_aligned_alloc() {
+    stl::aligned_allocator<char, 64> alloc;
+    for (std::size_t n = 1; n < 200; n += 7) {
+        char * ptr = alloc.allocate(n);
+        assert(reinterpret_cast<std::uintptr_t>(ptr) % 64 == 0);
+        std::memset(ptr, 1, n);
+        alloc.deallocate(ptr, n);
+    }
+    assert(alloc.allocate(0) == nullptr);
+
+    // rebind保持对齐
+    using rebound = stl::aligned_allocator<char, 64>::rebind<double>::other;
+    static_assert(rebound::alignment == 64, "rebind keeps alignment");
+    static_assert(stl::__allocator_alignment<rebound>::value == 64, "alignment trait");
+    static_assert(stl::__allocator_alignment<stl::allocator<double>>::value == alignof(double), "default alignment");
+
+    stl::aligned_allocator<int, 128> wide;
+    int * ints = wide.allocate(1000);
+    assert(reinterpret_cast<std::uintptr_t>(ints) % 128 == 0);
+    int * same = stl::assume_aligned<128>(ints);
+    assert(same == ints);
+    wide.deallocate(ints, 1000);
+    std::cout << "Aligned allocator passed." << std::endl;
+}
+
 int main() {
     test_simple_alloc();
+    test_pool_alloc();
+    test_memory_resource();
+    test_huge_page_alloc();
+    test_aligned_alloc();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdio>
+#include <unistd.h>
+#include "../src/mmap_vector.h"
+
+class record
+{
+public:
+    std::uint64_t id;
+    double value;
+};
+
+void test_persist(const std::string & path) {
+    std::remove(path.c_str());
+    {
+        stl::mmap_vector<record> vec(path);
+        assert(vec.empty() && vec.is_open());
+        for (std::uint64_t i = 0; i < 100000; ++i) {
+            vec.push_back(record{i, i * 0.5});
+        }
+        assert(vec.size() == 100000 && vec.capacity() >= 100000);
+        vec.push_back(vec[10]);
+        assert(vec.back().id == 10);
+        vec.emplace_back(record{7, 7.0});
+        vec.shrink_to_fit();
+        assert(vec.capacity() == vec.size());
+        vec.sync();
+    }
+
+    // 重新打开只读取头部
+    {
+        stl::mmap_vector<record> vec(path);
+        assert(vec.size() == 100002 && vec[99999].id == 99999 && vec[99999].value == 99999 * 0.5);
+        assert(vec.back().id == 7);
+        vec.pop_back();
+        vec.pop_back();
+        vec.resize(100010);
+        assert(vec[100005].id == 0 && vec.size() == 100010);
+        vec.resize(100000);
+    }
+
+    // 私有映射的修改不写回文件
+    {
+        stl::mmap_vector<record> vec(path, stl::mmap_mode::private_copy);
+        assert(vec.size() == 100000);
+        vec[0].id = 12345;
+        for (std::uint64_t i = 0; i < 1000; ++i) {
+            vec.push_back(record{i, 0.0});
+        }
+        assert(vec.size() == 101000 && vec[0].id == 12345 && vec[99999].id == 99999);
+    }
+    {
+        stl::mmap_vector<record> vec(path, stl::mmap_mode::private_copy);
+        assert(vec.size() == 100000 && vec[0].id == 0);
+
+        // 移动
+        stl::mmap_vector<record> moved(std::move(vec));
+        assert(!vec.is_open() && moved.size() == 100000);
+        record extra[3] = {{1, 1}, {2, 2}, {3, 3}};
+        moved.append(extra, extra + 3);
+        assert(moved.size() == 100003 && moved.back().id == 3);
+
+        // 追加自身的元素，扩容时映射会移动
+        for (int round = 0; round < 4; ++round) {
+            moved.shrink_to_fit();
+            moved.append(moved.data(), moved.data() + moved.size());
+        }
+        assert(moved.size() == 100003 * 16 && moved.back().id == 3 && moved[100003 * 15 + 99999].id == 99999);
+    }
+    std::cout << "Persist passed." << std::endl;
+}
+
+void test_errors(const std::string & path) {
+    // 元素大小不一致
+    bool thrown = false;
+    try {
+        stl::mmap_vector<std::uint32_t> wrong(path);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 私有映射要求文件存在
+    thrown = false;
+    try {
+        stl::mmap_vector<record> missing(path + ".missing", stl::mmap_mode::private_copy);
+    } catch (const std::system_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    stl::mmap_vector<record> closed;
+    assert(closed.size() == 0 && closed.begin() == closed.end());
+    thrown = false;
+    try {
+        record one{1, 1.0};
+        closed.append(&one, &one + 1);
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        closed.resize(0);
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        closed.pop_back();
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    assert(thrown && closed.size() == 0);
+    std::cout << "Errors passed." << std::endl;
+}
+
+int main() {
+    std::string path = "mmap_vector_test_" + std::to_string(getpid()) + ".bin";
+    test_persist(path);
+    test_errors(path);
+    std::remove(path.c_str());
+    return 0;
+}
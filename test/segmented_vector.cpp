@@ -0,0 +1,112 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "../src/segmented_vector.h"
+
+void test_stability() {
+    stl::segmented_vector<int> vec;
+    assert(vec.empty() && vec.begin() == vec.end());
+    std::vector<int *> addresses;
+    for (int i = 0; i < 10000; ++i) {
+        addresses.push_back(&vec.emplace_back(i));
+    }
+    // 增长时不移动已有元素
+    for (int i = 0; i < 10000; ++i) {
+        assert(&vec[i] == addresses[i] && *addresses[i] == i);
+    }
+    assert(vec.size() == 10000 && vec.capacity() % vec.segment_size == 0);
+    assert(vec.front() == 0 && vec.back() == 9999 && vec.at(1234) == 1234);
+
+    // 每段的元素连续存放
+    assert(vec.segment_data(1) == &vec[vec.segment_size]);
+    assert(vec.segment_data(1) + vec.segment_mask == &vec[2 * vec.segment_size - 1]);
+
+    bool thrown = false;
+    try {
+        vec.at(10000);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Pointer stability passed." << std::endl;
+}
+
+void test_iterator() {
+    // 每段4个元素，便于覆盖跨段的情况
+    using vector_type = stl::segmented_vector<int, stl::allocator<int>, 2>;
+    for (int n = 0; n <= 13; ++n) {
+        vector_type vec;
+        for (int i = 0; i < n; ++i) {
+            vec.push_back(i);
+        }
+        assert(vec.end() - vec.begin() == n);
+        int expected = 0;
+        for (int value : vec) {
+            assert(value == expected++);
+        }
+        assert(expected == n);
+        for (int i = 0; i <= n; ++i) {
+            auto it = vec.begin() + i;
+            assert(it - vec.begin() == i && vec.end() - it == n - i);
+            assert(it == vec.end() - (n - i));
+            if (i < n) {
+                assert(*it == i && vec.begin()[i] == i);
+            }
+        }
+        if (n > 0) {
+            auto it = vec.end();
+            --it;
+            assert(*it == n - 1);
+            assert(*vec.rbegin() == n - 1);
+        }
+    }
+
+    vector_type vec{5, 3, 9, 1, 7, 2, 8, 6, 4, 0};
+    std::sort(vec.begin(), vec.end());
+    for (int i = 0; i < 10; ++i) {
+        assert(vec[i] == i);
+    }
+    vector_type::const_iterator it = vec.begin();
+    assert(it == vec.cbegin() && std::find(vec.cbegin(), vec.cend(), 7) - it == 7);
+    std::cout << "Iterator passed." << std::endl;
+}
+
+void test_modify() {
+    stl::segmented_vector<std::string, stl::allocator<std::string>, 3> vec;
+    vec.resize(20, "x");
+    assert(vec.size() == 20 && vec[19] == "x" && vec.segment_count() == 3);
+    vec.push_back(std::string(40, 'y'));
+    vec.pop_back();
+    vec.resize(5);
+    assert(vec.size() == 5 && vec.segment_count() == 3);
+
+    // 逐段释放空段
+    vec.shrink_to_fit();
+    assert(vec.segment_count() == 1 && vec.capacity() == 8);
+    vec.reserve(30);
+    assert(vec.segment_count() == 4 && vec.size() == 5);
+
+    stl::segmented_vector<std::string, stl::allocator<std::string>, 3> copy(vec);
+    assert(copy == vec);
+    copy.push_back("z");
+    assert(copy != vec);
+    stl::segmented_vector<std::string, stl::allocator<std::string>, 3> moved(std::move(copy));
+    assert(moved.size() == 6 && moved.back() == "z" && copy.empty());
+    vec = moved;
+    assert(vec == moved);
+    vec.clear();
+    vec.shrink_to_fit();
+    assert(vec.empty() && vec.segment_count() == 0 && vec.begin() == vec.end());
+    swap(vec, moved);
+    assert(vec.size() == 6 && moved.empty());
+    std::cout << "Modifiers passed." << std::endl;
+}
+
+int main() {
+    test_stability();
+    test_iterator();
+    test_modify();
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <cassert>
+#include "../src/small_vector.h"
+
+static std::size_t allocations = 0;
+
+/**
+ * @brief 统计堆分配次数的分配器
+ */
+template <class T>
+class counting_allocator : public stl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = counting_allocator<U>;
+    };
+
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) noexcept
+    {}
+
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        ++allocations;
+        return stl::allocator<T>::allocate(n, hint);
+    }
+};
+
+void test_inline() {
+    // 不超过N个元素时不分配堆内存
+    std::size_t before = allocations;
+    stl::small_vector<int, 8, counting_allocator<int>> vec;
+    assert(vec.capacity() == 8 && vec.is_inline());
+    for (int i = 0; i < 8; ++i) {
+        vec.push_back(i);
+    }
+    assert(allocations == before && vec.is_inline());
+
+    // 超过N个元素后转移到堆上
+    vec.push_back(8);
+    assert(allocations == before + 1 && !vec.is_inline());
+    for (int i = 0; i < 9; ++i) {
+        assert(vec[i] == i);
+    }
+
+    // 缩小后搬回内联空间
+    vec.erase(vec.begin() + 4, vec.end());
+    vec.shrink_to_fit();
+    assert(vec.is_inline() && vec.size() == 4 && vec[3] == 3);
+
+    vec.insert(vec.begin(), {-2, -1});
+    assert(vec.size() == 6 && vec.front() == -2 && vec.is_inline());
+    std::cout << "Inline storage passed." << std::endl;
+}
+
+void test_copy_move() {
+    stl::small_vector<std::string, 4> small{"a", "b", "c"};
+    stl::small_vector<std::string, 4> big;
+    for (int i = 0; i < 10; ++i) {
+        big.push_back(std::string(30, 'x') + std::to_string(i));
+    }
+
+    stl::small_vector<std::string, 4> copy(small);
+    assert(copy.size() == 3 && copy[2] == "c" && small[2] == "c");
+    copy = big;
+    assert(copy.size() == 10 && copy[9] == big[9]);
+
+    // 堆上的元素移动时只转移指针
+    const std::string * data = big.data();
+    stl::small_vector<std::string, 4> moved(std::move(big));
+    assert(moved.data() == data && big.empty() && big.is_inline());
+
+    // 内联的元素移动时逐个搬移
+    stl::small_vector<std::string, 4> moved_small(std::move(small));
+    assert(moved_small.size() == 3 && moved_small[0] == "a" && small.empty());
+
+    moved.swap(moved_small);
+    assert(moved.size() == 3 && moved_small.size() == 10 && moved[1] == "b");
+    swap(moved, moved_small);
+    assert(moved.size() == 10 && moved_small.size() == 3);
+
+    moved_small = std::move(moved);
+    assert(moved_small.size() == 10 && moved.empty() && moved.capacity() == 4);
+
+    // 与vector共享接口
+    stl::small_vector<std::unique_ptr<int>, 2> ptrs;
+    for (int i = 0; i < 5; ++i) {
+        ptrs.emplace(ptrs.begin(), new int(i));
+    }
+    assert(*ptrs.front() == 4 && *ptrs.back() == 0);
+    stl::vector<std::unique_ptr<int>, stl::__small_vector_allocator<std::unique_ptr<int>, 2>> & as_vector = ptrs;
+    as_vector.pop_back();
+    assert(ptrs.size() == 4);
+    std::cout << "Copy and move passed." << std::endl;
+}
+
+int main() {
+    test_inline();
+    test_copy_move();
+    return 0;
+}
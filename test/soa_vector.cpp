@@ -0,0 +1,139 @@
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include "../src/soa_vector.h"
+
+void test_basic() {
+    stl::soa_vector<int, double, std::string> vec;
+    assert(vec.empty() && vec.begin() == vec.end());
+    for (int i = 0; i < 100; ++i) {
+        vec.emplace_back(i, i * 0.5, std::to_string(i));
+    }
+    vec.push_back(std::make_tuple(100, 50.0, std::string("100")));
+    assert(vec.size() == 101 && vec.capacity() >= 101);
+
+    // 每个字段是连续且对齐的数组
+    assert(reinterpret_cast<std::uintptr_t>(vec.data<0>()) % vec.alignment == 0);
+    assert(reinterpret_cast<std::uintptr_t>(vec.data<1>()) % vec.alignment == 0);
+    assert(reinterpret_cast<std::uintptr_t>(vec.data<2>()) % vec.alignment == 0);
+    for (int i = 0; i <= 100; ++i) {
+        assert(vec.data<0>()[i] == i && vec.data<1>()[i] == i * 0.5 && vec.data<2>()[i] == std::to_string(i));
+    }
+
+    // 代理引用
+    auto [id, value, name] = vec[7];
+    assert(id == 7 && value == 3.5 && name == "7");
+    id = 70;
+    std::get<2>(vec.back()) = "last";
+    assert(std::get<0>(vec[7]) == 70 && vec.data<2>()[100] == "last");
+    vec[8] = std::make_tuple(80, 40.0, std::string("80"));
+    assert(std::get<0>(vec.at(8)) == 80 && std::get<2>(vec[8]) == "80");
+
+    bool thrown = false;
+    try {
+        vec.at(101);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Basic passed." << std::endl;
+}
+
+void test_iterator() {
+    stl::soa_vector<int, char> vec{{1, 'a'}, {2, 'b'}, {3, 'c'}};
+    int sum = 0;
+    std::string chars;
+    for (auto [number, c] : vec) {
+        sum += number;
+        chars += c;
+    }
+    assert(sum == 6 && chars == "abc");
+
+    auto it = std::find_if(vec.begin(), vec.end(), [](const std::tuple<int &, char &> & e) { return std::get<1>(e) == 'b'; });
+    assert(it - vec.begin() == 1 && std::get<0>(*it) == 2);
+    stl::soa_vector<int, char>::const_iterator cit = it;
+    assert(cit == it && cit + 2 == vec.cend() && std::get<1>(cit[-1]) == 'a');
+    assert(vec.end() - vec.begin() == 3 && *(vec.end() - 1) == std::make_tuple(3, 'c'));
+    std::cout << "Iterator passed." << std::endl;
+}
+
+void test_modify() {
+    stl::soa_vector<std::string, int> vec;
+    vec.reserve(3);
+    std::size_t cap = vec.capacity();
+    vec.emplace_back("a", 1);
+    vec.emplace_back("b", 2);
+    vec.emplace_back("c", 3);
+    assert(vec.capacity() == cap);
+    // 参数引用容器内的元素时扩容也是安全的
+    vec.emplace_back(vec.data<0>()[0], std::get<1>(vec[2]));
+    assert(vec.size() == 4 && std::get<0>(vec[3]) == "a" && std::get<1>(vec[3]) == 3);
+
+    stl::soa_vector<std::string, int> copy(vec);
+    assert(copy == vec);
+    copy.pop_back();
+    assert(copy != vec && copy.size() == 3);
+    vec.resize(6);
+    assert(vec.size() == 6 && std::get<0>(vec[5]).empty() && std::get<1>(vec[5]) == 0);
+    vec.resize(2);
+    vec.shrink_to_fit();
+    assert(vec.size() == 2 && vec.capacity() == 2 && std::get<0>(vec.back()) == "b");
+    stl::soa_vector<std::string, int> moved(std::move(vec));
+    assert(moved.size() == 2 && vec.empty());
+    vec = copy;
+    assert(vec == copy);
+    swap(vec, moved);
+    assert(vec.size() == 2 && moved.size() == 3);
+    vec.clear();
+    assert(vec.empty() && vec.capacity() == 2);
+    std::cout << "Modifiers passed." << std::endl;
+}
+
+class thrower
+{
+public:
+    static int budget;
+    int value;
+
+    thrower(int v) : value(v) {}
+
+    thrower(const thrower & other) : value(other.value)
+    {
+        if (--budget < 0) throw std::runtime_error("copy");
+    }
+};
+
+int thrower::budget = 1000;
+
+void test_exception() {
+    // 拷贝可能抛出异常的字段先拷贝，失败时原有元素不变
+    stl::soa_vector<std::string, thrower> vec;
+    for (int i = 0; i < 4; ++i) {
+        vec.emplace_back(std::to_string(i), i);
+    }
+    assert(vec.capacity() == 4);
+    thrower::budget = 2;
+    bool thrown = false;
+    try {
+        vec.emplace_back("4", 4);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    thrower::budget = 1000;
+    assert(thrown && vec.size() == 4 && vec.capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(vec.data<0>()[i] == std::to_string(i) && vec.data<1>()[i].value == i);
+    }
+    std::cout << "Exception safety passed." << std::endl;
+}
+
+int main() {
+    test_basic();
+    test_iterator();
+    test_modify();
+    test_exception();
+    return 0;
+}
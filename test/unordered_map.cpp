@@ -1,6 +1,38 @@
 #include <iostream>
 #include <string>
+#include <cassert>
 #include "../src/unordered_map.h"
+#include "../src/unordered_set.h"
+#include "../src/unordered_multimap.h"
+
+// 统计key的堆分配次数，用于确认异构查找不会构造临时key
+static std::size_t allocations = 0;
+
+template <class T>
+class counting_allocator : public stl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = counting_allocator<U>;
+    };
+
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) noexcept
+    {}
+
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        ++allocations;
+        return stl::allocator<T>::allocate(n, hint);
+    }
+};
+
+using counted_string = std::basic_string<char, std::char_traits<char>, counting_allocator<char>>;
 
 int main()
 {
@@ -13,4 +45,46 @@ int main()
     {
         std::cout << map[i] << std::endl;
     }
-}
\ No newline at end of file
+
+    // 字符串作为key
+    stl::unordered_map<std::string, int> words;
+    for (int i = 0; i < 100; ++i)
+    {
+        words[std::string("word") + std::to_string(i)] = i;
+    }
+    std::cout << "word42: " << words["word42"] << ", size: " << words.size() << std::endl;
+
+    // 异构查找
+    stl::unordered_map<counted_string, int, stl::string_hash, stl::equal_to<>> routes;
+    routes["/index/with/a/long/enough/path"] = 1;
+    routes["/login/with/a/long/enough/path"] = 2;
+    std::string_view view = "/login/with/a/long/enough/path";
+    std::size_t before = allocations;
+    assert(routes.count(view) == 1);
+    assert(routes.find("/index/with/a/long/enough/path")->second == 1);
+    assert(routes.find(view.substr(0, 6)) == routes.end());
+    assert(routes.at(view) == 2);
+    assert(routes[view] == 2);
+    assert(routes.equal_range(view).first->second == 2);
+    assert(allocations == before);
+    std::cout << "transparent lookups allocated: " << allocations - before << std::endl;
+    routes[std::string_view("/logout/with/a/long/enough/path")] = 3;
+    assert(routes.size() == 3 && routes.at("/logout/with/a/long/enough/path") == 3);
+
+    // 一次遍历删除
+    stl::unordered_map<int, int> squares;
+    for (int i = 0; i < 1000; ++i)
+    {
+        squares[i] = i * i;
+    }
+    assert(stl::erase_if(squares, [](const stl::pair<const int, int> & p) { return p.first % 4 != 0; }) == 750);
+    assert(squares.size() == 250 && squares.count(8) == 1 && squares.count(9) == 0);
+
+    stl::unordered_set<std::string, stl::string_hash, stl::equal_to<>> names;
+    assert(names.count("missing") == 0 && names.find(view) == names.end());
+
+    stl::unordered_multimap<std::string, int, stl::string_hash, stl::equal_to<>> multi;
+    assert(multi.count(view) == 0);
+
+    std::cout << "All tests passed!" << std::endl;
+}
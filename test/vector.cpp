@@ -2,6 +2,424 @@
 #include <iostream>
 
 #include "../src/vector.h"
+#include <memory>
+#include <string>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <list>
+#include <cstring>
+
+/**
+ * @brief 移动构造可能抛出异常的类型，扩容时应当拷贝
+ */
+class throwing_move
+{
+public:
+    int value;
+    static int copies;
+
+    throwing_move(int v) : value(v) {}
+    throwing_move(const throwing_move & other) : value(other.value) { ++copies; }
+    throwing_move(throwing_move && other) noexcept(false) : value(other.value) {}
+};
+
+int throwing_move::copies = 0;
+
+void test_relocation() {
+    static_assert(stl::is_trivially_relocatable<int>::value, "int");
+    static_assert(stl::is_trivially_relocatable<std::unique_ptr<int>>::value, "unique_ptr");
+    static_assert(stl::is_trivially_relocatable<stl::vector<std::string>>::value, "vector");
+    static_assert(!stl::is_trivially_relocatable<std::string>::value, "string");
+
+    // 可平凡重定位的元素用realloc扩容
+    stl::vector<std::unique_ptr<int>, stl::malloc_allocator<std::unique_ptr<int>>> ptrs;
+    for (int i = 0; i < 1000; ++i) {
+        ptrs.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    assert(ptrs.size() == 1000 && *ptrs[999] == 999 && *ptrs[0] == 0);
+    ptrs.shrink_to_fit();
+    assert(ptrs.capacity() >= 1000 && ptrs.capacity() < 2000 && *ptrs[500] == 500);
+
+    stl::vector<stl::vector<int>> nested;
+    for (int i = 0; i < 100; ++i) {
+        nested.push_back(stl::vector<int>());
+        nested.back().push_back(i);
+    }
+    assert(nested[99][0] == 99 && nested[0][0] == 0);
+
+    // 不可平凡重定位的元素逐个移动
+    stl::vector<std::string> strings;
+    for (int i = 0; i < 1000; ++i) {
+        strings.push_back(std::string(40, 'a') + std::to_string(i));
+    }
+    assert(strings[999] == std::string(40, 'a') + "999");
+
+    stl::vector<throwing_move> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(throwing_move(i));
+    }
+    assert(values[99].value == 99 && throwing_move::copies > 100);
+    std::cout << "Relocation passed." << std::endl;
+}
+
+/**
+ * @brief 与std::vector对照检查内容
+ */
+template <class T>
+bool same(const stl::vector<T> & lhs, const std::vector<T> & rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Make>
+void check_insert_erase(Make make) {
+    stl::vector<T> vec;
+    std::vector<T> ref;
+    for (int i = 0; i < 20; ++i) {
+        vec.push_back(make(i));
+        ref.push_back(make(i));
+    }
+
+    // 插入位置在扩容前后都有效
+    auto it = vec.insert(vec.begin() + 3, make(100));
+    ref.insert(ref.begin() + 3, make(100));
+    assert(*it == make(100) && same(vec, ref));
+    vec.shrink_to_fit();
+    it = vec.insert(vec.begin(), make(101));
+    ref.insert(ref.begin(), make(101));
+    assert(it == vec.begin() && same(vec, ref));
+
+    it = vec.insert(vec.begin() + 5, 7, make(102));
+    ref.insert(ref.begin() + 5, 7, make(102));
+    assert(it == vec.begin() + 5 && same(vec, ref));
+    vec.insert(vec.end(), 3, make(103));
+    ref.insert(ref.end(), 3, make(103));
+    assert(same(vec, ref));
+
+    // 插入本vector中的元素
+    vec.reserve(vec.size() + 100);
+    vec.insert(vec.begin(), vec[4]);
+    ref.insert(ref.begin(), ref[4]);
+    vec.insert(vec.begin() + 1, 3, vec.back());
+    ref.insert(ref.begin() + 1, 3, ref.back());
+    vec.emplace(vec.begin(), vec[10]);
+    ref.emplace(ref.begin(), ref[10]);
+    assert(same(vec, ref));
+    vec.shrink_to_fit();
+    vec.push_back(vec[0]);
+    ref.push_back(ref[0]);
+    assert(same(vec, ref));
+
+    // 范围插入
+    std::list<T> source;
+    for (int i = 200; i < 230; ++i) {
+        source.push_back(make(i));
+    }
+    it = vec.insert(vec.begin() + 2, source.begin(), source.end());
+    ref.insert(ref.begin() + 2, source.begin(), source.end());
+    assert(it == vec.begin() + 2 && same(vec, ref));
+    vec.insert(vec.begin() + 1, {make(300), make(301)});
+    ref.insert(ref.begin() + 1, {make(300), make(301)});
+    assert(same(vec, ref));
+
+    // 删除
+    it = vec.erase(vec.begin());
+    ref.erase(ref.begin());
+    assert(it == vec.begin() && same(vec, ref));
+    it = vec.erase(vec.begin() + 3, vec.begin() + 13);
+    ref.erase(ref.begin() + 3, ref.begin() + 13);
+    assert(it == vec.begin() + 3 && same(vec, ref));
+    vec.erase(vec.end() - 1);
+    ref.erase(ref.end() - 1);
+    vec.erase(vec.begin(), vec.end());
+    ref.erase(ref.begin(), ref.end());
+    assert(vec.empty() && same(vec, ref));
+}
+
+/**
+ * @brief 拷贝可能抛出异常、移动不是noexcept的类型
+ */
+class throwing_copy
+{
+public:
+    std::string value;
+    static int countdown;
+
+    throwing_copy(int v) : value(std::string(20, 'v') + std::to_string(v)) {}
+    throwing_copy(const throwing_copy & other) : value(other.value)
+    {
+        if (countdown > 0 && --countdown == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    throwing_copy(throwing_copy && other) noexcept(false) : value(std::move(other.value)) {}
+    throwing_copy & operator=(const throwing_copy &) = default;
+    throwing_copy & operator=(throwing_copy &&) = default;
+};
+
+int throwing_copy::countdown = 0;
+
+/**
+ * @brief 扩容的插入在搬移元素时抛出异常，vector保持不变
+ */
+void check_insert_rollback() {
+    for (int fail_at = 1; fail_at <= 10; ++fail_at) {
+        stl::vector<throwing_copy> vec;
+        for (int i = 0; i < 8; ++i) {
+            vec.push_back(throwing_copy(i));
+        }
+        vec.shrink_to_fit();
+        std::size_t capacity = vec.capacity();
+        // 先拷贝插入的2个元素，再拷贝头部4个和尾部4个
+        throwing_copy::countdown = fail_at;
+        bool thrown = false;
+        try {
+            vec.insert(vec.begin() + 4, 2, throwing_copy(100));
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        throwing_copy::countdown = 0;
+        assert(thrown && vec.size() == 8 && vec.capacity() == capacity);
+        for (int i = 0; i < 8; ++i) {
+            assert(vec[i].value == std::string(20, 'v') + std::to_string(i));
+        }
+        vec.insert(vec.begin() + 4, throwing_copy(100));
+        assert(vec.size() == 9 && vec[4].value == std::string(20, 'v') + "100");
+    }
+}
+
+void test_insert_erase() {
+    check_insert_erase<int>([](int i) { return i; });
+    check_insert_erase<std::string>([](int i) { return std::string(30, 'x') + std::to_string(i); });
+
+    // 输入迭代器
+    stl::vector<int> vec;
+    vec.insert(vec.end(), {1, 2, 6});
+    std::istringstream input("3 4 5");
+    vec.insert(vec.begin() + 2, std::istream_iterator<int>(input), std::istream_iterator<int>());
+    for (int i = 0; i < 6; ++i) {
+        assert(vec[i] == i + 1);
+    }
+
+    // 整数参数选择插入n个元素的重载
+    vec.insert(vec.begin(), 3, 0);
+    assert(vec.size() == 9 && vec[2] == 0 && vec[3] == 1);
+
+    // 只能移动的类型
+    stl::vector<std::unique_ptr<int>> ptrs;
+    for (int i = 0; i < 10; ++i) {
+        ptrs.insert(ptrs.begin(), std::unique_ptr<int>(new int(i)));
+    }
+    ptrs.erase(ptrs.begin() + 2, ptrs.begin() + 4);
+    assert(ptrs.size() == 8 && *ptrs[0] == 9 && *ptrs[2] == 5);
+
+    check_insert_rollback();
+    std::cout << "Insert and erase passed." << std::endl;
+}
+
+/**
+ * @brief 每次只增加一个元素的增长策略
+ */
+class linear_growth
+{
+public:
+    std::size_t operator()(std::size_t capacity, std::size_t) const
+    {
+        return capacity + 1;
+    }
+};
+
+void test_growth_policy() {
+    // 1.5倍增长
+    stl::vector<int, stl::allocator<int>, stl::one_and_half_growth_policy> half;
+    std::vector<std::size_t> capacities;
+    for (int i = 0; i < 100; ++i) {
+        half.push_back(i);
+        if (capacities.empty() || capacities.back() != half.capacity()) {
+            capacities.push_back(half.capacity());
+        }
+    }
+    std::vector<std::size_t> expected = {1, 2, 3, 4, 6, 9, 13, 19, 28, 42, 63, 94, 141};
+    assert(capacities == expected);
+
+    // 自定义策略
+    stl::vector<int, stl::allocator<int>, linear_growth> linear;
+    for (int i = 0; i < 10; ++i) {
+        linear.push_back(i);
+        assert(linear.capacity() == linear.size());
+    }
+    // 策略给出的容量不够时使用所需容量
+    linear.insert(linear.begin(), 5, -1);
+    assert(linear.capacity() == 15 && linear[4] == -1 && linear[5] == 0);
+
+    // 分配器给出的实际大小作为容量
+    stl::malloc_allocator<int> alloc;
+    auto allocation = alloc.allocate_at_least(5);
+    assert(allocation.ptr != nullptr && allocation.count >= 5);
+    alloc.deallocate(allocation.ptr, allocation.count);
+
+    stl::vector<int, stl::malloc_allocator<int>> usable;
+    usable.reserve(5);
+    assert(usable.capacity() >= 5);
+    for (int i = 0; i < 1000; ++i) {
+        usable.push_back(i);
+    }
+    assert(usable.size() == 1000 && usable[999] == 999 && usable.capacity() >= 1000);
+    usable.insert(usable.begin(), 100, 7);
+    assert(usable.size() == 1100 && usable[100] == 0);
+    std::cout << "Growth policy passed." << std::endl;
+}
+
+void test_default_init() {
+    stl::vector<unsigned char> buffer;
+    buffer.resize_default_init(1000);
+    assert(buffer.size() == 1000 && buffer.capacity() >= 1000);
+    std::memset(buffer.data(), 7, buffer.size());
+    buffer.resize_for_overwrite(10);
+    assert(buffer.size() == 10 && buffer[9] == 7);
+
+    // 先申请空间，写入一部分后提交
+    unsigned char * dest = buffer.append_uninitialized(100);
+    assert(buffer.size() == 10 && buffer.capacity() >= 110);
+    std::memset(dest, 9, 60);
+    buffer.commit_append(60);
+    assert(buffer.size() == 70 && buffer[9] == 7 && buffer[10] == 9 && buffer[69] == 9);
+
+    // 非平凡类型默认构造
+    stl::vector<std::string> strings;
+    strings.push_back("a");
+    strings.resize_default_init(5);
+    assert(strings.size() == 5 && strings[0] == "a" && strings[4].empty());
+    std::string * slot = strings.append_uninitialized(1);
+    new (slot) std::string("b");
+    strings.commit_append(1);
+    assert(strings.size() == 6 && strings.back() == "b");
+    std::cout << "Default init passed." << std::endl;
+}
+
+void test_bulk_append() {
+    stl::vector<int> vec;
+    std::list<int> source = {1, 2, 3};
+    vec.append_range(source.begin(), source.end());
+    int array[] = {4, 5};
+    vec.append_range(array, array + 2);
+    std::istringstream input("6 7");
+    vec.append_range(std::istream_iterator<int>(input), std::istream_iterator<int>());
+    int next = 8;
+    vec.append(3, [&]() { return next++; });
+    assert(vec.size() == 10);
+    for (int i = 0; i < 10; ++i) {
+        assert(vec[i] == i + 1);
+    }
+
+    // 预留之后不检查容量
+    std::vector<int> more(1000, 42);
+    std::copy(more.begin(), more.end(), stl::unchecked_back_inserter(vec, more.size()));
+    assert(vec.size() == 1010 && vec.back() == 42 && vec.capacity() >= 1010);
+
+    // 生成器抛出异常时保留已追加的元素
+    stl::vector<std::string> strings;
+    int count = 0;
+    try {
+        strings.append(10, [&]() {
+            if (count == 5) throw std::runtime_error("generator");
+            return std::to_string(count++);
+        });
+    } catch (const std::runtime_error &) {
+    }
+    assert(strings.size() == 5 && strings[4] == "4");
+    std::cout << "Bulk append passed." << std::endl;
+}
+
+void test_erase_if() {
+    stl::vector<int> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+    assert(stl::erase_if(vec, [](int x) { return x % 3 == 0; }) == 34);
+    assert(vec.size() == 66 && vec.front() == 1 && vec[1] == 2 && vec[2] == 4 && vec.back() == 98);
+    vec.push_back(7);
+    assert(stl::erase(vec, 7) == 2 && stl::erase(vec, 1000) == 0 && vec.size() == 65);
+
+    // 不保持顺序的删除只移动尾部元素
+    stl::vector<std::string> strings;
+    for (int i = 0; i < 5; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    auto it = strings.unordered_erase(strings.begin() + 1);
+    assert(*it == "4" && strings.size() == 4 && strings[3] == "3");
+    it = strings.unordered_erase(strings.end() - 1);
+    assert(it == strings.end() && strings.size() == 3 && strings.back() == "2");
+    std::cout << "Erase if passed." << std::endl;
+}
+
+void test_vector_bool() {
+    stl::vector<bool> flags;
+    for (int i = 0; i < 1000; ++i) {
+        flags.push_back(i % 3 == 0);
+    }
+    // 按位存储，1000位只需要16个字
+    assert(flags.size() == 1000 && flags.capacity() >= 1000 && flags.capacity() <= 2048);
+    assert(flags.count() == 334 && flags[0] && !flags[1] && flags[999]);
+    flags[1] = true;
+    flags[0].flip();
+    assert(flags[1] && !flags[0] && flags.count() == 334);
+
+    stl::vector<bool> copy(flags);
+    assert(copy == flags);
+    copy.flip();
+    assert(copy.count() == 666 && copy != flags);
+
+    // 迭代器
+    std::size_t ones = 0;
+    for (bool b : flags) {
+        ones += b;
+    }
+    assert(ones == 334 && std::count(flags.cbegin(), flags.cend(), true) == 334);
+    assert(flags.end() - flags.begin() == 1000 && *(flags.begin() + 999) && *(flags.end() - 1));
+
+    flags.insert(flags.begin() + 10, 70, true);
+    assert(flags.size() == 1070 && flags[9] && flags[10] && flags[79] && !flags[80] && flags[82]);
+    flags.erase(flags.begin() + 10, flags.begin() + 80);
+    assert(flags.size() == 1000 && flags.count() == 334);
+    assert(stl::erase(flags, true) == 334 && flags.size() == 666 && flags.count() == 0);
+
+    flags.resize(2000, true);
+    assert(flags.size() == 2000 && flags.count() == 1334);
+    flags.resize(10);
+    assert(flags.count() == 0 && flags.size() == 10);
+    flags.pop_back();
+    flags.shrink_to_fit();
+    assert(flags.size() == 9 && flags.capacity() == 64);
+
+    assert(flags.max_size() % 64 == 0 && flags.max_size() / 64 <= stl::allocator<std::uint64_t>().max_size());
+    assert(flags.max_size() > std::numeric_limits<std::size_t>::max() / 2);
+
+    stl::vector<bool> sized(130, true);
+    assert(sized.count() == 130 && sized.back());
+    std::cout << "vector<bool> passed." << std::endl;
+}
+
+void test_aligned_storage() {
+    stl::vector<float, stl::aligned_allocator<float, 64>> vec;
+    static_assert(decltype(vec)::data_alignment == 64, "vector alignment");
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(static_cast<float>(i));
+        // 每次扩容后的新数组都对齐
+        assert(reinterpret_cast<std::uintptr_t>(vec.data()) % 64 == 0);
+    }
+    const float * data = vec.aligned_data();
+    float sum = 0;
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        sum += data[i];
+    }
+    assert(sum == 499500.0f && data == vec.data());
+    vec.shrink_to_fit();
+    assert(reinterpret_cast<std::uintptr_t>(vec.data()) % 64 == 0);
+    static_assert(stl::vector<float>::data_alignment == alignof(float), "default alignment");
+    std::cout << "Aligned storage passed." << std::endl;
+}
 
 int main() {
     stl::vector<int> vec;
@@ -52,5 +470,14 @@ int main() {
     vec.shrink_to_fit();
     std::cout << "vector capacity after shrink2fit: " << vec.capacity() << std::endl;
 
+    test_relocation();
+    test_insert_erase();
+    test_growth_policy();
+    test_default_init();
+    test_bulk_append();
+    test_erase_if();
+    test_vector_bool();
+    test_aligned_storage();
+
     return 0;
 }
\ No newline at end of file